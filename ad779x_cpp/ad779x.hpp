@@ -0,0 +1,622 @@
+/**
+  ******************************************************************************
+  * @file    ad779x.hpp
+  * @author  Khusainov Timur
+  * @version 0.0.0.1
+  * @date    16.10.2026
+  * @brief   AD7792/AD7793 driver template (C++11, header only)
+  ******************************************************************************
+  * @attention
+  * <h2><center>&copy; COPYRIGHT 2011 timypik@gmail.com </center></h2>
+  ******************************************************************************
+  *
+  * Bus policy (type Bus) must have methods:
+  *   void Select(bool Active)                                              - cs line
+  *   void Transfer(const uint8_t *pTx, uint8_t *pRx, uint8_t Size, uint8_t TxSize)
+  *                                             - frame: TxSize bytes written, other read
+  *   bool Ready()                                          - DOUT/RDY line is low
+  * Methods are called directly (no function pointers) and inlined. Bus with no data
+  * (e.g. fixed pins) takes no memory: it is empty base of driver. Devices on one bus
+  * differ by data of Bus (e.g. cs pin number), see ad779x_shim.cpp for bus on callbacks
+  * and ad779x_size.cpp for bus on pins.
+  *
+  * Registers and types are shared with C drivers: include path selects ad779x.h
+  * of single or multiple variant.
+  */
+
+#ifndef AD779X_HPP
+#define AD779X_HPP
+
+extern "C" {
+#include "ad779x.h"
+}
+
+template <class Bus, tAD779X_Model FixedModel = adNone>
+class AD779x : private Bus
+{
+public:
+	tAD779X_Model Model;               /*!< detected model (FixedModel, if it is set) */
+	tAD779X_StartUpState SuState;
+	tAD779X_ModeRegister ModeReg;      /*!< last written values of registers */
+	tAD779X_ConfigRegister ConfigReg;
+	tAD779X_IORegister IOReg;
+	
+	/**
+	 * @brief  Make driver: registers in reset state, Init() must be called
+	 * @param  bus - bus policy
+	 */
+	explicit AD779x(const Bus &bus = Bus()) : Bus(bus), Model(FixedModel), SuState(susNone)
+	{
+		ModeReg.DATA   = AD779X_RDV_MODE;
+		ConfigReg.DATA = AD779X_RDV_CONFIG;
+		IOReg.DATA     = AD779X_RDV_IO;
+	}
+	
+	/**
+	 * @brief  Get model: constant, if FixedModel is set
+	 * @param  None
+	 * @return Model
+	 */
+	tAD779X_Model GetModel() const
+	{
+		return (FixedModel != adNone) ? FixedModel : Model;
+	}
+	
+	/**
+	 * @brief  Detect ADC and set default settings
+	 * @param  None
+	 * @return None
+	 */
+	void Init()
+	{
+		tAD779X_ModeRegister m_mode_reg;
+		tAD779X_ConfigRegister m_config_reg;
+		tAD779X_IORegister m_io_reg;
+		
+		if (HWDetect())
+		{
+			/* set default settings: Idle, internal clock source, 16.7Hz (65dB) */
+			m_mode_reg.DATA = 0;
+			m_mode_reg.MODE = mdsIdle;
+			m_mode_reg.CLKS = cssInt;
+			m_mode_reg.FS   = fs16_7_65dB;
+			WriteModeRegister(m_mode_reg.DATA);
+			
+			/* set default settings: AIN1, gain 128, bipolar, external reference, buffered */
+			m_config_reg.DATA   = 0;
+			m_config_reg.VBIAS  = biasNone;
+			m_config_reg.BO     = boDisable;
+			m_config_reg.UB     = ubBipolar;
+			m_config_reg.BOOST  = boostDisable;
+			m_config_reg.GAIN   = gain128;
+			m_config_reg.REFSEL = refExt;
+			m_config_reg.BUF    = bufEnable;
+			m_config_reg.CHSEL  = chsAIN1;
+			WriteConfigRegister(m_config_reg.DATA);
+			
+			/* set default settings: excitation currents disabled */
+			m_io_reg.DATA    = 0;
+			m_io_reg.IEXCEN  = csvDisable;
+			m_io_reg.IEXCDIR = csdNormal;
+			WriteIORegister(m_io_reg.DATA);
+			
+			SuState = susActivate;
+		}
+		else
+			SuState = susNoHW;
+	}
+	
+	/**
+	 * @brief  Reset ADC: 32 clk with DIN = 1
+	 * @param  None
+	 * @return None
+	 */
+	void Reset()
+	{
+		const uint8_t m_tx[4] = {0xFF, 0xFF, 0xFF, 0xFF};
+		uint8_t m_rx[4];
+		
+		Exchange(m_tx, m_rx, 4, 4);
+		
+		/* registers return to reset values */
+		ModeReg.DATA   = AD779X_RDV_MODE;
+		ConfigReg.DATA = AD779X_RDV_CONFIG;
+		IOReg.DATA     = AD779X_RDV_IO;
+	}
+	
+	/**
+	 * @brief  Detect model by ID register
+	 * @param  None
+	 * @return Model or adNone
+	 */
+	unsigned short HWDetect()
+	{
+		const uint8_t m_tx[2] = {AD779X_RDR_ID, 0};
+		uint8_t m_rx[2];
+		
+		Exchange(m_tx, m_rx, 2, 1);
+		
+		switch (m_rx[1] & 0xF)
+		{
+			case AD7792_PARTID: Model = ad7792; break;
+			case AD7793_PARTID: Model = ad7793; break;
+			default:            Model = adNone; break;
+		}
+		
+		/* other model is not supported by this instance */
+		if ((FixedModel != adNone) && (Model != FixedModel))
+			Model = adNone;
+		
+		return Model;
+	}
+	
+	/**
+	 * @brief  Write MODE register
+	 * @param  Data - need write
+	 * @return None
+	 */
+	void WriteModeRegister(unsigned short Data)
+	{
+		WriteRegister(AD779X_WRR_MODE, Data, 2);
+		
+		ModeReg.DATA = Data;
+		
+		/* one-shot modes return ADC to Power-down/Idle mode by itself */
+		if (AD779X_MODE_IS_ONESHOT(ModeReg.MODE))
+			ModeReg.MODE = AD779X_MODE_AFTER_ONESHOT(ModeReg.MODE);
+	}
+	
+	/**
+	 * @brief  Write CONFIG register
+	 * @param  Data - need write
+	 * @return None
+	 */
+	void WriteConfigRegister(unsigned short Data)
+	{
+		WriteRegister(AD779X_WRR_CONFIG, Data, 2);
+		ConfigReg.DATA = Data;
+	}
+	
+	/**
+	 * @brief  Write IO register
+	 * @param  Data - need write
+	 * @return None
+	 */
+	void WriteIORegister(unsigned char Data)
+	{
+		WriteRegister(AD779X_WRR_IO, Data, 1);
+		IOReg.DATA = Data;
+	}
+	
+	/**
+	 * @brief  Read STATUS register
+	 * @param  None
+	 * @return STATUS register value
+	 */
+	unsigned char GetStatus()
+	{
+		return (unsigned char)ReadRegister(AD779X_RDR_STATUS, 1);
+	}
+	
+	/**
+	 * @brief  Check ready by STATUS register
+	 * @param  None
+	 * @return Not 0 - data ready
+	 */
+	unsigned char CheckReadySW()
+	{
+		return (~GetStatus() & AD779X_SR_RDY);
+	}
+	
+	/**
+	 * @brief  Check ready by DOUT/RDY line
+	 * @param  None
+	 * @return 1 - data ready
+	 */
+	unsigned char CheckReadyHW()
+	{
+		unsigned char m_rdy_state;
+		
+		Bus::Select(true);
+		m_rdy_state = Bus::Ready() ? 1 : 0;
+		Bus::Select(false);
+		
+		return m_rdy_state;
+	}
+	
+	/**
+	 * @brief  Set ADC mode
+	 * @param  Mode - need mode
+	 * @return None
+	 */
+	void SetMode(tAD779X_ModeSelect Mode)
+	{
+		tAD779X_ModeRegister m_mode_reg = ModeReg;
+		
+		m_mode_reg.MODE = Mode;
+		UpdateModeRegister(m_mode_reg.DATA);
+	}
+	
+	/**
+	 * @brief  Set ADC clock source
+	 * @param  ClkSource - need clock source
+	 * @return None
+	 */
+	void SetClkSource(tAD779X_ClkSourceSelect ClkSource)
+	{
+		tAD779X_ModeRegister m_mode_reg = ModeReg;
+		
+		m_mode_reg.CLKS = ClkSource;
+		UpdateModeRegister(m_mode_reg.DATA);
+	}
+	
+	/**
+	 * @brief  Set ADC update rate
+	 * @param  UpdateRate - need update rate
+	 * @return None
+	 */
+	void SetUpdateRate(tAD779X_FilterSelect UpdateRate)
+	{
+		tAD779X_ModeRegister m_mode_reg = ModeReg;
+		
+		m_mode_reg.FS = UpdateRate;
+		UpdateModeRegister(m_mode_reg.DATA);
+	}
+	
+	/**
+	 * @brief  Set ADC channel
+	 * @param  Channel - need channel
+	 * @return None
+	 */
+	void SetChannel(tAD779X_ChSelect Channel)
+	{
+		tAD779X_ConfigRegister m_config_reg = ConfigReg;
+		
+		m_config_reg.CHSEL = Channel;
+		UpdateConfigRegister(m_config_reg.DATA);
+	}
+	
+	/**
+	 * @brief  Set ADC gain
+	 * @param  Gain - need gain
+	 * @return None
+	 */
+	void SetGain(tAD779X_GainSelect Gain)
+	{
+		tAD779X_ConfigRegister m_config_reg = ConfigReg;
+		
+		m_config_reg.GAIN = Gain;
+		UpdateConfigRegister(m_config_reg.DATA);
+	}
+	
+	/**
+	 * @brief  Set ADC unipolar/bipolar coding
+	 * @param  Polarity - need coding
+	 * @return None
+	 */
+	void SetPolarity(tAD779X_BSelect Polarity)
+	{
+		tAD779X_ConfigRegister m_config_reg = ConfigReg;
+		
+		m_config_reg.UB = Polarity;
+		UpdateConfigRegister(m_config_reg.DATA);
+	}
+	
+	/**
+	 * @brief  Set ADC buffered/unbuffered mode
+	 * @param  Buffer - need mode
+	 * @return None
+	 */
+	void SetBuffer(tAD779X_BufSelect Buffer)
+	{
+		tAD779X_ConfigRegister m_config_reg = ConfigReg;
+		
+		m_config_reg.BUF = Buffer;
+		UpdateConfigRegister(m_config_reg.DATA);
+	}
+	
+	/**
+	 * @brief  Set ADC reference source
+	 * @param  Reference - need reference
+	 * @return None
+	 */
+	void SetReference(tAD779X_RefSelect Reference)
+	{
+		tAD779X_ConfigRegister m_config_reg = ConfigReg;
+		
+		m_config_reg.REFSEL = Reference;
+		UpdateConfigRegister(m_config_reg.DATA);
+	}
+	
+	/**
+	 * @brief  Set ADC bias voltage generator
+	 * @param  Bias - need bias
+	 * @return None
+	 */
+	void SetBias(tAD779X_VbiasSelect Bias)
+	{
+		tAD779X_ConfigRegister m_config_reg = ConfigReg;
+		
+		m_config_reg.VBIAS = Bias;
+		UpdateConfigRegister(m_config_reg.DATA);
+	}
+	
+	/**
+	 * @brief  Set ADC excitation currents value
+	 * @param  excValue - need value
+	 * @return None
+	 */
+	void SetExCurrentValue(tAD779X_IEXCENSelect excValue)
+	{
+		tAD779X_IORegister m_io_reg = IOReg;
+		
+		m_io_reg.IEXCEN = excValue;
+		UpdateIORegister(m_io_reg.DATA);
+	}
+	
+	/**
+	 * @brief  Set ADC excitation currents direction
+	 * @param  excDirection - need direction
+	 * @return None
+	 */
+	void SetExCurrentDirection(tAD779X_IEXCDIRSelect excDirection)
+	{
+		tAD779X_IORegister m_io_reg = IOReg;
+		
+		m_io_reg.IEXCDIR = excDirection;
+		UpdateIORegister(m_io_reg.DATA);
+	}
+	
+	/**
+	 * @brief  Set ADC excitation currents value and direction (one IO write)
+	 * @param  excValue - need value
+	 * @param  excDirection - need direction
+	 * @return None
+	 */
+	void SetExCurrent(tAD779X_IEXCENSelect excValue, tAD779X_IEXCDIRSelect excDirection)
+	{
+		tAD779X_IORegister m_io_reg = IOReg;
+		
+		m_io_reg.IEXCEN  = excValue;
+		m_io_reg.IEXCDIR = excDirection;
+		UpdateIORegister(m_io_reg.DATA);
+	}
+	
+	/**
+	 * @brief  Start ADC Zero-Scale Calibration
+	 * @param  None
+	 * @return None
+	 */
+	void StartZSCalibration()
+	{
+		SetMode(mdsIntZeroCal);
+	}
+	
+	/**
+	 * @brief  Start ADC Full-Scale Calibration
+	 * @param  None
+	 * @return None
+	 */
+	void StartFSCalibration()
+	{
+		SetMode(mdsIntFullCal);
+	}
+	
+	/**
+	 * @brief  Read data from ADC (16-bit)
+	 * @param  None
+	 * @return Register value
+	 */
+	unsigned short ReadDataRegister16()
+	{
+		return (unsigned short)ReadRegister(AD779X_RDR_DATA, 2);
+	}
+	
+	/**
+	 * @brief  Read data from ADC (24-bit)
+	 * @param  None
+	 * @return Register value
+	 */
+	unsigned long ReadDataRegister24()
+	{
+		return ReadRegister(AD779X_RDR_DATA, 3);
+	}
+	
+	/**
+	 * @brief  Read offset register value (16-bit)
+	 * @param  None
+	 * @return Register value
+	 */
+	unsigned short ReadOffsetRegister16()
+	{
+		return (unsigned short)ReadRegister(AD779X_RDR_OFFSET, 2);
+	}
+	
+	/**
+	 * @brief  Read offset register value (24-bit)
+	 * @param  None
+	 * @return Register value
+	 */
+	unsigned long ReadOffsetRegister24()
+	{
+		return ReadRegister(AD779X_RDR_OFFSET, 3);
+	}
+	
+	/**
+	 * @brief  Read full-scale register value (16-bit)
+	 * @param  None
+	 * @return Register value
+	 */
+	unsigned short ReadFScaleRegister16()
+	{
+		return (unsigned short)ReadRegister(AD779X_RDR_FSCLAE, 2);
+	}
+	
+	/**
+	 * @brief  Read full-scale register value (24-bit)
+	 * @param  None
+	 * @return Register value
+	 */
+	unsigned long ReadFScaleRegister24()
+	{
+		return ReadRegister(AD779X_RDR_FSCLAE, 3);
+	}
+	
+	/**
+	 * @brief  Write offset register value (16-bit), register of selected channel
+	 * @param  Data - need write
+	 * @return None
+	 */
+	void WriteOffsetRegister16(unsigned short Data)
+	{
+		WriteRegister(AD779X_WRR_OFFSET, Data, 2);
+	}
+	
+	/**
+	 * @brief  Write offset register value (24-bit), register of selected channel
+	 * @param  Data - need write
+	 * @return None
+	 */
+	void WriteOffsetRegister24(unsigned long Data)
+	{
+		WriteRegister(AD779X_WRR_OFFSET, Data, 3);
+	}
+	
+	/**
+	 * @brief  Write full-scale register value (16-bit), register of selected channel
+	 * @param  Data - need write
+	 * @return None
+	 */
+	void WriteFScaleRegister16(unsigned short Data)
+	{
+		WriteRegister(AD779X_WRR_FSCLAE, Data, 2);
+	}
+	
+	/**
+	 * @brief  Write full-scale register value (24-bit), register of selected channel
+	 * @param  Data - need write
+	 * @return None
+	 */
+	void WriteFScaleRegister24(unsigned long Data)
+	{
+		WriteRegister(AD779X_WRR_FSCLAE, Data, 3);
+	}
+	
+	/**
+	 * @brief  Read data sample in 24-bit range (AD7792 result is shifted by 8)
+	 * @param  None
+	 * @return Sample value
+	 */
+	unsigned long ReadDataSample24()
+	{
+		if (GetModel() == ad7793)
+			return ReadRegister(AD779X_RDR_DATA, 3);
+		
+		return ReadRegister(AD779X_RDR_DATA, 2) << 8;
+	}
+	
+	/**
+	 * @brief  Read data sample in 16-bit range (AD7793 result is shifted by 8)
+	 * @param  None
+	 * @return Sample value
+	 */
+	unsigned short ReadDataSample16()
+	{
+		return (unsigned short)(ReadDataSample24() >> 8);
+	}
+
+private:
+	/**
+	 * @brief  Exchange frame with ADC
+	 * @param  pTx - frame: command/data bytes, then dummy bytes for read
+	 * @param  pRx - received frame
+	 * @param  Size - size of frame
+	 * @param  TxSize - count of first bytes written to ADC
+	 * @return None
+	 */
+	void Exchange(const uint8_t *pTx, uint8_t *pRx, uint8_t Size, uint8_t TxSize)
+	{
+		Bus::Select(true);
+		Bus::Transfer(pTx, pRx, Size, TxSize);
+		Bus::Select(false);
+	}
+	
+	/**
+	 * @brief  Read register
+	 * @param  Cmd - read command
+	 * @param  Size - size of value, bytes (MSB first)
+	 * @return Register value
+	 */
+	unsigned long ReadRegister(uint8_t Cmd, uint8_t Size)
+	{
+		uint8_t m_tx[4] = {Cmd, 0, 0, 0};
+		uint8_t m_rx[4];
+		unsigned long m_value = 0;
+		uint8_t i;
+		
+		Exchange(m_tx, m_rx, Size + 1, 1);
+		
+		for (i = 1; i <= Size; i++)
+			m_value = (m_value << 8) | m_rx[i];
+		
+		return m_value;
+	}
+	
+	/**
+	 * @brief  Write register
+	 * @param  Cmd - write command
+	 * @param  Data - need write
+	 * @param  Size - size of value, bytes (MSB first)
+	 * @return None
+	 */
+	void WriteRegister(uint8_t Cmd, unsigned long Data, uint8_t Size)
+	{
+		uint8_t m_tx[4] = {Cmd, 0, 0, 0};
+		uint8_t m_rx[4];
+		uint8_t i;
+		
+		for (i = Size; i > 0; i--, Data >>= 8)
+			m_tx[i] = (uint8_t)(Data & 0xFF);
+		
+		Exchange(m_tx, m_rx, Size + 1, Size + 1);
+	}
+	
+	/**
+	 * @brief  Write MODE register, if value is changed (one-shot modes are always written)
+	 * @param  Data - need write
+	 * @return None
+	 */
+	void UpdateModeRegister(unsigned short Data)
+	{
+		tAD779X_ModeRegister m_mode_reg;
+		
+		m_mode_reg.DATA = Data;
+		
+		if ((Data != ModeReg.DATA) || AD779X_MODE_IS_ONESHOT(m_mode_reg.MODE))
+			WriteModeRegister(Data);
+	}
+	
+	/**
+	 * @brief  Write CONFIG register, if value is changed
+	 * @param  Data - need write
+	 * @return None
+	 */
+	void UpdateConfigRegister(unsigned short Data)
+	{
+		if (Data != ConfigReg.DATA)
+			WriteConfigRegister(Data);
+	}
+	
+	/**
+	 * @brief  Write IO register, if value is changed
+	 * @param  Data - need write
+	 * @return None
+	 */
+	void UpdateIORegister(unsigned char Data)
+	{
+		if (Data != IOReg.DATA)
+			WriteIORegister(Data);
+	}
+};
+
+#endif
@@ -0,0 +1,241 @@
+/**
+  ******************************************************************************
+  * @file    ad779x_shim.cpp
+  * @author  Khusainov Timur
+  * @version 0.0.0.1
+  * @date    16.10.2026
+  * @brief   AD7792/AD7793: core functions of C driver over C++ template
+  ******************************************************************************
+  * @attention
+  * <h2><center>&copy; COPYRIGHT 2011 timypik@gmail.com </center></h2>
+  ******************************************************************************
+  *
+  * Replaces core functions of ad779x.c of single or multiple variant: init,
+  * detect, register access, Set*, calibration start, offset/full-scale and data
+  * reads. Build ad779x.c and this file with -DAD779X_CORE_SHIM and link both,
+  * e.g.:
+  *   cc -O2 -DAD779X_CORE_SHIM -I../ad779x_multiple -c ../ad779x_multiple/ad779x.c
+  *   c++ -O2 -DAD779X_CORE_SHIM -I../ad779x_multiple -c ad779x_shim.cpp
+  * Ring, sequencer, transactions, continuous read and other functions stay in
+  * ad779x.c. State of device is same as with C core: register images (with
+  * OFFSET/FULL-SCALE images of single variant), deadline and read mode are kept
+  * by AD779X_ShimWindow after each cs window, telemetry counters and trace hooks
+  * (AD779X_TRACE) are same.
+  *
+  * Check of same results: ad779x_shim_test.c, check of size: ad779x_size.cpp.
+  */
+
+#if !defined(AD779X_CORE_SHIM)
+#error "build with -DAD779X_CORE_SHIM (ad779x.c too)"
+#endif
+
+#include "ad779x.hpp"
+
+#if defined(AD779X_VARIANT_SINGLE)
+/* C API: no device parameter, global ADCDevice */
+#define AD779X_SHIM_P0
+#define AD779X_SHIM_P
+#define AD779X_SHIM_DEVICE (&ADCDevice)
+#define AD779X_SHIM_WINDOW(pDevice, pTx, Size) AD779X_ShimWindow(pTx, Size)
+#else
+#define AD779X_SHIM_P0 tAD779X_Device *pDevice
+#define AD779X_SHIM_P  tAD779X_Device *pDevice,
+#define AD779X_SHIM_DEVICE pDevice
+#define AD779X_SHIM_WINDOW(pDevice, pTx, Size) AD779X_ShimWindow(pDevice, pTx, Size)
+#endif
+
+#if defined(AD779X_FIXED_MODEL)
+#define AD779X_SHIM_MODEL AD779X_FIXED_MODEL
+#else
+#define AD779X_SHIM_MODEL adNone
+#endif
+
+/**
+ * @brief Bus policy over callbacks of tAD779X_Device (dispatch per device, as C driver).
+ *        Template makes one Transfer or one Ready in each cs window, so whole
+ *        window (cs line, trace hooks, state of device) is made by them.
+ */
+class tAD779X_CallbackBus
+{
+public:
+	explicit tAD779X_CallbackBus(tAD779X_Device *pDevice = 0) : pDevice(pDevice) {}
+	
+	void Select(bool Active)
+	{
+		/* cs line is driven by Transfer/Ready */
+		(void)Active;
+	}
+	
+	void Transfer(const uint8_t *pTx, uint8_t *pRx, uint8_t Size, uint8_t TxSize)
+	{
+		uint8_t i;
+		
+		AD779X_TRACE_BEGIN(AD779X_TRACE_OP(pTx[0]), pDevice);
+		
+		pDevice->CSControl(cssEnable);
+		
+		if (pDevice->TxRxBlock)
+		{
+			pDevice->TxRxBlock(pTx, pRx, Size);
+		}
+		else
+		{
+			for (i = 0; i < TxSize; i++)
+				pDevice->TxByte(pTx[i]);
+			
+			for (; i < Size; i++)
+				pRx[i] = pDevice->RxByte();
+		}
+		
+		pDevice->CSControl(cssDisable);
+		
+		AD779X_TRACE_END(AD779X_TRACE_OP(pTx[0]), pDevice);
+		
+		AD779X_SHIM_WINDOW(pDevice, pTx, Size);
+	}
+	
+	bool Ready()
+	{
+		bool m_ready;
+		
+		AD779X_TRACE_BEGIN(trcPollReady, pDevice);
+		
+		pDevice->CSControl(cssEnable);
+		m_ready = (pDevice->RDYState() == rdsFree);
+		pDevice->CSControl(cssDisable);
+		
+		AD779X_TRACE_END(trcPollReady, pDevice);
+		
+		return m_ready;
+	}
+
+private:
+	tAD779X_Device *pDevice;
+};
+
+typedef AD779x<tAD779X_CallbackBus, AD779X_SHIM_MODEL> tAD779X_CallbackDriver;
+
+/**
+ * @brief Template driver on state of tAD779X_Device: loaded on make, model and
+ *        startup state stored on destroy (register images are kept by AD779X_ShimWindow)
+ */
+class tAD779X_Shim : public tAD779X_CallbackDriver
+{
+public:
+	explicit tAD779X_Shim(tAD779X_Device *pDevice) : tAD779X_CallbackDriver(::tAD779X_CallbackBus(pDevice)), pDevice(pDevice)
+	{
+		Model     = pDevice->Model;
+		SuState   = pDevice->SuState;
+		ModeReg   = pDevice->ModeReg;
+		ConfigReg = pDevice->ConfigReg;
+		IOReg     = pDevice->IOReg;
+	}
+	
+	~tAD779X_Shim()
+	{
+		pDevice->Model   = Model;
+		pDevice->SuState = SuState;
+	}
+
+private:
+	tAD779X_Device *pDevice;
+};
+
+extern "C" {
+
+void AD779X_Init(AD779X_SHIM_P0)
+{
+	tAD779X_Shim m_shim(AD779X_SHIM_DEVICE);
+	
+	m_shim.Init();
+	
+	if (m_shim.SuState == susNoHW)
+		AD779X_COUNTER_INC(AD779X_SHIM_DEVICE->Telemetry.DetectFails);
+
+#if defined(AD779X_VARIANT_SINGLE)
+	/* images of calibration registers: reset values */
+	if (m_shim.GetModel() == ad7792)
+	{
+		ADCDevice.OfReg.u16 = AD779X_OFFSET_RESET_16;
+		ADCDevice.FsReg.u16 = AD779X_FULLSCALE_RESET_16;
+	}
+	else if (m_shim.GetModel() == ad7793)
+	{
+		ADCDevice.OfReg.u32 = AD779X_OFFSET_RESET_24;
+		ADCDevice.FsReg.u32 = AD779X_FULLSCALE_RESET_24;
+	}
+#endif
+}
+
+unsigned short AD779X_HWDetect(AD779X_SHIM_P0)
+{
+	unsigned short m_model = tAD779X_Shim(AD779X_SHIM_DEVICE).HWDetect();
+	
+	if (m_model == adNone)
+		AD779X_COUNTER_INC(AD779X_SHIM_DEVICE->Telemetry.DetectFails);
+	
+	return m_model;
+}
+
+uint16_t AD779X_ReadDataSample16(AD779X_SHIM_P0)
+{
+	uint16_t m_sample = tAD779X_Shim(AD779X_SHIM_DEVICE).ReadDataSample16();
+	
+	AD779X_COUNTER_INC(AD779X_SHIM_DEVICE->Telemetry.Conversions);
+	
+	return m_sample;
+}
+
+unsigned long AD779X_ReadDataSample24(AD779X_SHIM_P0)
+{
+	unsigned long m_sample = tAD779X_Shim(AD779X_SHIM_DEVICE).ReadDataSample24();
+	
+	AD779X_COUNTER_INC(AD779X_SHIM_DEVICE->Telemetry.Conversions);
+	
+	return m_sample;
+}
+
+#if !defined(AD779X_VARIANT_SINGLE)
+unsigned short AD779X_ReadDataSample(tAD779X_Device *pDevice)
+{
+	tAD779X_Shim m_shim(pDevice);
+	
+	/* unknown model: no read */
+	return (m_shim.GetModel() == adNone) ? 0 : m_shim.ReadDataSample16();
+}
+#else
+void AD779X_SetExCurrent(tAD779X_IEXCENSelect excValue, tAD779X_IEXCDIRSelect excDir) { tAD779X_Shim(AD779X_SHIM_DEVICE).SetExCurrent(excValue, excDir); }
+#endif
+
+void AD779X_Reset(AD779X_SHIM_P0)                                                   { tAD779X_Shim(AD779X_SHIM_DEVICE).Reset(); }
+void AD779X_WriteModeRegister(AD779X_SHIM_P unsigned short Data)                    { tAD779X_Shim(AD779X_SHIM_DEVICE).WriteModeRegister(Data); }
+void AD779X_WriteConfigRegister(AD779X_SHIM_P unsigned short Data)                  { tAD779X_Shim(AD779X_SHIM_DEVICE).WriteConfigRegister(Data); }
+void AD779X_WriteIORegister(AD779X_SHIM_P unsigned char Data)                       { tAD779X_Shim(AD779X_SHIM_DEVICE).WriteIORegister(Data); }
+unsigned char AD779X_GetStatus(AD779X_SHIM_P0)                                      { return tAD779X_Shim(AD779X_SHIM_DEVICE).GetStatus(); }
+unsigned char AD779X_CheckReadySW(AD779X_SHIM_P0)                                   { return tAD779X_Shim(AD779X_SHIM_DEVICE).CheckReadySW(); }
+unsigned char AD779X_CheckReadyHW(AD779X_SHIM_P0)                                   { return tAD779X_Shim(AD779X_SHIM_DEVICE).CheckReadyHW(); }
+void AD779X_SetMode(AD779X_SHIM_P tAD779X_ModeSelect Mode)                          { tAD779X_Shim(AD779X_SHIM_DEVICE).SetMode(Mode); }
+void AD779X_SetClkSource(AD779X_SHIM_P tAD779X_ClkSourceSelect ClkSource)           { tAD779X_Shim(AD779X_SHIM_DEVICE).SetClkSource(ClkSource); }
+void AD779X_SetUpdateRate(AD779X_SHIM_P tAD779X_FilterSelect UpdateRates)           { tAD779X_Shim(AD779X_SHIM_DEVICE).SetUpdateRate(UpdateRates); }
+void AD779X_SetChannel(AD779X_SHIM_P tAD779X_ChSelect Channel)                      { tAD779X_Shim(AD779X_SHIM_DEVICE).SetChannel(Channel); }
+void AD779X_SetGain(AD779X_SHIM_P tAD779X_GainSelect Gain)                          { tAD779X_Shim(AD779X_SHIM_DEVICE).SetGain(Gain); }
+void AD779X_SetPolarity(AD779X_SHIM_P tAD779X_BSelect Polarity)                     { tAD779X_Shim(AD779X_SHIM_DEVICE).SetPolarity(Polarity); }
+void AD779X_SetBuffer(AD779X_SHIM_P tAD779X_BufSelect Buffer)                       { tAD779X_Shim(AD779X_SHIM_DEVICE).SetBuffer(Buffer); }
+void AD779X_SetReference(AD779X_SHIM_P tAD779X_RefSelect Reference)                 { tAD779X_Shim(AD779X_SHIM_DEVICE).SetReference(Reference); }
+void AD779X_SetBias(AD779X_SHIM_P tAD779X_VbiasSelect Bias)                         { tAD779X_Shim(AD779X_SHIM_DEVICE).SetBias(Bias); }
+void AD779X_SetExCurrentValue(AD779X_SHIM_P tAD779X_IEXCENSelect excValue)          { tAD779X_Shim(AD779X_SHIM_DEVICE).SetExCurrentValue(excValue); }
+void AD779X_SetExCurrentDirection(AD779X_SHIM_P tAD779X_IEXCDIRSelect excDir)       { tAD779X_Shim(AD779X_SHIM_DEVICE).SetExCurrentDirection(excDir); }
+void AD779X_StartZSCalibration(AD779X_SHIM_P0)                                      { tAD779X_Shim(AD779X_SHIM_DEVICE).StartZSCalibration(); }
+void AD779X_StartFSCalibration(AD779X_SHIM_P0)                                      { tAD779X_Shim(AD779X_SHIM_DEVICE).StartFSCalibration(); }
+unsigned short AD779X_ReadOffsetRegister16(AD779X_SHIM_P0)                          { return tAD779X_Shim(AD779X_SHIM_DEVICE).ReadOffsetRegister16(); }
+unsigned long AD779X_ReadOffsetRegister24(AD779X_SHIM_P0)                           { return tAD779X_Shim(AD779X_SHIM_DEVICE).ReadOffsetRegister24(); }
+unsigned short AD779X_ReadFScaleRegister16(AD779X_SHIM_P0)                          { return tAD779X_Shim(AD779X_SHIM_DEVICE).ReadFScaleRegister16(); }
+unsigned long AD779X_ReadFScaleRegister24(AD779X_SHIM_P0)                           { return tAD779X_Shim(AD779X_SHIM_DEVICE).ReadFScaleRegister24(); }
+void AD779X_WriteOffsetRegister16(AD779X_SHIM_P unsigned short Data)                { tAD779X_Shim(AD779X_SHIM_DEVICE).WriteOffsetRegister16(Data); }
+void AD779X_WriteOffsetRegister24(AD779X_SHIM_P unsigned long Data)                 { tAD779X_Shim(AD779X_SHIM_DEVICE).WriteOffsetRegister24(Data); }
+void AD779X_WriteFScaleRegister16(AD779X_SHIM_P unsigned short Data)                { tAD779X_Shim(AD779X_SHIM_DEVICE).WriteFScaleRegister16(Data); }
+void AD779X_WriteFScaleRegister24(AD779X_SHIM_P unsigned long Data)                 { tAD779X_Shim(AD779X_SHIM_DEVICE).WriteFScaleRegister24(Data); }
+unsigned short AD779X_ReadDataRegister16(AD779X_SHIM_P0)                            { return tAD779X_Shim(AD779X_SHIM_DEVICE).ReadDataRegister16(); }
+unsigned long AD779X_ReadDataRegister24(AD779X_SHIM_P0)                             { return tAD779X_Shim(AD779X_SHIM_DEVICE).ReadDataRegister24(); }
+
+}
@@ -0,0 +1,228 @@
+/**
+  ******************************************************************************
+  * @file    ad779x_shim_test.c
+  * @author  Khusainov Timur
+  * @version 0.0.0.1
+  * @date    16.10.2026
+  * @brief   AD7792/AD7793: same results of C core and template core (ad779x_shim.cpp)
+  ******************************************************************************
+  * @attention
+  * <h2><center>&copy; COPYRIGHT 2011 timypik@gmail.com </center></h2>
+  ******************************************************************************
+  *
+  * Scenario on virtual chip prints results, state of device, telemetry and bus
+  * traffic. Build it with C core and with template core, outputs must be same
+  * (multiple variant; single: -I../ad779x_single, ../ad779x_single/ad779x.c):
+  *   cc -O2 -I../ad779x_multiple -I../ad779x_host ad779x_shim_test.c ../ad779x_host/ad779x_vchip.c ../ad779x_multiple/ad779x.c -lm -o shim_test_c
+  *   cc -O2 -DAD779X_CORE_SHIM -I../ad779x_multiple -I../ad779x_host -c ad779x_shim_test.c ../ad779x_host/ad779x_vchip.c ../ad779x_multiple/ad779x.c
+  *   c++ -O2 -DAD779X_CORE_SHIM -I../ad779x_multiple -c ad779x_shim.cpp
+  *   c++ ad779x_shim_test.o ad779x_vchip.o ad779x.o ad779x_shim.o -lm -o shim_test_cpp
+  *   ./shim_test_c > c.txt; ./shim_test_cpp > cpp.txt; cmp c.txt cpp.txt
+  */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "ad779x_vchip.h"
+
+#if defined(AD779X_VARIANT_SINGLE)
+tAD779X_Device ADCDevice;
+#define DEV
+#define DEV_
+#define pTestDevice (&ADCDevice)
+#else
+static tAD779X_Device gTestDevice;
+#define DEV  &gTestDevice
+#define DEV_ &gTestDevice,
+#define pTestDevice (&gTestDevice)
+#endif
+
+/* Virtual chip under test */
+static tAD779X_VChip gChip;
+
+/* Scan of sequencer */
+static const tAD779X_ScanStep gScan[3] =
+{
+	{chsAIN1,       gain1, fs500},
+	{chsAIN2,       gain2, fs250},
+	{chsTempSensor, gain1, fs500}
+};
+
+/**
+ * @brief  Print state of device and chip
+ * @param  pName - name of step
+ * @return None
+ */
+static void TestState(const char *pName)
+{
+	printf("%-12s model %u su %u mode %04X config %04X io %02X read %u deadline %u/%lu chip mode %04X config %04X io %02X\n",
+		pName, pTestDevice->Model, pTestDevice->SuState, pTestDevice->ModeReg.DATA, pTestDevice->ConfigReg.DATA,
+		pTestDevice->IOReg.DATA, pTestDevice->ReadMode, pTestDevice->DeadlineSet,
+		pTestDevice->DeadlineSet ? (unsigned long)pTestDevice->Deadline : 0UL,
+		gChip.ModeReg.DATA, gChip.ConfigReg.DATA, gChip.IOReg.DATA);
+
+#if defined(AD779X_VARIANT_SINGLE)
+	printf("%-12s offset %08lX fscale %08lX\n", "", ADCDevice.OfReg.u32, ADCDevice.FsReg.u32);
+#endif
+}
+
+/**
+ * @brief  Run scenario on model
+ * @param  Model - model of virtual chip
+ * @param  UseBlock - use TxRxBlock callback
+ * @return None
+ */
+static void TestModel(tAD779X_Model Model, uint8_t UseBlock)
+{
+	tAD779X_Sequencer m_seq;
+	tAD779X_ShotStats m_shot;
+	unsigned long m_sample;
+	uint8_t i, m_step;
+	
+	printf("\n[%s, %s]\n", (Model == ad7793) ? "AD7793" : "AD7792", UseBlock ? "TxRxBlock" : "TxByte/RxByte");
+	
+	AD779X_VChipDetach(&gChip);
+	AD779X_VChipInit(&gChip, Model);
+	gChip.Signals[chsAIN1].Dc = 0.5;
+	gChip.Signals[chsAIN2].Dc = -0.25;
+	
+	memset(pTestDevice, 0, sizeof(*pTestDevice));
+	memset(&m_shot, 0, sizeof(m_shot));
+	AD779X_VChipAttach(&gChip, pTestDevice, UseBlock);
+	
+	AD779X_Reset(DEV);
+	TestState("reset");
+	
+	AD779X_Init(DEV);
+	TestState("init");
+	
+	/* one call in each printf: order of reads is fixed */
+	printf("detect %u", AD779X_HWDetect(DEV));
+	printf(" status %02X", AD779X_GetStatus(DEV));
+	printf(" ready %u", AD779X_CheckReadySW(DEV));
+	printf("/%u\n", AD779X_CheckReadyHW(DEV));
+	
+	AD779X_SetGain(DEV_ gain1);
+	AD779X_SetReference(DEV_ refInt);
+	AD779X_SetPolarity(DEV_ ubBipolar);
+	AD779X_SetBuffer(DEV_ bufEnable);
+	AD779X_SetBias(DEV_ biasNone);
+	AD779X_SetExCurrentValue(DEV_ csv10uA);
+	AD779X_SetExCurrentDirection(DEV_ csdInverse);
+	AD779X_SetExCurrentValue(DEV_ csvDisable);
+	AD779X_SetClkSource(DEV_ cssInt);
+	AD779X_SetUpdateRate(DEV_ fs500);
+	AD779X_SetChannel(DEV_ chsAIN1);
+	AD779X_SetMode(DEV_ mdsContinuous);
+	TestState("setup");
+	
+	/* data reads */
+	printf("wait %u", AD779X_WaitReady(DEV_ 100000));
+	printf(" sample24 %06lX", AD779X_ReadDataSample24(DEV));
+	printf(" sample16 %04X", AD779X_ReadDataSample16(DEV));
+	printf(" data16 %04X", AD779X_ReadDataRegister16(DEV));
+	printf(" data24 %06lX\n", AD779X_ReadDataRegister24(DEV));
+	
+	/* calibration registers */
+	AD779X_SetMode(DEV_ mdsIdle);
+	AD779X_StartZSCalibration(DEV);
+	printf("zs wait %u", AD779X_WaitReady(DEV_ 1000000));
+	AD779X_StartFSCalibration(DEV);
+	printf(" fs wait %u", AD779X_WaitReady(DEV_ 1000000));
+	printf(" offset %04X", AD779X_ReadOffsetRegister16(DEV));
+	printf("/%06lX", AD779X_ReadOffsetRegister24(DEV));
+	printf(" fscale %04X", AD779X_ReadFScaleRegister16(DEV));
+	printf("/%06lX\n", AD779X_ReadFScaleRegister24(DEV));
+	TestState("calibration");
+	
+	AD779X_WriteOffsetRegister16(DEV_ 0x8001);
+	AD779X_WriteFScaleRegister16(DEV_ 0x5002);
+	printf("offset16 %04X", AD779X_ReadOffsetRegister16(DEV));
+	printf(" fscale16 %04X", AD779X_ReadFScaleRegister16(DEV));
+	AD779X_WriteOffsetRegister24(DEV_ 0x800003UL);
+	AD779X_WriteFScaleRegister24(DEV_ 0x500004UL);
+	printf(" offset24 %06lX", AD779X_ReadOffsetRegister24(DEV));
+	printf(" fscale24 %06lX\n", AD779X_ReadFScaleRegister24(DEV));
+	
+	/* single shots: core functions with deadline of C driver */
+	for (i = 0; i < 2; i++)
+	{
+		printf("shot %u", AD779X_SingleShot(DEV_ chsAIN2, gain1, fs500, (i == 0) ? sspPowerDown : sspIdle, &m_sample, &m_shot));
+		printf(" sample %06lX last %lu us\n", m_sample, (unsigned long)m_shot.LastUs);
+		TestState("shot");
+	}
+	
+	/* continuous read */
+	AD779X_SetMode(DEV_ mdsContinuous);
+	AD779X_StartContinuousRead(DEV);
+	
+	for (i = 0; i < 4; i++)
+		printf("continuous %06lX\n", AD779X_ReadContinuousSample24(DEV));
+	
+	printf("stop %06lX\n", AD779X_StopContinuousRead(DEV));
+	TestState("continuous");
+	
+	/* sequencer */
+	AD779X_SeqStart(DEV_ &m_seq, gScan, 3);
+	
+	for (i = 0; i < 6; i++)
+	{
+		while (!AD779X_CheckReadyHW(DEV));
+		m_sample = AD779X_SeqService(DEV_ &m_seq, &m_step);
+		printf("scan %u %06lX\n", m_step, m_sample);
+	}
+	
+	TestState("scan");
+	
+	AD779X_Reset(DEV);
+	TestState("reset");
+	
+	printf("telemetry conversions %lu timeouts %lu overruns %lu detect fails %lu\n",
+		(unsigned long)pTestDevice->Telemetry.Conversions, (unsigned long)pTestDevice->Telemetry.Timeouts,
+		(unsigned long)pTestDevice->Telemetry.Overruns, (unsigned long)pTestDevice->Telemetry.DetectFails);
+	printf("bus callbacks %lu cs %lu bytes %lu blocks %lu polls %lu conversions %lu time %lu us\n",
+		gChip.Stats.Callbacks, gChip.Stats.CSToggles, gChip.Stats.Bytes, gChip.Stats.Blocks,
+		gChip.Stats.RDYPolls, gChip.Stats.Conversions, (unsigned long)AD779X_VChipTimeUs(&gChip));
+}
+
+/* Bus without ADC: DOUT stays high */
+static void TestNoCS(unsigned char State) { (void)State; }
+static void TestNoTx(unsigned char Data) { (void)Data; }
+static unsigned char TestNoRx(void) { return 0xFF; }
+static unsigned char TestNoRDY(void) { return rdsBusy; }
+
+/**
+ * @brief  Run init without ADC
+ * @param  None
+ * @return None
+ */
+static void TestNoHW(void)
+{
+	printf("\n[no ADC]\n");
+	
+	AD779X_VChipDetach(&gChip);
+	memset(pTestDevice, 0, sizeof(*pTestDevice));
+	memset(&gChip, 0, sizeof(gChip));
+	
+	pTestDevice->CSControl = TestNoCS;
+	pTestDevice->TxByte    = TestNoTx;
+	pTestDevice->RxByte    = TestNoRx;
+	pTestDevice->RDYState  = TestNoRDY;
+	
+	AD779X_Init(DEV);
+	printf("detect %u\n", AD779X_HWDetect(DEV));
+	TestState("init");
+	
+	printf("telemetry detect fails %lu\n", (unsigned long)pTestDevice->Telemetry.DetectFails);
+}
+
+int main(void)
+{
+	TestModel(ad7792, 0);
+	TestModel(ad7792, 1);
+	TestModel(ad7793, 0);
+	TestModel(ad7793, 1);
+	TestNoHW();
+	
+	return 0;
+}
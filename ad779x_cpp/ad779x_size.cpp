@@ -0,0 +1,115 @@
+/**
+  ******************************************************************************
+  * @file    ad779x_size.cpp
+  * @author  Khusainov Timur
+  * @version 0.0.0.1
+  * @date    16.10.2026
+  * @brief   AD7792/AD7793: code size of C driver and C++ template on same workload
+  ******************************************************************************
+  * @attention
+  * <h2><center>&copy; COPYRIGHT 2011 timypik@gmail.com </center></h2>
+  ******************************************************************************
+  *
+  * Workload: init, channel/gain/mode setup, one RDY wait and sample read, on
+  * bus of fake MCU pins (volatile registers). Entry point is AD779X_SizeWorkload,
+  * so only reachable code is linked (no C library, no startup files):
+  *   F="-Os -fno-exceptions -fno-rtti -fno-asynchronous-unwind-tables -ffunction-sections -fdata-sections"
+  *   L="-nostdlib -static -Wl,-e,AD779X_SizeWorkload -Wl,--gc-sections"
+  *   cc $F -I../ad779x_single -c ../ad779x_single/ad779x.c -o ad779x_single.o
+  *   c++ $F -DAD779X_SIZE_C -I../ad779x_single ad779x_size.cpp ad779x_single.o $L -o size_c
+  *   c++ $F -I../ad779x_single ad779x_size.cpp $L -o size_template
+  *   size size_c size_template
+  * Text of C driver includes telemetry counters and deadline (WriteModeRegister,
+  * WriteConfigRegister), template has none of them.
+  */
+
+#include "ad779x.hpp"
+
+/* Fake pins of MCU: SPI data register, cs and DOUT/RDY lines */
+static volatile uint8_t gSizeSpiData;
+static volatile uint8_t gSizeCSPin;
+static volatile uint8_t gSizeRDYPin;
+
+/* Keep result alive */
+volatile unsigned long gSizeSink;
+
+#if defined(AD779X_SIZE_C)
+
+#if defined(AD779X_VARIANT_SINGLE)
+tAD779X_Device ADCDevice;
+#define DEV
+#define DEV_
+#define pSizeDevice (&ADCDevice)
+#else
+static tAD779X_Device gSizeDevice;
+#define DEV  &gSizeDevice
+#define DEV_ &gSizeDevice,
+#define pSizeDevice (&gSizeDevice)
+#endif
+
+static void SizeCSControl(unsigned char State) { gSizeCSPin = State; }
+static void SizeTxByte(unsigned char Data)     { gSizeSpiData = Data; }
+static unsigned char SizeRxByte(void)          { gSizeSpiData = 0xFF; return gSizeSpiData; }
+static unsigned char SizeRDYState(void)        { return gSizeRDYPin; }
+
+extern "C" void AD779X_SizeWorkload(void)
+{
+	pSizeDevice->CSControl = SizeCSControl;
+	pSizeDevice->TxByte    = SizeTxByte;
+	pSizeDevice->RxByte    = SizeRxByte;
+	pSizeDevice->RDYState  = SizeRDYState;
+	
+	AD779X_Init(DEV);
+	AD779X_SetChannel(DEV_ chsAIN2);
+	AD779X_SetGain(DEV_ gain1);
+	AD779X_SetMode(DEV_ mdsContinuous);
+	
+	while (!AD779X_CheckReadyHW(DEV));
+	
+	gSizeSink = AD779X_ReadDataSample24(DEV);
+}
+
+#else
+
+/**
+ * @brief Bus policy on fake pins: no data, empty base of driver
+ */
+struct tAD779X_SizeBus
+{
+	void Select(bool Active)
+	{
+		gSizeCSPin = Active ? cssEnable : cssDisable;
+	}
+	
+	void Transfer(const uint8_t *pTx, uint8_t *pRx, uint8_t Size, uint8_t TxSize)
+	{
+		uint8_t i;
+		
+		for (i = 0; i < Size; i++)
+		{
+			gSizeSpiData = (i < TxSize) ? pTx[i] : 0xFF;
+			pRx[i] = gSizeSpiData;
+		}
+	}
+	
+	bool Ready()
+	{
+		return gSizeRDYPin == rdsFree;
+	}
+};
+
+static AD779x<tAD779X_SizeBus> gSizeAdc;
+
+extern "C" void AD779X_SizeWorkload(void)
+{
+	gSizeAdc.Init();
+	gSizeAdc.SetChannel(chsAIN2);
+	gSizeAdc.SetGain(gain1);
+	gSizeAdc.SetMode(mdsContinuous);
+	
+	while (!gSizeAdc.CheckReadyHW());
+	
+	gSizeSink = gSizeAdc.ReadDataSample24();
+}
+
+#endif
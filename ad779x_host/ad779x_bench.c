@@ -0,0 +1,335 @@
+/**
+  ******************************************************************************
+  * @file    ad779x_bench.c
+  * @author  Khusainov Timur
+  * @version 0.0.0.1
+  * @date    16.10.2026
+  * @brief   AD7792/AD7793 driver: bus cost benchmark on virtual chip
+  ******************************************************************************
+  * @attention
+  * <h2><center>&copy; COPYRIGHT 2011 timypik@gmail.com </center></h2>
+  ******************************************************************************
+  *
+  * Build for each variant of driver, e.g.:
+  *   cc -O2 -I../ad779x_single ad779x_bench.c ad779x_vchip.c ../ad779x_single/ad779x.c -lm -o ad779x_bench_single
+  *   cc -O2 -I../ad779x_multiple ad779x_bench.c ad779x_vchip.c ../ad779x_multiple/ad779x.c -lm -o ad779x_bench_multiple
+  *
+  * For each public function: SPI bytes, cs toggles, callback calls and host
+  * time per call, with TxByte/RxByte callbacks and with TxRxBlock callback.
+  * Functions waiting for conversion (fs500) are called less times.
+  */
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include "ad779x_vchip.h"
+
+/* Count of calls of each entry point */
+#ifndef AD779X_BENCH_CALLS
+#define AD779X_BENCH_CALLS 20000
+#endif
+
+/* Count of samples of scan loop */
+#ifndef AD779X_BENCH_SAMPLES
+#define AD779X_BENCH_SAMPLES 2000
+#endif
+
+#if defined(AD779X_VARIANT_SINGLE)
+tAD779X_Device ADCDevice;
+#define AD779X_BENCH_VARIANT "single"
+#define DEV
+#define DEV_
+#define pBenchDevice (&ADCDevice)
+#else
+static tAD779X_Device gBenchDevice;
+#define AD779X_BENCH_VARIANT "multiple"
+#define DEV  &gBenchDevice
+#define DEV_ &gBenchDevice,
+#define pBenchDevice (&gBenchDevice)
+#endif
+
+/* Virtual chip under test */
+static tAD779X_VChip gChip;
+
+/* Scan sequencer and ring of bench */
+static tAD779X_Sequencer gSeq;
+static tAD779X_RingSample gRingBuffer[16];
+static tAD779X_SampleRing gRing;
+static const tAD779X_ScanStep gScan[5] =
+{
+	{chsAIN1,       gain1, fs500},
+	{chsAIN2,       gain1, fs500},
+	{chsAIN3,       gain1, fs500},
+	{chsTempSensor, gain1, fs500},
+	{chsAVMonitor,  gain1, fs500}
+};
+
+/* Toggle for setters, so each call changes register */
+static unsigned int gToggle;
+
+/* Transaction and calibration entry of bench */
+static tAD779X_Transaction gTrans;
+static tAD779X_CalEntry gCalEntry;
+
+/* Keep results alive */
+static volatile unsigned long gSink;
+
+static void BenchInit(void)                { AD779X_Init(DEV); }
+static void BenchReset(void)               { AD779X_Reset(DEV); }
+static void BenchHWDetect(void)            { gSink = AD779X_HWDetect(DEV); }
+static void BenchGetStatus(void)           { gSink = AD779X_GetStatus(DEV); }
+static void BenchCheckReadySW(void)        { gSink = AD779X_CheckReadySW(DEV); }
+static void BenchCheckReadyHW(void)        { gSink = AD779X_CheckReadyHW(DEV); }
+static void BenchWriteMode(void)           { AD779X_WriteModeRegister(DEV_ 0x400A); }
+static void BenchWriteConfig(void)         { AD779X_WriteConfigRegister(DEV_ 0x0710); }
+static void BenchWriteIO(void)             { AD779X_WriteIORegister(DEV_ 0x00); }
+static void BenchSetModeSame(void)         { AD779X_SetMode(DEV_ mdsIdle); }
+static void BenchSetClkSource(void)        { AD779X_SetClkSource(DEV_ (++gToggle & 1) ? cssIntOut : cssInt); }
+static void BenchSetUpdateRate(void)       { AD779X_SetUpdateRate(DEV_ (++gToggle & 1) ? fs500 : fs250); }
+static void BenchSetUpdateRateSame(void)   { AD779X_SetUpdateRate(DEV_ fs500); }
+static void BenchSetChannel(void)          { AD779X_SetChannel(DEV_ (++gToggle & 1) ? chsAIN1 : chsAIN2); }
+static void BenchSetGain(void)             { AD779X_SetGain(DEV_ (++gToggle & 1) ? gain1 : gain2); }
+static void BenchSetPolarity(void)         { AD779X_SetPolarity(DEV_ (++gToggle & 1) ? ubUnipolar : ubBipolar); }
+static void BenchSetBuffer(void)           { AD779X_SetBuffer(DEV_ (++gToggle & 1) ? bufDisable : bufEnable); }
+static void BenchSetReference(void)        { AD779X_SetReference(DEV_ (++gToggle & 1) ? refInt : refExt); }
+static void BenchSetBias(void)             { AD779X_SetBias(DEV_ (++gToggle & 1) ? biasAIN1 : biasNone); }
+static void BenchSetExCurrent(void)        { AD779X_SetExCurrentValue(DEV_ (++gToggle & 1) ? csv10uA : csvDisable); }
+static void BenchSetExCurrentDir(void)     { AD779X_SetExCurrentDirection(DEV_ (++gToggle & 1) ? csdInverse : csdNormal); }
+static void BenchStartZSCalibration(void)  { AD779X_StartZSCalibration(DEV); }
+static void BenchStartFSCalibration(void)  { AD779X_StartFSCalibration(DEV); }
+static void BenchReadOffset16(void)        { gSink = AD779X_ReadOffsetRegister16(DEV); }
+static void BenchReadOffset24(void)        { gSink = AD779X_ReadOffsetRegister24(DEV); }
+static void BenchReadFScale16(void)        { gSink = AD779X_ReadFScaleRegister16(DEV); }
+static void BenchReadFScale24(void)        { gSink = AD779X_ReadFScaleRegister24(DEV); }
+static void BenchWriteOffset16(void)       { AD779X_WriteOffsetRegister16(DEV_ 0x8000); }
+static void BenchWriteOffset24(void)       { AD779X_WriteOffsetRegister24(DEV_ 0x800000UL); }
+static void BenchWriteFScale16(void)       { AD779X_WriteFScaleRegister16(DEV_ 0x5000); }
+static void BenchWriteFScale24(void)       { AD779X_WriteFScaleRegister24(DEV_ 0x500000UL); }
+static void BenchReadDataRegister16(void)  { gSink = AD779X_ReadDataRegister16(DEV); }
+static void BenchReadDataRegister24(void)  { gSink = AD779X_ReadDataRegister24(DEV); }
+#if !defined(AD779X_VARIANT_SINGLE)
+static void BenchReadDataSample(void)      { gSink = AD779X_ReadDataSample(DEV); }
+#else
+static void BenchSetExCurrentBoth(void)    { AD779X_SetExCurrent((++gToggle & 1) ? csv10uA : csvDisable, csdNormal); }
+#endif
+static void BenchReadDataSample16(void)    { gSink = AD779X_ReadDataSample16(DEV); }
+static void BenchReadDataSample24(void)    { gSink = AD779X_ReadDataSample24(DEV); }
+static void BenchStartStopContinuous(void) { AD779X_StartContinuousRead(DEV); gSink = AD779X_StopContinuousRead(DEV); }
+static void BenchReadContSample(void)      { gSink = AD779X_ReadContinuousSample24(DEV); }
+static void BenchReadContinuous(void)      { unsigned long m_buf[4]; AD779X_ReadContinuous24(DEV_ m_buf, 4); gSink = m_buf[3]; }
+static void BenchRingCount(void)           { gSink = AD779X_RingCount(&gRing); }
+static void BenchOnDataReady(void)         { AD779X_OnDataReady(DEV); AD779X_RingRead(&gRing, gRingBuffer, 16); }
+static void BenchReadSampleRecord(void)    { tAD779X_SampleRecord m_rec; AD779X_ReadSampleRecord(DEV_ &m_rec); gSink = m_rec.Code; }
+static void BenchSeqStart(void)            { AD779X_SeqStart(DEV_ &gSeq, gScan, 5); }
+static void BenchSeqService(void)          { uint8_t m_step; gSink = AD779X_SeqService(DEV_ &gSeq, &m_step); }
+static void BenchTransExecute(void)        { AD779X_TransExecute(DEV_ &gTrans); gSink = AD779X_TransResult(&gTrans, 2); }
+static void BenchSetConfiguration(void)    { AD779X_SetConfiguration(DEV_ (++gToggle & 1) ? 0x0710 : 0x0711, 0x400A, 0x00); }
+static void BenchWriteCalibration(void)    { AD779X_WriteCalibration(DEV_ &gCalEntry); }
+static void BenchReadCalibration(void)     { AD779X_ReadCalibration(DEV_ &gCalEntry); }
+static void BenchConversionTime(void)      { gSink = AD779X_ConversionTimeUs((tAD779X_FilterSelect)(++gToggle & 0x0F), cssInt); }
+static void BenchSettlingTime(void)        { gSink = AD779X_SettlingTimeUs((tAD779X_FilterSelect)(++gToggle & 0x0F), cssInt); }
+static void BenchWaitReady(void)           { gSink = AD779X_WaitReady(DEV_ 100000); gSink = AD779X_ReadDataSample24(DEV); }
+static void BenchSingleShot(void)          { unsigned long m_sample; gSink = AD779X_SingleShot(DEV_ chsAIN1, gain1, fs500, sspIdle, &m_sample, NULL); }
+static void BenchGetTelemetry(void)        { tAD779X_Telemetry m_tel; AD779X_GetTelemetry(DEV_ &m_tel); gSink = m_tel.Conversions; }
+
+/* Setup before calls of entry point */
+static void BenchPrepContinuous(void)      { AD779X_SetMode(DEV_ mdsContinuous); }
+static void BenchPrepContinuousRead(void)  { AD779X_SetMode(DEV_ mdsContinuous); AD779X_StartContinuousRead(DEV); }
+static void BenchPrepCalibration(void)     { AD779X_ReadCalibration(DEV_ &gCalEntry); }
+
+static void BenchPrepTrans(void)
+{
+	AD779X_TransInit(&gTrans);
+	AD779X_TransWriteConfig(&gTrans, 0x0710);
+	AD779X_TransWriteMode(&gTrans, 0x400A);
+	AD779X_TransRead(&gTrans, AD779X_RDR_STATUS, 1);
+}
+
+/* Entry points: setup (NULL - none), divider of count of calls (waits for conversion) */
+static const struct
+{
+	const char *Name;
+	void (* Call)(void);
+	void (* Prep)(void);
+	unsigned int Div;
+} gBench[] =
+{
+	{"AD779X_Init",                      BenchInit,                  NULL,                     1},
+	{"AD779X_Reset",                     BenchReset,                 NULL,                     1},
+	{"AD779X_HWDetect",                  BenchHWDetect,              NULL,                     1},
+	{"AD779X_GetStatus",                 BenchGetStatus,             NULL,                     1},
+	{"AD779X_CheckReadySW",              BenchCheckReadySW,          NULL,                     1},
+	{"AD779X_CheckReadyHW",              BenchCheckReadyHW,          NULL,                     1},
+	{"AD779X_WriteModeRegister",         BenchWriteMode,             NULL,                     1},
+	{"AD779X_WriteConfigRegister",       BenchWriteConfig,           NULL,                     1},
+	{"AD779X_WriteIORegister",           BenchWriteIO,               NULL,                     1},
+	{"AD779X_SetMode (same)",            BenchSetModeSame,           NULL,                     1},
+	{"AD779X_SetClkSource",              BenchSetClkSource,          NULL,                     1},
+	{"AD779X_SetUpdateRate",             BenchSetUpdateRate,         NULL,                     1},
+	{"AD779X_SetUpdateRate (same)",      BenchSetUpdateRateSame,     NULL,                     1},
+	{"AD779X_SetChannel",                BenchSetChannel,            NULL,                     1},
+	{"AD779X_SetGain",                   BenchSetGain,               NULL,                     1},
+	{"AD779X_SetPolarity",               BenchSetPolarity,           NULL,                     1},
+	{"AD779X_SetBuffer",                 BenchSetBuffer,             NULL,                     1},
+	{"AD779X_SetReference",              BenchSetReference,          NULL,                     1},
+	{"AD779X_SetBias",                   BenchSetBias,               NULL,                     1},
+	{"AD779X_SetExCurrentValue",         BenchSetExCurrent,          NULL,                     1},
+	{"AD779X_SetExCurrentDirection",     BenchSetExCurrentDir,       NULL,                     1},
+#if defined(AD779X_VARIANT_SINGLE)
+	{"AD779X_SetExCurrent",              BenchSetExCurrentBoth,      NULL,                     1},
+#endif
+	{"AD779X_StartZSCalibration",        BenchStartZSCalibration,    NULL,                     1},
+	{"AD779X_StartFSCalibration",        BenchStartFSCalibration,    NULL,                     1},
+	{"AD779X_ReadOffsetRegister16",      BenchReadOffset16,          NULL,                     1},
+	{"AD779X_ReadOffsetRegister24",      BenchReadOffset24,          NULL,                     1},
+	{"AD779X_ReadFScaleRegister16",      BenchReadFScale16,          NULL,                     1},
+	{"AD779X_ReadFScaleRegister24",      BenchReadFScale24,          NULL,                     1},
+	{"AD779X_WriteOffsetRegister16",     BenchWriteOffset16,         NULL,                     1},
+	{"AD779X_WriteOffsetRegister24",     BenchWriteOffset24,         NULL,                     1},
+	{"AD779X_WriteFScaleRegister16",     BenchWriteFScale16,         NULL,                     1},
+	{"AD779X_WriteFScaleRegister24",     BenchWriteFScale24,         NULL,                     1},
+	{"AD779X_ReadDataRegister16",        BenchReadDataRegister16,    NULL,                     1},
+	{"AD779X_ReadDataRegister24",        BenchReadDataRegister24,    NULL,                     1},
+#if !defined(AD779X_VARIANT_SINGLE)
+	{"AD779X_ReadDataSample",            BenchReadDataSample,        NULL,                     1},
+#endif
+	{"AD779X_ReadDataSample16",          BenchReadDataSample16,      NULL,                     1},
+	{"AD779X_ReadDataSample24",          BenchReadDataSample24,      NULL,                     1},
+	{"AD779X_Start/StopContinuousRead",  BenchStartStopContinuous,   BenchPrepContinuous,      100},
+	{"AD779X_ReadContinuousSample24",    BenchReadContSample,        BenchPrepContinuousRead,  100},
+	{"AD779X_ReadContinuous24 (4)",      BenchReadContinuous,        BenchPrepContinuousRead,  400},
+	{"AD779X_RingCount",                 BenchRingCount,             NULL,                     1},
+	{"AD779X_OnDataReady",               BenchOnDataReady,           NULL,                     1},
+	{"AD779X_ReadSampleRecord",          BenchReadSampleRecord,      NULL,                     1},
+	{"AD779X_SeqStart",                  BenchSeqStart,              NULL,                     1},
+	{"AD779X_SeqService",                BenchSeqService,            NULL,                     1},
+	{"AD779X_TransExecute",              BenchTransExecute,          BenchPrepTrans,           1},
+	{"AD779X_SetConfiguration",          BenchSetConfiguration,      NULL,                     1},
+	{"AD779X_WriteCalibration",          BenchWriteCalibration,      BenchPrepCalibration,     1},
+	{"AD779X_ReadCalibration",           BenchReadCalibration,       NULL,                     1},
+	{"AD779X_ConversionTimeUs",          BenchConversionTime,        NULL,                     1},
+	{"AD779X_SettlingTimeUs",            BenchSettlingTime,          NULL,                     1},
+	{"AD779X_WaitReady + sample",        BenchWaitReady,             BenchPrepContinuous,      100},
+	{"AD779X_SingleShot",                BenchSingleShot,            NULL,                     100},
+	{"AD779X_GetTelemetry",              BenchGetTelemetry,          NULL,                     1}
+};
+
+/**
+ * @brief  Get host monotonic time
+ * @param  None
+ * @return Time, ns
+ */
+static uint64_t BenchTimeNs(void)
+{
+	struct timespec m_ts;
+	
+	clock_gettime(CLOCK_MONOTONIC, &m_ts);
+	
+	return (uint64_t)m_ts.tv_sec * 1000000000ULL + m_ts.tv_nsec;
+}
+
+/**
+ * @brief  Attach virtual chip and init device
+ * @param  UseBlock - use TxRxBlock callback
+ * @return None
+ */
+static void BenchSetup(uint8_t UseBlock)
+{
+	AD779X_VChipDetach(&gChip);
+	AD779X_VChipInit(&gChip, ad7793);
+	
+	memset(pBenchDevice, 0, sizeof(*pBenchDevice));
+	AD779X_VChipAttach(&gChip, pBenchDevice, UseBlock);
+	AD779X_Init(DEV);
+	
+	AD779X_RingInit(&gRing, gRingBuffer, 16);
+	pBenchDevice->pRing = &gRing;
+	
+	AD779X_SeqStart(DEV_ &gSeq, gScan, 5);
+	AD779X_SetMode(DEV_ mdsIdle);
+}
+
+/**
+ * @brief  Measure entry points
+ * @param  UseBlock - use TxRxBlock callback
+ * @return None
+ */
+static void BenchEntryPoints(uint8_t UseBlock)
+{
+	tAD779X_VChipStats m_stats;
+	uint64_t m_time;
+	double m_calls;
+	unsigned int i, j;
+	
+	printf("\n[%s, %s]\n", AD779X_BENCH_VARIANT, UseBlock ? "TxRxBlock" : "TxByte/RxByte");
+	printf("%-32s %8s %8s %10s %10s\n", "entry point", "bytes", "cs", "callbacks", "host ns");
+	
+	for (i = 0; i < sizeof(gBench) / sizeof(gBench[0]); i++)
+	{
+		BenchSetup(UseBlock);
+		
+		if (gBench[i].Prep)
+			gBench[i].Prep();
+		
+		memset(&gChip.Stats, 0, sizeof(gChip.Stats));
+		m_calls = AD779X_BENCH_CALLS / gBench[i].Div;
+		
+		m_time = BenchTimeNs();
+		
+		for (j = 0; j < AD779X_BENCH_CALLS / gBench[i].Div; j++)
+			gBench[i].Call();
+		
+		m_time = BenchTimeNs() - m_time;
+		m_stats = gChip.Stats;
+		
+		printf("%-32s %8.2f %8.2f %10.2f %10.1f\n", gBench[i].Name,
+			m_stats.Bytes / m_calls, m_stats.CSToggles / m_calls,
+			m_stats.Callbacks / m_calls, m_time / m_calls);
+	}
+}
+
+/**
+ * @brief  Measure scan loop: wait RDY, read sample, set next step
+ * @param  UseBlock - use TxRxBlock callback
+ * @return None
+ */
+static void BenchScanLoop(uint8_t UseBlock)
+{
+	uint64_t m_time, m_vtime;
+	uint8_t m_step;
+	unsigned int i;
+	
+	BenchSetup(UseBlock);
+	AD779X_SeqStart(DEV_ &gSeq, gScan, 5);
+	memset(&gChip.Stats, 0, sizeof(gChip.Stats));
+	
+	m_vtime = gChip.Now;
+	m_time = BenchTimeNs();
+	
+	for (i = 0; i < AD779X_BENCH_SAMPLES; i++)
+	{
+		while (!AD779X_CheckReadyHW(DEV));
+		gSink = AD779X_SeqService(DEV_ &gSeq, &m_step);
+	}
+	
+	m_time = BenchTimeNs() - m_time;
+	m_vtime = gChip.Now - m_vtime;
+	
+	printf("scan loop (%s, 5 channels, fs500): %.1f samples/s (chip time), host %.1f ns/sample, %.2f bytes/sample\n",
+		UseBlock ? "TxRxBlock" : "TxByte/RxByte",
+		AD779X_BENCH_SAMPLES * 1e9 / m_vtime, (double)m_time / AD779X_BENCH_SAMPLES,
+		(double)gChip.Stats.Bytes / AD779X_BENCH_SAMPLES);
+}
+
+int main(void)
+{
+	BenchEntryPoints(0);
+	BenchEntryPoints(1);
+	
+	printf("\n");
+	BenchScanLoop(0);
+	BenchScanLoop(1);
+	
+	return 0;
+}
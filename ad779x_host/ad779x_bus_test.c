@@ -0,0 +1,250 @@
+/**
+  ******************************************************************************
+  * @file    ad779x_bus_test.c
+  * @author  Khusainov Timur
+  * @version 0.0.0.1
+  * @date    16.10.2026
+  * @brief   AD7792/AD7793 devices on shared SPI bus: test of scheduler on virtual chips
+  ******************************************************************************
+  * @attention
+  * <h2><center>&copy; COPYRIGHT 2011 timypik@gmail.com </center></h2>
+  ******************************************************************************
+  *
+  * Build (multiple variant of driver only):
+  *   cc -O2 -I../ad779x_multiple ad779x_bus_test.c ad779x_vchip.c ../ad779x_multiple/ad779x_bus.c ../ad779x_multiple/ad779x.c -lm -o ad779x_bus_test
+  *
+  * Throughput: each of devices in continuous conversion is served in turn and
+  * no result of virtual chip is lost. Timeout: AD779X_BusWait returns on bus
+  * of devices, that do not convert (Idle) or are lost (RDY line stays high).
+  * Calibration: device without RDY is set to Idle after time limit, others are
+  * calibrated. Exit code is count of failed checks.
+  */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "ad779x_vchip.h"
+#include "ad779x_bus.h"
+
+/* Count of devices on bus (one of them is lost in timeout test) */
+#define AD779X_TEST_DEVICES 4
+
+/* Count of samples of each device in throughput test */
+#define AD779X_TEST_SAMPLES 50
+
+/* Devices and virtual chips under test */
+static tAD779X_Device gDevices[AD779X_TEST_DEVICES];
+static tAD779X_VChip gChips[AD779X_TEST_DEVICES];
+static tAD779X_Bus gBus;
+
+/* Count of failed checks */
+static unsigned int gFails;
+
+#define AD779X_TEST_CHECK(Cond) TestCheck((Cond), #Cond, __LINE__)
+
+/**
+ * @brief  Count and print failed check
+ * @param  Cond - result of check
+ * @param  pText - text of check
+ * @param  Line - line of check
+ * @return None
+ */
+static void TestCheck(int Cond, const char *pText, int Line)
+{
+	if (Cond)
+		return;
+	
+	gFails++;
+	printf("  FAIL line %d: %s\n", Line, pText);
+}
+
+/* Time of lost RDY line: each read takes 1 us */
+static uint32_t gLostTime;
+
+/* Lost device: DOUT/RDY line stays high */
+static void TestLostCS(unsigned char State) { (void)State; }
+static void TestLostTx(unsigned char Data) { (void)Data; }
+static unsigned char TestLostRx(void) { return 0xFF; }
+static unsigned char TestLostRDY(void) { gLostTime++; return rdsBusy; }
+static uint32_t TestLostTimeUs(void) { return gLostTime; }
+
+/**
+ * @brief  Init devices on virtual chips (AD7792 and AD7793 in turn)
+ * @param  None
+ * @return None
+ */
+static void TestInit(void)
+{
+	uint8_t i;
+	
+	for (i = 0; i < AD779X_TEST_DEVICES; i++)
+	{
+		AD779X_VChipDetach(&gChips[i]);
+		AD779X_VChipInit(&gChips[i], (i & 1) ? ad7793 : ad7792);
+		gChips[i].Signals[chsAIN1].Dc = 0.1 * (i + 1);
+		
+		memset(&gDevices[i], 0, sizeof(gDevices[i]));
+		AD779X_VChipAttach(&gChips[i], &gDevices[i], 0);
+		
+		AD779X_Init(&gDevices[i]);
+		AD779X_SetGain(&gDevices[i], gain1);
+		AD779X_SetReference(&gDevices[i], refInt);
+		AD779X_SetChannel(&gDevices[i], chsAIN1);
+		AD779X_SetUpdateRate(&gDevices[i], fs500);
+	}
+	
+	AD779X_BusInit(&gBus, gDevices, AD779X_TEST_DEVICES);
+}
+
+/**
+ * @brief  Throughput: each device is served in turn, no result is lost
+ * @param  None
+ * @return None
+ */
+static void TestThroughput(void)
+{
+	unsigned long m_served[AD779X_TEST_DEVICES] = {0};
+	unsigned long m_sample;
+	unsigned int m_fails = gFails;
+	unsigned int i;
+	uint8_t m_index;
+	
+	TestInit();
+	AD779X_BusStart(&gBus);
+	
+	for (i = 0; i < AD779X_TEST_DEVICES * AD779X_TEST_SAMPLES; i++)
+	{
+		m_index = AD779X_BusWait(&gBus, &m_sample, NULL);
+		AD779X_TEST_CHECK(m_index < AD779X_TEST_DEVICES);
+		
+		if (m_index >= AD779X_TEST_DEVICES)
+			break;
+		
+		/* positive input: sample is above zero code */
+		AD779X_TEST_CHECK(m_sample > 0x800000UL);
+		m_served[m_index]++;
+	}
+	
+	for (i = 0; i < AD779X_TEST_DEVICES; i++)
+	{
+		/* same rate: same share of bus, all results of chip are read */
+		AD779X_TEST_CHECK(m_served[i] + 1 >= AD779X_TEST_SAMPLES);
+		AD779X_TEST_CHECK(m_served[i] <= AD779X_TEST_SAMPLES + 1);
+		AD779X_TEST_CHECK(gChips[i].Stats.Conversions <= m_served[i] + 1);
+	}
+	
+	printf("throughput, %u devices: %s\n", AD779X_TEST_DEVICES, (gFails == m_fails) ? "ok" : "FAIL");
+}
+
+/**
+ * @brief  Timeout: bus wait returns on idle devices and on lost device
+ * @param  None
+ * @return None
+ */
+static void TestTimeout(void)
+{
+	const uint32_t m_limit = 2 * AD779X_SettlingTimeUs(fs500, cssInt) + AD779X_POWER_UP_US;
+	unsigned long m_sample;
+	unsigned int m_fails = gFails;
+	uint32_t m_start, m_time;
+	uint8_t i, m_index;
+	
+	/* all devices are Idle: no RDY will fall */
+	TestInit();
+	
+	for (i = 0; i < AD779X_TEST_DEVICES; i++)
+		AD779X_SetMode(&gDevices[i], mdsIdle);
+	
+	m_start = AD779X_VChipTimeUs(&gChips[0]);
+	AD779X_TEST_CHECK(AD779X_BusWait(&gBus, &m_sample, NULL) == AD779X_BUS_NONE);
+	m_time = AD779X_VChipTimeUs(&gChips[0]) - m_start;
+	
+	/* time of bus is time of first device */
+	AD779X_TEST_CHECK(m_time >= m_limit);
+	AD779X_TEST_CHECK(m_time < 2 * m_limit);
+	
+	/* lost first device (no GetTimeUs), others are Idle: time of bus is time of second device */
+	gDevices[0].CSControl = TestLostCS;
+	gDevices[0].TxByte    = TestLostTx;
+	gDevices[0].RxByte    = TestLostRx;
+	gDevices[0].RDYState  = TestLostRDY;
+	gDevices[0].GetTimeUs = 0;
+	gDevices[0].DelayUs   = 0;
+	
+	m_start = AD779X_VChipTimeUs(&gChips[1]);
+	AD779X_TEST_CHECK(AD779X_BusWait(&gBus, &m_sample, NULL) == AD779X_BUS_NONE);
+	m_time = AD779X_VChipTimeUs(&gChips[1]) - m_start;
+	
+	AD779X_TEST_CHECK(m_time >= m_limit);
+	AD779X_TEST_CHECK(m_time < 2 * m_limit);
+	
+	/* converting devices are served after lost device */
+	for (i = 1; i < AD779X_TEST_DEVICES; i++)
+		AD779X_SetMode(&gDevices[i], mdsContinuous);
+	
+	for (i = 0; i < AD779X_TEST_DEVICES; i++)
+	{
+		m_index = AD779X_BusWait(&gBus, &m_sample, NULL);
+		AD779X_TEST_CHECK((m_index != 0) && (m_index < AD779X_TEST_DEVICES));
+	}
+	
+	/* no active device */
+	for (i = 0; i < AD779X_TEST_DEVICES; i++)
+		gDevices[i].SuState = susNoHW;
+	
+	AD779X_TEST_CHECK(AD779X_BusWait(&gBus, &m_sample, NULL) == AD779X_BUS_NONE);
+	
+	printf("timeout: %s\n", (gFails == m_fails) ? "ok" : "FAIL");
+}
+
+/**
+ * @brief  Group calibration: device without RDY is stopped (Idle) on timeout
+ * @param  None
+ * @return None
+ */
+static void TestCalibration(void)
+{
+	const uint32_t m_limit = 2 * AD779X_SettlingTimeUs(fs500, cssInt) + AD779X_POWER_UP_US;
+	tAD779X_BusCalResult m_results[AD779X_TEST_DEVICES];
+	unsigned int m_fails = gFails;
+	uint32_t m_start, m_time;
+	uint8_t i;
+	
+	/* RDY line of first device is lost: its chip stays in calibration, time of bus is time of lost line */
+	TestInit();
+	gDevices[0].RDYState  = TestLostRDY;
+	gDevices[0].GetTimeUs = TestLostTimeUs;
+	
+	m_start = gLostTime;
+	AD779X_TEST_CHECK(AD779X_BusCalibrate(&gBus, m_results) == AD779X_TEST_DEVICES - 1);
+	m_time = gLostTime - m_start;
+	
+	/* zero-scale step waits for time limit, full-scale step is not started on first device */
+	AD779X_TEST_CHECK(m_time >= m_limit);
+	AD779X_TEST_CHECK(m_time < m_limit + 10);
+	
+	AD779X_TEST_CHECK(m_results[0].Status == bcsTimeout);
+	AD779X_TEST_CHECK(gChips[0].ModeReg.MODE == mdsIdle);
+	AD779X_TEST_CHECK(gDevices[0].ModeReg.MODE == mdsIdle);
+	
+	for (i = 1; i < AD779X_TEST_DEVICES; i++)
+	{
+		AD779X_TEST_CHECK(m_results[i].Status == bcsOk);
+		AD779X_TEST_CHECK(gChips[i].ModeReg.MODE == mdsIdle);
+		AD779X_TEST_CHECK(m_results[i].Cal.Offset == gChips[i].OffsetReg[0]);
+		AD779X_TEST_CHECK(m_results[i].Cal.FScale == gChips[i].FScaleReg[0]);
+	}
+	
+	printf("calibration: %s\n", (gFails == m_fails) ? "ok" : "FAIL");
+}
+
+int main(void)
+{
+	TestThroughput();
+	TestTimeout();
+	TestCalibration();
+	
+	printf("%u failed checks\n", gFails);
+	
+	return (gFails != 0);
+}
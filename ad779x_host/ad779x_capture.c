@@ -0,0 +1,595 @@
+/**
+  ******************************************************************************
+  * @file    ad779x_capture.c
+  * @author  Khusainov Timur
+  * @version 0.0.0.1
+  * @date    16.10.2026
+  * @brief   AD7792/AD7793: long-duration capture file (host side)
+  ******************************************************************************
+  * @attention
+  * <h2><center>&copy; COPYRIGHT 2011 timypik@gmail.com </center></h2>
+  ******************************************************************************
+  */
+
+/* 64-bit file offsets on 32-bit hosts */
+#ifndef _FILE_OFFSET_BITS
+#define _FILE_OFFSET_BITS 64
+#endif
+
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "ad779x_capture.h"
+
+/* Get block of writer window */
+#define AD779X_CAP_AT(pCap, Block) ((tAD779X_CapBlock *)((pCap)->pMap + (size_t)((Block) - (pCap)->MapFirst) * AD779X_CAP_BLOCK))
+
+/**
+ * @brief  Get monotonic time of host
+ * @param  None
+ * @return Time, us
+ */
+static uint64_t AD779X_CapHostUs(void)
+{
+	struct timespec m_ts;
+	
+	clock_gettime(CLOCK_MONOTONIC, &m_ts);
+	
+	return (uint64_t)m_ts.tv_sec * 1000000ULL + (uint64_t)m_ts.tv_nsec / 1000;
+}
+
+/**
+ * @brief  Get first block of mapping window: offset of mapping is multiple of page size
+ * @param  Block - block, that must be in window
+ * @return First block of window
+ */
+static uint64_t AD779X_CapWindow(uint64_t Block)
+{
+	long m_page = sysconf(_SC_PAGESIZE);
+	uint64_t m_align = (m_page > AD779X_CAP_BLOCK) ? (uint64_t)m_page / AD779X_CAP_BLOCK : 1;
+	
+	return Block - Block % m_align;
+}
+
+/**
+ * @brief  Move mapping window of writer: grow file to end of window
+ * @param  pCap - writer
+ * @param  Block - block, that must be in window
+ * @return 0 - ok, -1 - error
+ */
+static int AD779X_CapMap(tAD779X_Capture *pCap, uint64_t Block)
+{
+	uint64_t m_first = AD779X_CapWindow(Block);
+	void *pMap;
+	
+	if (ftruncate(pCap->Fd, (off_t)((m_first + AD779X_CAP_GROW) * AD779X_CAP_BLOCK)) < 0)
+		return -1;
+	
+	/* written pages stay in page cache after munmap */
+	if (pCap->pMap)
+		munmap(pCap->pMap, (size_t)pCap->MapBlocks * AD779X_CAP_BLOCK);
+	
+	pMap = mmap(NULL, (size_t)AD779X_CAP_GROW * AD779X_CAP_BLOCK, PROT_READ | PROT_WRITE, MAP_SHARED, pCap->Fd,
+		(off_t)(m_first * AD779X_CAP_BLOCK));
+	
+	if (pMap == MAP_FAILED)
+	{
+		pCap->pMap = NULL;
+		pCap->MapBlocks = 0;
+		return -1;
+	}
+	
+	pCap->pMap = pMap;
+	pCap->MapFirst = m_first;
+	pCap->MapBlocks = AD779X_CAP_GROW;
+	
+	return 0;
+}
+
+/**
+ * @brief  Fill descriptor of device
+ * @param  pDesc - descriptor
+ * @param  pDevice - ADC device (register images)
+ * @param  pCal - calibration registers of channel (AD779X_ReadCalibration), may be NULL
+ * @return None
+ */
+void AD779X_CapDescribe(tAD779X_CapDevice *pDesc, const tAD779X_Device *pDevice, const tAD779X_CalEntry *pCal)
+{
+	memset(pDesc, 0, sizeof(*pDesc));
+	
+	pDesc->Model    = (uint8_t)AD779X_MODEL(*pDevice);
+	pDesc->Rate     = pDevice->ModeReg.FS;
+	pDesc->Channel  = pDevice->ConfigReg.CHSEL;
+	pDesc->IO       = pDevice->IOReg.DATA;
+	pDesc->Mode     = pDevice->ModeReg.DATA;
+	pDesc->Config   = pDevice->ConfigReg.DATA;
+	pDesc->PeriodUs = AD779X_ConversionTimeUs((tAD779X_FilterSelect)pDevice->ModeReg.FS, (tAD779X_ClkSourceSelect)pDevice->ModeReg.CLKS);
+	
+	if (pCal)
+	{
+		pDesc->Offset = pCal->Offset;
+		pDesc->FScale = pCal->FScale;
+	}
+}
+
+/**
+ * @brief  Create capture file (existing file is truncated)
+ * @param  pCap - writer
+ * @param  pPath - path of file
+ * @param  pDevices - descriptors of devices (AD779X_CapDescribe)
+ * @param  Count - count of devices, 1..AD779X_CAP_DEVICES
+ * @return 0 - ok, -1 - error
+ */
+int AD779X_CapCreate(tAD779X_Capture *pCap, const char *pPath, const tAD779X_CapDevice *pDevices, uint8_t Count)
+{
+	tAD779X_CapHeader *pHeader;
+	
+	memset(pCap, 0, sizeof(*pCap));
+	pCap->Fd = -1;
+	
+	if (!Count || (Count > AD779X_CAP_DEVICES))
+		return -1;
+	
+	pCap->Fd = open(pPath, O_RDWR | O_CREAT | O_TRUNC, 0644);
+	
+	if (pCap->Fd < 0)
+		return -1;
+	
+	if (AD779X_CapMap(pCap, 1) < 0)
+	{
+		close(pCap->Fd);
+		pCap->Fd = -1;
+		return -1;
+	}
+	
+	pHeader = mmap(NULL, AD779X_CAP_BLOCK, PROT_READ | PROT_WRITE, MAP_SHARED, pCap->Fd, 0);
+	
+	if (pHeader == MAP_FAILED)
+	{
+		AD779X_CapClose(pCap);
+		return -1;
+	}
+	
+	pCap->pHeader = pHeader;
+	pCap->SyncBlocks = AD779X_CAP_SYNC_BLOCKS;
+	pCap->Devices = Count;
+	
+	pHeader->Magic     = AD779X_CAP_MAGIC;
+	pHeader->Version   = AD779X_CAP_VERSION;
+	pHeader->Devices   = Count;
+	pHeader->BlockSize = AD779X_CAP_BLOCK;
+	memcpy(pHeader->Device, pDevices, Count * sizeof(tAD779X_CapDevice));
+	
+	return AD779X_CapSync(pCap);
+}
+
+/**
+ * @brief  Append sample record of device
+ * @param  pCap - writer
+ * @param  Device - number of device
+ * @param  pRecord - record (AD779X_ReadSampleRecord)
+ * @return 0 - ok, -1 - error
+ */
+int AD779X_CapWrite(tAD779X_Capture *pCap, uint8_t Device, const tAD779X_SampleRecord *pRecord)
+{
+	tAD779X_CapStream *pStream;
+	tAD779X_CapBlock *pBlock = NULL;
+	uint64_t m_time;
+	
+	if (!pCap->pMap || !pCap->pHeader || (Device >= pCap->Devices))
+		return -1;
+	
+	pStream = &pCap->Streams[Device];
+	
+	/* time: timestamp with count of its wraps */
+	if (pRecord->Flags & AD779X_RECORD_TIMESTAMP)
+	{
+		if (pRecord->Timestamp < pStream->LastStamp)
+			pStream->HighUs += 1ULL << 32;
+		
+		pStream->LastStamp = pRecord->Timestamp;
+		m_time = pStream->HighUs | pRecord->Timestamp;
+	}
+	else
+	{
+		m_time = AD779X_CapHostUs();
+	}
+	
+	/* time of device is not going back */
+	if (m_time < pStream->LastUs)
+		m_time = pStream->LastUs;
+	
+	pStream->LastUs = m_time;
+	
+	/* open block left behind window is closed */
+	if (pStream->Block && (pStream->Block >= pCap->MapFirst))
+		pBlock = AD779X_CAP_AT(pCap, pStream->Block);
+	
+	/* new block: no block, block is full, lost samples, delta of time overflows */
+	if (!pBlock || (pBlock->Count == AD779X_CAP_SAMPLES) ||
+	    (pRecord->Sequence != pStream->NextSequence) || (m_time - pBlock->FirstUs > 0xFFFFFFFFULL))
+	{
+		/* end of window: blocks are synced, window is moved on */
+		if ((pCap->Blocks + 1 >= pCap->MapFirst + pCap->MapBlocks) &&
+		    ((AD779X_CapSync(pCap) < 0) || (AD779X_CapMap(pCap, pCap->Blocks + 1) < 0)))
+			return -1;
+		
+		pStream->Block = ++pCap->Blocks;
+		pBlock = AD779X_CAP_AT(pCap, pStream->Block);
+		
+		pBlock->FirstUs  = m_time;
+		pBlock->Sequence = pRecord->Sequence;
+		pBlock->Device   = Device;
+		
+		/* head of block is written before block is counted */
+		pCap->pHeader->Blocks = pCap->Blocks;
+	}
+	
+	pBlock->Samples[pBlock->Count].DeltaUs = (uint32_t)(m_time - pBlock->FirstUs);
+	pBlock->Samples[pBlock->Count].Data    = (pRecord->Code & 0x00FFFFFFUL) | ((uint32_t)pRecord->Status << 24);
+	pBlock->LastUs = m_time;
+	pBlock->Count++;
+	
+	pStream->NextSequence = pRecord->Sequence + 1;
+	pCap->Samples++;
+	
+	if (pCap->SyncBlocks && (pCap->Blocks - pCap->SyncedBlocks >= pCap->SyncBlocks))
+		return AD779X_CapSync(pCap);
+	
+	return 0;
+}
+
+/**
+ * @brief  Write mapping to file (msync): header and blocks changed from last call
+ * @param  pCap - writer
+ * @return 0 - ok, -1 - error
+ */
+int AD779X_CapSync(tAD779X_Capture *pCap)
+{
+	size_t m_page = (size_t)sysconf(_SC_PAGESIZE);
+	uint64_t m_first = pCap->SyncedBlocks + 1;
+	size_t m_start, m_end;
+	uint8_t i;
+	int m_result;
+	
+	if (!pCap->pMap || !pCap->pHeader)
+		return -1;
+	
+	pCap->pHeader->Samples = pCap->Samples;
+	
+	/* open blocks may be older than last msync */
+	for (i = 0; i < pCap->Devices; i++)
+	{
+		if (pCap->Streams[i].Block && (pCap->Streams[i].Block < m_first))
+			m_first = pCap->Streams[i].Block;
+	}
+	
+	/* blocks behind window were synced before window was moved */
+	if (m_first < pCap->MapFirst)
+		m_first = pCap->MapFirst;
+	
+	m_start = ((size_t)(m_first - pCap->MapFirst) * AD779X_CAP_BLOCK) / m_page * m_page;
+	m_end = (size_t)(pCap->Blocks + 1 - pCap->MapFirst) * AD779X_CAP_BLOCK;
+	
+	m_result = msync(pCap->pHeader, AD779X_CAP_BLOCK, MS_SYNC);
+	
+	if ((m_result == 0) && (m_end > m_start))
+		m_result = msync(pCap->pMap + m_start, m_end - m_start, MS_SYNC);
+	
+	pCap->SyncedBlocks = pCap->Blocks;
+	pCap->Syncs++;
+	
+	return m_result;
+}
+
+/**
+ * @brief  Close capture file: msync, cut unused blocks
+ * @param  pCap - writer
+ * @return 0 - ok, -1 - error
+ */
+int AD779X_CapClose(tAD779X_Capture *pCap)
+{
+	int m_result = AD779X_CapSync(pCap);
+	
+	if (pCap->pMap)
+		munmap(pCap->pMap, (size_t)pCap->MapBlocks * AD779X_CAP_BLOCK);
+	
+	if (pCap->pHeader)
+		munmap(pCap->pHeader, AD779X_CAP_BLOCK);
+	
+	if (pCap->Fd >= 0)
+	{
+		if (ftruncate(pCap->Fd, (off_t)(pCap->Blocks + 1) * AD779X_CAP_BLOCK) < 0)
+			m_result = -1;
+		
+		close(pCap->Fd);
+	}
+	
+	pCap->pHeader = NULL;
+	pCap->pMap = NULL;
+	pCap->MapBlocks = 0;
+	pCap->Fd = -1;
+	
+	return m_result;
+}
+
+/**
+ * @brief  Get block of reader: window of AD779X_CAP_GROW blocks around block
+ *         is mapped, if block is not in mapped window
+ * @param  pReader - reader
+ * @param  Block - number of file block, 1..Blocks
+ * @return Block in mapping (valid until window is moved), NULL - error
+ */
+static const tAD779X_CapBlock *AD779X_CapRead(tAD779X_CapReader *pReader, uint64_t Block)
+{
+	uint64_t m_first, m_blocks;
+	void *pMap;
+	
+	if ((Block < pReader->MapFirst) || (Block >= pReader->MapFirst + pReader->MapBlocks))
+	{
+		if (pReader->pMap)
+			munmap((void *)pReader->pMap, (size_t)pReader->MapBlocks * AD779X_CAP_BLOCK);
+		
+		pReader->pMap = NULL;
+		pReader->MapBlocks = 0;
+		
+		m_first = AD779X_CapWindow(Block);
+		m_blocks = pReader->FileBlocks - m_first;
+		
+		if (m_blocks > AD779X_CAP_GROW)
+			m_blocks = AD779X_CAP_GROW;
+		
+		pMap = mmap(NULL, (size_t)m_blocks * AD779X_CAP_BLOCK, PROT_READ, MAP_SHARED, pReader->Fd,
+			(off_t)(m_first * AD779X_CAP_BLOCK));
+		
+		if (pMap == MAP_FAILED)
+			return NULL;
+		
+		pReader->pMap = pMap;
+		pReader->MapFirst = m_first;
+		pReader->MapBlocks = m_blocks;
+	}
+	
+	return (const tAD779X_CapBlock *)(pReader->pMap + (size_t)(Block - pReader->MapFirst) * AD779X_CAP_BLOCK);
+}
+
+/**
+ * @brief  Open capture file for read: read header, make index of blocks of
+ *         devices (file being written is read as it was at open)
+ * @param  pReader - reader
+ * @param  pPath - path of file
+ * @return 0 - ok, -1 - error
+ */
+int AD779X_CapOpen(tAD779X_CapReader *pReader, const char *pPath)
+{
+	const tAD779X_CapBlock *pBlock;
+	size_t m_fill[AD779X_CAP_DEVICES];
+	struct stat m_stat;
+	uint64_t i;
+	uint8_t d;
+	
+	memset(pReader, 0, sizeof(*pReader));
+	pReader->Fd = open(pPath, O_RDONLY);
+	
+	if (pReader->Fd < 0)
+		return -1;
+	
+	if ((fstat(pReader->Fd, &m_stat) < 0) || (m_stat.st_size < AD779X_CAP_BLOCK) ||
+	    (pread(pReader->Fd, &pReader->Header, sizeof(pReader->Header), 0) != (ssize_t)sizeof(pReader->Header)))
+	{
+		AD779X_CapFree(pReader);
+		return -1;
+	}
+	
+	pReader->FileBlocks = (uint64_t)m_stat.st_size / AD779X_CAP_BLOCK;
+	
+	if ((pReader->Header.Magic != AD779X_CAP_MAGIC) || (pReader->Header.Version != AD779X_CAP_VERSION) ||
+	    (pReader->Header.BlockSize != AD779X_CAP_BLOCK) || (pReader->Header.Devices > AD779X_CAP_DEVICES))
+	{
+		AD779X_CapFree(pReader);
+		return -1;
+	}
+	
+	/* blocks of header, that are in file */
+	pReader->Blocks = pReader->Header.Blocks;
+	
+	if (pReader->Blocks > pReader->FileBlocks - 1)
+		pReader->Blocks = pReader->FileBlocks - 1;
+	
+	pReader->pIndex = malloc((size_t)(pReader->Blocks + 1) * sizeof(uint32_t));
+	
+	if (!pReader->pIndex)
+	{
+		AD779X_CapFree(pReader);
+		return -1;
+	}
+	
+	/* count blocks of each device, then put block numbers in groups */
+	for (i = 1; i <= pReader->Blocks; i++)
+	{
+		if ((pBlock = AD779X_CapRead(pReader, i)) == NULL)
+		{
+			AD779X_CapFree(pReader);
+			return -1;
+		}
+		
+		if (pBlock->Device < pReader->Header.Devices)
+			pReader->First[pBlock->Device + 1]++;
+	}
+	
+	for (d = 0; d < AD779X_CAP_DEVICES; d++)
+	{
+		pReader->First[d + 1] += pReader->First[d];
+		m_fill[d] = pReader->First[d];
+	}
+	
+	for (i = 1; i <= pReader->Blocks; i++)
+	{
+		if ((pBlock = AD779X_CapRead(pReader, i)) == NULL)
+		{
+			AD779X_CapFree(pReader);
+			return -1;
+		}
+		
+		if (pBlock->Device < pReader->Header.Devices)
+			pReader->pIndex[m_fill[pBlock->Device]++] = (uint32_t)i;
+	}
+	
+	return 0;
+}
+
+/**
+ * @brief  Close capture file of reader
+ * @param  pReader - reader
+ * @return None
+ */
+void AD779X_CapFree(tAD779X_CapReader *pReader)
+{
+	free(pReader->pIndex);
+	
+	if (pReader->pMap)
+		munmap((void *)pReader->pMap, (size_t)pReader->MapBlocks * AD779X_CAP_BLOCK);
+	
+	if (pReader->Fd >= 0)
+		close(pReader->Fd);
+	
+	memset(pReader, 0, sizeof(*pReader));
+	pReader->Fd = -1;
+}
+
+/**
+ * @brief  Get count of blocks of device
+ * @param  pReader - reader
+ * @param  Device - number of device
+ * @return Count of blocks
+ */
+size_t AD779X_CapBlocks(const tAD779X_CapReader *pReader, uint8_t Device)
+{
+	if (Device >= AD779X_CAP_DEVICES)
+		return 0;
+	
+	return pReader->First[Device + 1] - pReader->First[Device];
+}
+
+/**
+ * @brief  Get block of device
+ * @param  pReader - reader
+ * @param  Device - number of device
+ * @param  Index - index of block, 0..AD779X_CapBlocks() - 1 (in order of time)
+ * @return Block in mapping (valid until next call of reader), NULL - no block
+ */
+const tAD779X_CapBlock *AD779X_CapBlockAt(tAD779X_CapReader *pReader, uint8_t Device, size_t Index)
+{
+	if (Index >= AD779X_CapBlocks(pReader, Device))
+		return NULL;
+	
+	return AD779X_CapRead(pReader, pReader->pIndex[pReader->First[Device] + Index]);
+}
+
+/**
+ * @brief  Get first sample of block not earlier than time
+ * @param  pBlock - block
+ * @param  Count - count of samples of block
+ * @param  TimeUs - time, us
+ * @return Index of sample, Count - all samples are earlier
+ */
+static uint16_t AD779X_CapLowerBound(const tAD779X_CapBlock *pBlock, uint16_t Count, uint64_t TimeUs)
+{
+	uint16_t m_low = 0, m_high = Count, m_mid;
+	
+	while (m_low < m_high)
+	{
+		m_mid = (uint16_t)((m_low + m_high) / 2);
+		
+		if (pBlock->FirstUs + pBlock->Samples[m_mid].DeltaUs < TimeUs)
+			m_low = m_mid + 1;
+		else
+			m_high = m_mid;
+	}
+	
+	return m_low;
+}
+
+/**
+ * @brief  Start iteration of time range of device: find first block by binary search
+ * @param  pReader - reader
+ * @param  pCursor - iterator
+ * @param  Device - number of device
+ * @param  FromUs - range start, us
+ * @param  ToUs - range end (inclusive), us
+ * @return None
+ */
+void AD779X_CapSeek(tAD779X_CapReader *pReader, tAD779X_CapCursor *pCursor, uint8_t Device, uint64_t FromUs, uint64_t ToUs)
+{
+	const tAD779X_CapBlock *pBlock;
+	size_t m_low = 0, m_high = AD779X_CapBlocks(pReader, Device), m_mid;
+	
+	/* first block, that ends not earlier than range start */
+	while (m_low < m_high)
+	{
+		m_mid = (m_low + m_high) / 2;
+		
+		/* block is not mapped: range is empty */
+		if ((pBlock = AD779X_CapBlockAt(pReader, Device, m_mid)) == NULL)
+		{
+			m_low = AD779X_CapBlocks(pReader, Device);
+			break;
+		}
+		
+		if (pBlock->LastUs < FromUs)
+			m_low = m_mid + 1;
+		else
+			m_high = m_mid;
+	}
+	
+	pCursor->Device = Device;
+	pCursor->Index  = m_low;
+	pCursor->FromUs = FromUs;
+	pCursor->ToUs   = ToUs;
+}
+
+/**
+ * @brief  Get next samples of time range
+ * @param  pReader - reader
+ * @param  pCursor - iterator (AD779X_CapSeek)
+ * @param  pSpan - samples of one block in range
+ * @return 1 - span is got, 0 - end of range
+ */
+uint8_t AD779X_CapNext(tAD779X_CapReader *pReader, tAD779X_CapCursor *pCursor, tAD779X_CapSpan *pSpan)
+{
+	const tAD779X_CapBlock *pBlock;
+	uint16_t m_count, m_first, m_end;
+	
+	while ((pBlock = AD779X_CapBlockAt(pReader, pCursor->Device, pCursor->Index)) != NULL)
+	{
+		/* count may grow, if file is being written */
+		m_count = pBlock->Count;
+		
+		if (m_count > AD779X_CAP_SAMPLES)
+			m_count = AD779X_CAP_SAMPLES;
+		
+		if (pBlock->FirstUs > pCursor->ToUs)
+			return 0;
+		
+		pCursor->Index++;
+		
+		m_first = AD779X_CapLowerBound(pBlock, m_count, pCursor->FromUs);
+		m_end = (pCursor->ToUs == UINT64_MAX) ? m_count : AD779X_CapLowerBound(pBlock, m_count, pCursor->ToUs + 1);
+		
+		if (m_end > m_first)
+		{
+			pSpan->pBlock = pBlock;
+			pSpan->First  = m_first;
+			pSpan->Count  = (uint16_t)(m_end - m_first);
+			
+			return 1;
+		}
+	}
+	
+	return 0;
+}
@@ -0,0 +1,216 @@
+/**
+  ******************************************************************************
+  * @file    ad779x_capture.h
+  * @author  Khusainov Timur
+  * @version 0.0.0.1
+  * @date    16.10.2026
+  * @brief   AD7792/AD7793: long-duration capture file (host side)
+  ******************************************************************************
+  * @attention
+  * <h2><center>&copy; COPYRIGHT 2011 timypik@gmail.com </center></h2>
+  ******************************************************************************
+  *
+  * File is array of AD779X_CAP_BLOCK bytes blocks, host byte order: block 0 is
+  * header (tAD779X_CapHeader) with descriptor of each device, next blocks are
+  * sample blocks (tAD779X_CapBlock). Block belongs to one device, its samples
+  * have contiguous numbers (tAD779X_SampleRecord.Sequence) and rising time.
+  * Blocks are appended in order of first sample, blocks of device are in order
+  * of time.
+  *
+  * File is not mapped whole (32-bit hosts have no address space for it):
+  * writer maps header and window of AD779X_CAP_GROW tail blocks, file is grown
+  * and window is moved on by AD779X_CAP_GROW blocks; samples are stored to
+  * mapping, msync is called each SyncBlocks new blocks and before window is
+  * moved. Open block of device left behind window is closed, next sample of
+  * device starts new block. Reader maps window of AD779X_CAP_GROW blocks
+  * around requested block and finds blocks of time range by binary search;
+  * samples are used in mapping without copy. File offsets are 64-bit
+  * (_FILE_OFFSET_BITS 64 in ad779x_capture.c).
+  *
+  * Time of sample is device time (GetTimeUs), extended to 64 bits: 32-bit
+  * timestamp wraps in 71 minutes. Records without timestamp
+  * (AD779X_RECORD_TIMESTAMP flag is not set) get host time.
+  */
+
+#ifndef AD779X_CAPTURE_H
+#define AD779X_CAPTURE_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "ad779x.h"
+
+#define AD779X_CAP_MAGIC   0x4B393741UL /*!< "A79K" */
+#define AD779X_CAP_VERSION 1
+
+/**
+ * @brief Size of block (header and sample blocks), bytes
+ */
+#define AD779X_CAP_BLOCK 4096
+
+/**
+ * @brief Max count of devices of file
+ */
+#define AD779X_CAP_DEVICES 32
+
+/**
+ * @brief Count of samples of block
+ */
+#define AD779X_CAP_SAMPLES ((AD779X_CAP_BLOCK - 32) / 8)
+
+/**
+ * @brief File is grown and mapping window is moved by this count of blocks
+ *        (blocks of window; at least page size / AD779X_CAP_BLOCK)
+ */
+#ifndef AD779X_CAP_GROW
+#define AD779X_CAP_GROW 256
+#endif
+
+/**
+ * @brief Default count of new blocks between msync calls
+ */
+#ifndef AD779X_CAP_SYNC_BLOCKS
+#define AD779X_CAP_SYNC_BLOCKS 64
+#endif
+
+/**
+ * @brief Descriptor of device: state at start of capture (32 bytes)
+ */
+typedef struct
+{
+	uint8_t  Model;     /*!< tAD779X_Model */
+	uint8_t  Rate;      /*!< tAD779X_FilterSelect */
+	uint8_t  Channel;   /*!< tAD779X_ChSelect */
+	uint8_t  IO;        /*!< IO register */
+	uint16_t Mode;      /*!< MODE register */
+	uint16_t Config;    /*!< CONFIG register */
+	uint32_t PeriodUs;  /*!< conversion period, us */
+	uint32_t Offset;    /*!< OFFSET register of channel (0 - not known) */
+	uint32_t FScale;    /*!< FULL-SCALE register of channel (0 - not known) */
+	uint32_t Reserved[3];
+} tAD779X_CapDevice;
+
+/**
+ * @brief Header of file (block 0)
+ */
+typedef struct
+{
+	uint32_t Magic;      /*!< AD779X_CAP_MAGIC, other value - not a file or other byte order */
+	uint16_t Version;    /*!< AD779X_CAP_VERSION */
+	uint16_t Devices;    /*!< count of devices */
+	uint32_t BlockSize;  /*!< AD779X_CAP_BLOCK */
+	uint32_t Reserved;
+	uint64_t Blocks;     /*!< count of sample blocks */
+	uint64_t Samples;    /*!< count of samples (updated by msync and close) */
+	tAD779X_CapDevice Device[AD779X_CAP_DEVICES]; /*!< descriptors of devices */
+} tAD779X_CapHeader;
+
+/**
+ * @brief Sample of block (8 bytes)
+ */
+typedef struct
+{
+	uint32_t DeltaUs;  /*!< time from first sample of block, us */
+	uint32_t Data;     /*!< Code (bits 0..23), STATUS register (bits 24..31) */
+} tAD779X_CapSample;
+
+#define AD779X_CAP_CODE(Sample)   ((Sample).Data & 0x00FFFFFFUL)
+#define AD779X_CAP_STATUS(Sample) ((uint8_t)((Sample).Data >> 24))
+
+/**
+ * @brief Sample block
+ */
+typedef struct
+{
+	uint64_t FirstUs;   /*!< time of first sample, us */
+	uint64_t LastUs;    /*!< time of last sample, us */
+	uint32_t Sequence;  /*!< number of first sample */
+	uint16_t Count;     /*!< count of samples */
+	uint8_t  Device;    /*!< number of device (index of tAD779X_CapHeader.Device) */
+	uint8_t  Reserved[5];
+	tAD779X_CapSample Samples[AD779X_CAP_SAMPLES];
+} tAD779X_CapBlock;
+
+/**
+ * @brief Writer state of device
+ */
+typedef struct
+{
+	uint64_t Block;         /*!< open block (number of file block, 1..), 0 - none */
+	uint64_t HighUs;        /*!< high part of time (wraps of timestamp) */
+	uint64_t LastUs;        /*!< time of last sample, us */
+	uint32_t LastStamp;     /*!< last timestamp */
+	uint32_t NextSequence;  /*!< number of next sample in open block */
+} tAD779X_CapStream;
+
+/**
+ * @brief Writer
+ */
+typedef struct
+{
+	int Fd;                                       /*!< file */
+	tAD779X_CapHeader *pHeader;                   /*!< mapping of header (block 0) */
+	uint8_t *pMap;                                /*!< mapping window of tail blocks */
+	uint64_t MapFirst;                            /*!< first block of window */
+	uint64_t MapBlocks;                           /*!< blocks of window (file ends with window) */
+	uint64_t Blocks;                              /*!< count of sample blocks */
+	uint64_t Samples;                             /*!< count of samples */
+	uint64_t SyncedBlocks;                        /*!< value of Blocks at last msync */
+	uint32_t SyncBlocks;                          /*!< new blocks between msync calls, 0 - only AD779X_CapSync */
+	uint32_t Syncs;                               /*!< count of msync calls */
+	uint8_t Devices;                              /*!< count of devices */
+	tAD779X_CapStream Streams[AD779X_CAP_DEVICES]; /*!< state of each device */
+} tAD779X_Capture;
+
+/**
+ * @brief Reader
+ */
+typedef struct
+{
+	int Fd;                                       /*!< file */
+	const uint8_t *pMap;                          /*!< mapping window of blocks */
+	uint64_t MapFirst;                            /*!< first block of window */
+	uint64_t MapBlocks;                           /*!< blocks of window */
+	uint64_t FileBlocks;                          /*!< blocks of file (at open, with header) */
+	tAD779X_CapHeader Header;                     /*!< header of file (at open) */
+	uint64_t Blocks;                              /*!< count of sample blocks (at open) */
+	uint32_t *pIndex;                             /*!< block numbers, grouped by device */
+	size_t First[AD779X_CAP_DEVICES + 1];         /*!< first index of each device in pIndex */
+} tAD779X_CapReader;
+
+/**
+ * @brief Samples of block in time range: Samples[First..First+Count-1] of pBlock
+ *        (pBlock is valid until next call of reader)
+ */
+typedef struct
+{
+	const tAD779X_CapBlock *pBlock;
+	uint16_t First;
+	uint16_t Count;
+} tAD779X_CapSpan;
+
+/**
+ * @brief Iterator of time range of device
+ */
+typedef struct
+{
+	uint8_t Device;  /*!< number of device */
+	size_t Index;    /*!< next block (index of device blocks) */
+	uint64_t FromUs; /*!< range start, us */
+	uint64_t ToUs;   /*!< range end (inclusive), us */
+} tAD779X_CapCursor;
+
+void AD779X_CapDescribe(tAD779X_CapDevice *pDesc, const tAD779X_Device *pDevice, const tAD779X_CalEntry *pCal);
+int AD779X_CapCreate(tAD779X_Capture *pCap, const char *pPath, const tAD779X_CapDevice *pDevices, uint8_t Count);
+int AD779X_CapWrite(tAD779X_Capture *pCap, uint8_t Device, const tAD779X_SampleRecord *pRecord);
+int AD779X_CapSync(tAD779X_Capture *pCap);
+int AD779X_CapClose(tAD779X_Capture *pCap);
+
+int AD779X_CapOpen(tAD779X_CapReader *pReader, const char *pPath);
+void AD779X_CapFree(tAD779X_CapReader *pReader);
+size_t AD779X_CapBlocks(const tAD779X_CapReader *pReader, uint8_t Device);
+const tAD779X_CapBlock *AD779X_CapBlockAt(tAD779X_CapReader *pReader, uint8_t Device, size_t Index);
+void AD779X_CapSeek(tAD779X_CapReader *pReader, tAD779X_CapCursor *pCursor, uint8_t Device, uint64_t FromUs, uint64_t ToUs);
+uint8_t AD779X_CapNext(tAD779X_CapReader *pReader, tAD779X_CapCursor *pCursor, tAD779X_CapSpan *pSpan);
+
+#endif
@@ -0,0 +1,418 @@
+/**
+  ******************************************************************************
+  * @file    ad779x_capture_test.c
+  * @author  Khusainov Timur
+  * @version 0.0.0.1
+  * @date    16.10.2026
+  * @brief   AD7792/AD7793: test of long-duration capture file (writer and reader)
+  ******************************************************************************
+  * @attention
+  * <h2><center>&copy; COPYRIGHT 2011 timypik@gmail.com </center></h2>
+  ******************************************************************************
+  *
+  * Build for each variant of driver, e.g.:
+  *   cc -O2 -I../ad779x_single ad779x_capture_test.c ad779x_capture.c ../ad779x_single/ad779x.c -o ad779x_capture_test_single
+  *   cc -O2 -I../ad779x_multiple ad779x_capture_test.c ad779x_capture.c ../ad779x_multiple/ad779x.c -o ad779x_capture_test_multiple
+  *
+  * About 1.8M samples of 3 devices of different rates are written in order of
+  * time: file is many mapping windows long, 32-bit timestamp of each device
+  * wraps, sequence of each device has gaps (lost samples), one device pauses
+  * until its open block is left behind window. File is read while written
+  * (after AD779X_CapSync) and after close: all samples, times and numbers must
+  * be same, counts of samples of time ranges must be exact.
+  * Exit code is count of failed checks.
+  */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "ad779x_capture.h"
+
+/* Count of devices of file */
+#define AD779X_TEST_DEVICES 3
+
+/* Count of samples of each device */
+#define AD779X_TEST_SAMPLES 600000UL
+
+/* Lost samples: gap of sequence each AD779X_TEST_GAP_EVERY samples */
+#define AD779X_TEST_GAP_EVERY 100003UL
+#define AD779X_TEST_GAP_SIZE  5
+
+/* Pause of last device: at this sample, longer than AD779X_CAP_GROW blocks of other devices */
+#define AD779X_TEST_PAUSE_AT 50000UL
+#define AD779X_TEST_PAUSE_US 300000000ULL
+
+/* Count of random time ranges */
+#define AD779X_TEST_RANGES 500
+
+#if defined(AD779X_VARIANT_SINGLE)
+tAD779X_Device ADCDevice;
+#define AD779X_TEST_VARIANT "single"
+#else
+#define AD779X_TEST_VARIANT "multiple"
+#endif
+
+/**
+ * @brief  Written sample of device
+ */
+typedef struct
+{
+	uint64_t TimeUs;   /*!< time (timestamp with its wraps), us */
+	uint32_t Sequence; /*!< number of sample */
+	uint32_t Code;     /*!< data sample value */
+} tAD779X_TestSample;
+
+/* Rate and first timestamp of each device: devices run together, each timestamp wraps */
+static const uint8_t gRates[AD779X_TEST_DEVICES] = {fs500, fs250, fs152};
+static const uint32_t gStarts[AD779X_TEST_DEVICES] = {0xF0000000UL, 0xE8000000UL, 0xE0000000UL};
+
+/* Written samples of each device */
+static tAD779X_TestSample *gSamples[AD779X_TEST_DEVICES];
+
+/* Count of failed checks */
+static unsigned int gFails;
+
+#define AD779X_TEST_CHECK(Cond) TestCheck((Cond), #Cond, __LINE__)
+
+/**
+ * @brief  Count and print failed check
+ * @param  Cond - result of check
+ * @param  pText - text of check
+ * @param  Line - line of check
+ * @return None
+ */
+static void TestCheck(int Cond, const char *pText, int Line)
+{
+	if (Cond)
+		return;
+	
+	gFails++;
+	printf("  FAIL line %d: %s\n", Line, pText);
+}
+
+/**
+ * @brief  Make written samples of each device
+ * @param  None
+ * @return None
+ */
+static void TestMake(void)
+{
+	unsigned long n;
+	uint64_t m_time;
+	uint32_t m_sequence, m_period;
+	uint8_t d;
+	
+	for (d = 0; d < AD779X_TEST_DEVICES; d++)
+	{
+		m_time = gStarts[d];
+		m_sequence = 0;
+		m_period = AD779X_ConversionTimeUs((tAD779X_FilterSelect)gRates[d], cssInt);
+		
+		for (n = 0; n < AD779X_TEST_SAMPLES; n++)
+		{
+			if (n && !(n % AD779X_TEST_GAP_EVERY))
+			{
+				m_sequence += AD779X_TEST_GAP_SIZE;
+				m_time += AD779X_TEST_GAP_SIZE * m_period;
+			}
+			
+			if ((d == AD779X_TEST_DEVICES - 1) && (n == AD779X_TEST_PAUSE_AT))
+				m_time += AD779X_TEST_PAUSE_US;
+			
+			gSamples[d][n].TimeUs = m_time;
+			gSamples[d][n].Sequence = m_sequence++;
+			gSamples[d][n].Code = (uint32_t)((n * 2654435761UL) ^ d) & 0x00FFFFFFUL;
+			
+			m_time += m_period;
+		}
+	}
+}
+
+/**
+ * @brief  Get count of written samples of time range
+ * @param  Device - number of device
+ * @param  Count - count of written samples of device
+ * @param  FromUs - range start, us
+ * @param  ToUs - range end (inclusive), us
+ * @return Count of samples
+ */
+static unsigned long TestRangeCount(uint8_t Device, unsigned long Count, uint64_t FromUs, uint64_t ToUs)
+{
+	unsigned long m_low, m_high, m_mid, m_from;
+	
+	/* first sample not earlier than range start, then first sample later than range end */
+	for (m_low = 0, m_high = Count; m_low < m_high;)
+	{
+		m_mid = (m_low + m_high) / 2;
+		
+		if (gSamples[Device][m_mid].TimeUs < FromUs)
+			m_low = m_mid + 1;
+		else
+			m_high = m_mid;
+	}
+	
+	for (m_from = m_low, m_high = Count; m_low < m_high;)
+	{
+		m_mid = (m_low + m_high) / 2;
+		
+		if (gSamples[Device][m_mid].TimeUs <= ToUs)
+			m_low = m_mid + 1;
+		else
+			m_high = m_mid;
+	}
+	
+	return m_low - m_from;
+}
+
+/**
+ * @brief  Read file and compare with written samples
+ * @param  pPath - path of file
+ * @param  pWritten - count of written samples of each device
+ * @return None
+ */
+static void TestRead(const char *pPath, const unsigned long *pWritten)
+{
+	const tAD779X_TestSample *pSample;
+	const tAD779X_CapSample *pRead;
+	const tAD779X_CapBlock *pBlock;
+	tAD779X_CapReader m_reader;
+	tAD779X_CapCursor m_cursor;
+	tAD779X_CapSpan m_span;
+	unsigned long m_count, m_total = 0, m_wrong;
+	uint64_t m_from, m_to, m_random = 12345;
+	unsigned int i, r;
+	size_t b;
+	uint8_t d;
+	
+	AD779X_TEST_CHECK(AD779X_CapOpen(&m_reader, pPath) == 0);
+	
+	if (m_reader.Fd < 0)
+		return;
+	
+	AD779X_TEST_CHECK(m_reader.Header.Devices == AD779X_TEST_DEVICES);
+	
+	for (d = 0; d < AD779X_TEST_DEVICES; d++)
+	{
+		AD779X_TEST_CHECK(m_reader.Header.Device[d].Rate == gRates[d]);
+		
+		/* all samples in order: time, code, status, number of sample in block */
+		AD779X_CapSeek(&m_reader, &m_cursor, d, 0, UINT64_MAX);
+		
+		for (m_count = 0, m_wrong = 0; AD779X_CapNext(&m_reader, &m_cursor, &m_span);)
+		{
+			AD779X_TEST_CHECK(m_span.pBlock->Device == d);
+			
+			for (i = 0; (i < m_span.Count) && (m_count < pWritten[d]); i++, m_count++)
+			{
+				pSample = &gSamples[d][m_count];
+				pRead = &m_span.pBlock->Samples[m_span.First + i];
+				
+				if ((m_span.pBlock->FirstUs + pRead->DeltaUs != pSample->TimeUs) ||
+				    (m_span.pBlock->Sequence + m_span.First + i != pSample->Sequence) ||
+				    (AD779X_CAP_CODE(*pRead) != pSample->Code) || (AD779X_CAP_STATUS(*pRead) != d))
+					m_wrong++;
+			}
+		}
+		
+		AD779X_TEST_CHECK(m_count == pWritten[d]);
+		AD779X_TEST_CHECK(m_wrong == 0);
+		m_total += m_count;
+		
+		/* blocks: in order of time, sequence gap starts new block */
+		for (b = 0, m_wrong = 0; (pBlock = AD779X_CapBlockAt(&m_reader, d, b)) != NULL; b++)
+		{
+			if ((pBlock->Count == 0) || (pBlock->LastUs < pBlock->FirstUs) ||
+			    (pBlock->FirstUs + pBlock->Samples[pBlock->Count - 1].DeltaUs != pBlock->LastUs))
+				m_wrong++;
+		}
+		
+		AD779X_TEST_CHECK(b == AD779X_CapBlocks(&m_reader, d));
+		AD779X_TEST_CHECK(m_wrong == 0);
+		
+		/* random ranges: about one block, about one window, across timestamp wrap, outside of samples */
+		for (r = 0; (r < AD779X_TEST_RANGES) && pWritten[d]; r++)
+		{
+			m_random = m_random * 6364136223846793005ULL + 1442695040888963407ULL;
+			m_from = gSamples[d][0].TimeUs - 1000000ULL + (m_random >> 11) % (gSamples[d][pWritten[d] - 1].TimeUs - gSamples[d][0].TimeUs + 2000000ULL);
+			
+			switch (r % 4)
+			{
+				case 0: m_to = m_from + 1000000ULL; break;
+				case 1: m_to = m_from + 400000000ULL; break;
+				case 2: m_from = 0x100000000ULL - (m_random >> 40); m_to = 0x100000000ULL + (m_random >> 40); break;
+				default: m_to = m_from; break;
+			}
+			
+			AD779X_CapSeek(&m_reader, &m_cursor, d, m_from, m_to);
+			
+			for (m_count = 0; AD779X_CapNext(&m_reader, &m_cursor, &m_span);)
+				m_count += m_span.Count;
+			
+			AD779X_TEST_CHECK(m_count == TestRangeCount(d, pWritten[d], m_from, m_to));
+		}
+	}
+	
+	AD779X_TEST_CHECK(m_reader.Header.Samples == m_total);
+	AD779X_TEST_CHECK(m_reader.Blocks == m_reader.Header.Blocks);
+	
+	AD779X_CapFree(&m_reader);
+}
+
+int main(void)
+{
+	char m_path[] = "/tmp/ad779x_capture_XXXXXX";
+	tAD779X_CapDevice m_desc[AD779X_TEST_DEVICES];
+	unsigned long m_written[AD779X_TEST_DEVICES] = {0};
+	unsigned long m_blocks[AD779X_TEST_DEVICES] = {0};
+	unsigned long m_fill[AD779X_TEST_DEVICES] = {0};
+	uint8_t m_closed[AD779X_TEST_DEVICES] = {0}, m_paused = 0;
+	unsigned long m_total = 0, m_wrong = 0;
+	const tAD779X_TestSample *pSample;
+	tAD779X_SampleRecord m_record;
+	tAD779X_CapReader m_reader;
+	tAD779X_Device m_device;
+	tAD779X_Capture m_cap;
+	uint64_t m_windows = 0, m_map_first = 0, m_block;
+	uint8_t d, m_next, m_new;
+	int m_fd;
+	
+	printf("capture file test, driver variant: %s\n", AD779X_TEST_VARIANT);
+	
+	for (d = 0; d < AD779X_TEST_DEVICES; d++)
+	{
+		gSamples[d] = malloc(AD779X_TEST_SAMPLES * sizeof(tAD779X_TestSample));
+		
+		if (!gSamples[d])
+			return 1;
+		
+		memset(&m_device, 0, sizeof(m_device));
+		m_device.Model = ad7793;
+		m_device.ModeReg.FS = gRates[d];
+		m_device.ConfigReg.CHSEL = chsAIN1;
+		AD779X_CapDescribe(&m_desc[d], &m_device, NULL);
+	}
+	
+	TestMake();
+	
+	m_fd = mkstemp(m_path);
+	AD779X_TEST_CHECK(m_fd >= 0);
+	
+	if (m_fd < 0)
+		return 1;
+	
+	close(m_fd);
+	AD779X_TEST_CHECK(AD779X_CapCreate(&m_cap, m_path, m_desc, AD779X_TEST_DEVICES) == 0);
+	
+	/* samples of devices in order of time */
+	memset(&m_record, 0, sizeof(m_record));
+	m_record.Flags = AD779X_RECORD_TIMESTAMP;
+	
+	while (m_total < AD779X_TEST_DEVICES * AD779X_TEST_SAMPLES)
+	{
+		for (m_next = AD779X_TEST_DEVICES, d = 0; d < AD779X_TEST_DEVICES; d++)
+		{
+			if ((m_written[d] < AD779X_TEST_SAMPLES) && ((m_next == AD779X_TEST_DEVICES) ||
+			    (gSamples[d][m_written[d]].TimeUs < gSamples[m_next][m_written[m_next]].TimeUs)))
+				m_next = d;
+		}
+		
+		pSample = &gSamples[m_next][m_written[m_next]];
+		m_record.Code = pSample->Code;
+		m_record.Timestamp = (uint32_t)pSample->TimeUs;
+		m_record.Sequence = pSample->Sequence;
+		m_record.Status = m_next;
+		
+		/* new block: first sample, block is full, lost samples, open block is left behind window */
+		m_new = !m_written[m_next] || (m_fill[m_next] == AD779X_CAP_SAMPLES) ||
+		        (pSample->Sequence != pSample[-1].Sequence + 1) || m_closed[m_next];
+		
+		/* pause of device: other devices have moved window on */
+		if ((m_next == AD779X_TEST_DEVICES - 1) && (m_written[m_next] == AD779X_TEST_PAUSE_AT))
+		{
+			AD779X_TEST_CHECK(m_closed[m_next]);
+			m_paused = 1;
+		}
+		
+		m_block = m_cap.Streams[m_next].Block;
+		
+		if (AD779X_CapWrite(&m_cap, m_next, &m_record) < 0)
+		{
+			AD779X_TEST_CHECK(0);
+			break;
+		}
+		
+		/* new block is last block of file, else sample is in open block */
+		if (m_new ? (m_cap.Streams[m_next].Block != m_cap.Blocks) : (m_cap.Streams[m_next].Block != m_block))
+			m_wrong++;
+		
+		if (m_new)
+		{
+			m_blocks[m_next]++;
+			m_fill[m_next] = 0;
+			m_closed[m_next] = 0;
+		}
+		
+		m_fill[m_next]++;
+		
+		if (m_cap.MapFirst != m_map_first)
+		{
+			m_map_first = m_cap.MapFirst;
+			m_windows++;
+			
+			/* blocks behind window are synced before window is moved */
+			AD779X_TEST_CHECK(m_cap.SyncedBlocks + 1 >= m_cap.MapFirst);
+			
+			for (d = 0; d < AD779X_TEST_DEVICES; d++)
+			{
+				if (m_written[d] && (m_cap.Streams[d].Block < m_cap.MapFirst))
+					m_closed[d] = 1;
+			}
+		}
+		
+		m_written[m_next]++;
+		m_total++;
+		
+		/* file being written: read as it was at last msync */
+		if (m_total == AD779X_TEST_DEVICES * AD779X_TEST_SAMPLES / 2)
+		{
+			AD779X_TEST_CHECK(AD779X_CapSync(&m_cap) == 0);
+			TestRead(m_path, m_written);
+		}
+	}
+	
+	AD779X_TEST_CHECK(m_paused);
+	AD779X_TEST_CHECK(m_wrong == 0);
+	AD779X_TEST_CHECK(m_windows > 4);
+	AD779X_TEST_CHECK(m_cap.Syncs >= m_cap.Blocks / AD779X_CAP_SYNC_BLOCKS);
+	AD779X_TEST_CHECK(m_cap.Samples == m_total);
+	
+	printf("%lu samples, %llu blocks, %llu windows, %u msync: ", m_total, (unsigned long long)m_cap.Blocks,
+		(unsigned long long)m_windows, m_cap.Syncs);
+	
+	AD779X_TEST_CHECK(AD779X_CapClose(&m_cap) == 0);
+	
+	/* closed file: unused blocks are cut */
+	TestRead(m_path, m_written);
+	
+	if (AD779X_CapOpen(&m_reader, m_path) == 0)
+	{
+		AD779X_TEST_CHECK(m_reader.FileBlocks == m_reader.Blocks + 1);
+		
+		for (d = 0; d < AD779X_TEST_DEVICES; d++)
+			AD779X_TEST_CHECK(AD779X_CapBlocks(&m_reader, d) == m_blocks[d]);
+		
+		AD779X_CapFree(&m_reader);
+	}
+	
+	unlink(m_path);
+	
+	printf("%s\n", gFails ? "FAIL" : "ok");
+	printf("%u failed checks\n", gFails);
+	
+	for (d = 0; d < AD779X_TEST_DEVICES; d++)
+		free(gSamples[d]);
+	
+	return (gFails != 0);
+}
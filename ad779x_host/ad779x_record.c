@@ -0,0 +1,965 @@
+/**
+  ******************************************************************************
+  * @file    ad779x_record.c
+  * @author  Khusainov Timur
+  * @version 0.0.0.1
+  * @date    16.10.2026
+  * @brief   AD7792/AD7793: record and replay of SPI traffic (host side)
+  ******************************************************************************
+  * @attention
+  * <h2><center>&copy; COPYRIGHT 2011 timypik@gmail.com </center></h2>
+  ******************************************************************************
+  */
+
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "ad779x_record.h"
+
+/* Recorders and replays attached to slots */
+static tAD779X_Recorder *gRecSlots[AD779X_REC_SLOTS];
+static tAD779X_Replay *gReplaySlots[AD779X_REC_SLOTS];
+
+/**
+ * @brief  Get time for event
+ * @param  pRec - recorder
+ * @return Time of device (GetTimeUs) or monotonic time of host, us
+ */
+static uint32_t AD779X_RecNow(tAD779X_Recorder *pRec)
+{
+	struct timespec m_ts;
+	
+	if (pRec->GetTimeUs)
+		return pRec->GetTimeUs();
+	
+	clock_gettime(CLOCK_MONOTONIC, &m_ts);
+	
+	return (uint32_t)((uint64_t)m_ts.tv_sec * 1000000ULL + (uint64_t)m_ts.tv_nsec / 1000);
+}
+
+/**
+ * @brief  Write byte to file
+ * @param  pRec - recorder
+ * @param  Data - byte
+ * @return None
+ */
+static void AD779X_RecPut(tAD779X_Recorder *pRec, uint8_t Data)
+{
+	putc(Data, pRec->pFile);
+	pRec->Bytes++;
+}
+
+/**
+ * @brief  Write varint to file: 7 bits per byte, LSB first
+ * @param  pRec - recorder
+ * @param  Value - value
+ * @return None
+ */
+static void AD779X_RecPutVarint(tAD779X_Recorder *pRec, uint32_t Value)
+{
+	while (Value >= 0x80)
+	{
+		AD779X_RecPut(pRec, (uint8_t)(Value | 0x80));
+		Value >>= 7;
+	}
+	
+	AD779X_RecPut(pRec, (uint8_t)Value);
+}
+
+/**
+ * @brief  Write head of event: tag and time from previous event
+ * @param  pRec - recorder
+ * @param  Tag - AD779X_REC_xxx
+ * @param  Time - time of event, us
+ * @return None
+ */
+static void AD779X_RecEventAt(tAD779X_Recorder *pRec, uint8_t Tag, uint32_t Time)
+{
+	uint32_t m_delta = Time - pRec->Time;
+	
+	pRec->Time = Time;
+	pRec->Events++;
+	
+	if (m_delta < 15)
+	{
+		AD779X_RecPut(pRec, (uint8_t)(Tag | (m_delta << 4)));
+	}
+	else
+	{
+		AD779X_RecPut(pRec, (uint8_t)(Tag | 0xF0));
+		AD779X_RecPutVarint(pRec, m_delta - 15);
+	}
+}
+
+/**
+ * @brief  Write pending run of same RDY states
+ * @param  pRec - recorder
+ * @return None
+ */
+static void AD779X_RecFlushRDY(tAD779X_Recorder *pRec)
+{
+	if (!pRec->RDYCount)
+		return;
+	
+	AD779X_RecEventAt(pRec, AD779X_REC_RDY, pRec->RDYTime);
+	AD779X_RecPutVarint(pRec, (pRec->RDYCount << 1) | (pRec->RDYLast ? 1 : 0));
+	
+	/* time after last check: replay gives it after run (timeout of wait) */
+	if (pRec->RDYTimed)
+		AD779X_RecEventAt(pRec, AD779X_REC_TIME, pRec->RDYTimeLast);
+	
+	pRec->RDYCount = 0;
+	pRec->RDYTimed = 0;
+}
+
+/**
+ * @brief  Write pending run of poll windows
+ * @param  pRec - recorder
+ * @return None
+ */
+static void AD779X_RecFlushPoll(tAD779X_Recorder *pRec)
+{
+	if (!pRec->PollCount)
+		return;
+	
+	AD779X_RecEventAt(pRec, AD779X_REC_POLL, pRec->PollTime);
+	AD779X_RecPutVarint(pRec, (pRec->PollCount << 1) | (pRec->PollLast ? 1 : 0));
+	
+	pRec->PollCount = 0;
+}
+
+/**
+ * @brief  Write all pending events in order: poll run, cs window, RDY run
+ * @param  pRec - recorder
+ * @return None
+ */
+static void AD779X_RecFlush(tAD779X_Recorder *pRec)
+{
+	AD779X_RecFlushPoll(pRec);
+	
+	/* cs window is not poll window: its events are written as is */
+	if (pRec->Window)
+	{
+		AD779X_RecEventAt(pRec, AD779X_REC_CS_ON, pRec->WindowTime);
+		
+		if (pRec->Window == 2)
+		{
+			pRec->RDYTime = pRec->WindowRDYTime;
+			pRec->RDYLast = pRec->WindowState;
+			pRec->RDYCount = 1;
+		}
+		
+		pRec->Window = 0;
+	}
+	
+	AD779X_RecFlushRDY(pRec);
+}
+
+/**
+ * @brief  Write head of event at current time
+ * @param  pRec - recorder
+ * @param  Tag - AD779X_REC_xxx
+ * @return None
+ */
+static void AD779X_RecEvent(tAD779X_Recorder *pRec, uint8_t Tag)
+{
+	AD779X_RecFlush(pRec);
+	AD779X_RecEventAt(pRec, Tag, AD779X_RecNow(pRec));
+}
+
+/**
+ * @brief  Record cs edge (device CSControl callback): cs window with one RDY
+ *         check is kept pending, it may be one of poll run
+ * @param  pRec - recorder
+ * @param  State - state of cs line
+ * @return None
+ */
+static void AD779X_RecCS(tAD779X_Recorder *pRec, unsigned char State)
+{
+	if (State == cssEnable)
+	{
+		/* previous cs window was not closed: write it, poll run goes on */
+		if (pRec->Window)
+			AD779X_RecFlush(pRec);
+		else
+			AD779X_RecFlushRDY(pRec);
+		
+		/* cs window is pending: it may be poll window */
+		
+		pRec->Window = 1;
+		pRec->WindowTime = AD779X_RecNow(pRec);
+	}
+	else if (pRec->Window == 2)
+	{
+		/* poll window: same states are one event */
+		if (pRec->PollCount && (pRec->WindowState == pRec->PollLast) && (pRec->PollCount < 0x7FFFFFFFUL))
+		{
+			pRec->PollCount++;
+		}
+		else
+		{
+			AD779X_RecFlushPoll(pRec);
+			
+			pRec->PollTime = pRec->WindowTime;
+			pRec->PollLast = pRec->WindowState;
+			pRec->PollCount = 1;
+		}
+		
+		pRec->Window = 0;
+	}
+	else
+	{
+		AD779X_RecEvent(pRec, AD779X_REC_CS_OFF);
+	}
+	
+	pRec->CSControl(State);
+}
+
+/**
+ * @brief  Record sent byte (device TxByte callback)
+ * @param  pRec - recorder
+ * @param  Data - sent byte
+ * @return None
+ */
+static void AD779X_RecTx(tAD779X_Recorder *pRec, unsigned char Data)
+{
+	pRec->TxByte(Data);
+	AD779X_RecEvent(pRec, AD779X_REC_TX);
+	AD779X_RecPut(pRec, Data);
+}
+
+/**
+ * @brief  Record received byte (device RxByte callback)
+ * @param  pRec - recorder
+ * @return Received byte
+ */
+static unsigned char AD779X_RecRx(tAD779X_Recorder *pRec)
+{
+	unsigned char m_data = pRec->RxByte();
+	
+	AD779X_RecEvent(pRec, AD779X_REC_RX);
+	AD779X_RecPut(pRec, m_data);
+	
+	return m_data;
+}
+
+/**
+ * @brief  Record block transfer (device TxRxBlock callback)
+ * @param  pRec - recorder
+ * @param  pTxData - sent bytes
+ * @param  pRxData - received bytes
+ * @param  Size - count of bytes
+ * @return None
+ */
+static void AD779X_RecBlock(tAD779X_Recorder *pRec, const uint8_t *pTxData, uint8_t *pRxData, size_t Size)
+{
+	size_t i;
+	
+	pRec->TxRxBlock(pTxData, pRxData, Size);
+	
+	AD779X_RecEvent(pRec, AD779X_REC_BLOCK);
+	AD779X_RecPutVarint(pRec, (uint32_t)Size);
+	
+	for (i = 0; i < Size; i++)
+		AD779X_RecPut(pRec, pTxData[i]);
+	
+	for (i = 0; i < Size; i++)
+		AD779X_RecPut(pRec, pRxData[i]);
+}
+
+/**
+ * @brief  Record RDY check (device RDYState callback): same states of checks
+ *         are one event
+ * @param  pRec - recorder
+ * @return State of RDY line
+ */
+static unsigned char AD779X_RecRDY(tAD779X_Recorder *pRec)
+{
+	unsigned char m_state = pRec->RDYState();
+	
+	/* first check of cs window */
+	if (pRec->Window == 1)
+	{
+		pRec->Window = 2;
+		pRec->WindowState = m_state;
+		pRec->WindowRDYTime = AD779X_RecNow(pRec);
+		
+		return m_state;
+	}
+	
+	if (pRec->Window || pRec->PollCount)
+		AD779X_RecFlush(pRec);
+	
+	/* polling: same states are one event */
+	if (pRec->RDYCount && (m_state == pRec->RDYLast) && (pRec->RDYCount < 0x7FFFFFFFUL))
+	{
+		pRec->RDYCount++;
+		pRec->RDYTimed = 0;
+	}
+	else
+	{
+		AD779X_RecFlushRDY(pRec);
+		
+		pRec->RDYTime = AD779X_RecNow(pRec);
+		pRec->RDYLast = m_state;
+		pRec->RDYCount = 1;
+	}
+	
+	return m_state;
+}
+
+/**
+ * @brief  Record time request (device GetTimeUs callback)
+ * @param  pRec - recorder
+ * @return Time, us
+ */
+static uint32_t AD779X_RecTime(tAD779X_Recorder *pRec)
+{
+	uint32_t m_time = pRec->GetTimeUs();
+	
+	/* request of RDY wait loop: time is kept in RDY run */
+	if (pRec->RDYCount && !pRec->Window && !pRec->PollCount)
+	{
+		pRec->RDYTimed = 1;
+		pRec->RDYTimeLast = m_time;
+		
+		return m_time;
+	}
+	
+	AD779X_RecFlush(pRec);
+	AD779X_RecEventAt(pRec, AD779X_REC_TIME, m_time);
+	
+	return m_time;
+}
+
+/**
+ * @brief  Record delay (device DelayUs callback): delays between windows of
+ *         poll run are not written
+ * @param  pRec - recorder
+ * @param  Us - delay, us
+ * @return None
+ */
+static void AD779X_RecDelay(tAD779X_Recorder *pRec, uint32_t Us)
+{
+	/* delay between windows of poll run (AD779X_WaitReady): time of events keeps it */
+	if (pRec->PollCount && !pRec->Window && !pRec->RDYCount)
+	{
+		pRec->DelayUs(Us);
+		return;
+	}
+	
+	AD779X_RecEvent(pRec, AD779X_REC_DELAY);
+	AD779X_RecPutVarint(pRec, Us);
+	
+	pRec->DelayUs(Us);
+}
+
+/**
+ * @brief  Read varint of record
+ * @param  pReplay - replay
+ * @param  pValue - value of varint
+ * @return 1 - ok, 0 - end of record
+ */
+static uint8_t AD779X_ReplayVarint(tAD779X_Replay *pReplay, uint32_t *pValue)
+{
+	uint8_t m_shift = 0, m_byte;
+	
+	*pValue = 0;
+	
+	do
+	{
+		if ((pReplay->Pos >= pReplay->Size) || (m_shift > 28))
+			return 0;
+		
+		m_byte = pReplay->pData[pReplay->Pos++];
+		*pValue |= (uint32_t)(m_byte & 0x7F) << m_shift;
+		m_shift += 7;
+	}
+	while (m_byte & 0x80);
+	
+	return 1;
+}
+
+/**
+ * @brief  Get event to be replayed: parse next event, if current is used
+ * @param  pReplay - replay
+ * @return Tag of event, 0 - end of record
+ */
+static uint8_t AD779X_ReplayPeek(tAD779X_Replay *pReplay)
+{
+	uint32_t m_delta, m_value = 0;
+	uint8_t m_head, m_ok = 1;
+	
+	if (pReplay->Tag || (pReplay->Pos >= pReplay->Size))
+		return pReplay->Tag;
+	
+	m_head = pReplay->pData[pReplay->Pos++];
+	m_delta = m_head >> 4;
+	
+	if (m_delta == 15)
+	{
+		m_ok = AD779X_ReplayVarint(pReplay, &m_value);
+		m_delta += m_value;
+	}
+	
+	pReplay->Tag = m_head & 0x0F;
+	pReplay->Time += m_delta;
+	pReplay->pTx = NULL;
+	pReplay->pRx = NULL;
+	pReplay->Count = 0;
+	pReplay->Phase = 0;
+	
+	switch (pReplay->Tag)
+	{
+		case AD779X_REC_TX:
+			pReplay->pTx = &pReplay->pData[pReplay->Pos];
+			pReplay->Count = 1;
+		break;
+		
+		case AD779X_REC_RX:
+			pReplay->pRx = &pReplay->pData[pReplay->Pos];
+			pReplay->Count = 1;
+		break;
+		
+		case AD779X_REC_BLOCK:
+			m_ok = m_ok && AD779X_ReplayVarint(pReplay, &pReplay->Count);
+			pReplay->pTx = &pReplay->pData[pReplay->Pos];
+			pReplay->pRx = pReplay->pTx + pReplay->Count;
+			pReplay->Pos += pReplay->Count;
+		break;
+		
+		case AD779X_REC_RDY:
+		case AD779X_REC_POLL:
+			m_ok = m_ok && AD779X_ReplayVarint(pReplay, &m_value);
+			pReplay->Value = m_value & 1;
+			pReplay->Count = m_value >> 1;
+		break;
+		
+		case AD779X_REC_DELAY:
+			m_ok = m_ok && AD779X_ReplayVarint(pReplay, &pReplay->Value);
+		break;
+	}
+	
+	/* data of TX, RX, BLOCK */
+	pReplay->Pos += pReplay->Count * (pReplay->pTx || pReplay->pRx);
+	
+	/* truncated record */
+	if (!m_ok || (pReplay->Pos > pReplay->Size))
+	{
+		pReplay->Pos = pReplay->Size;
+		pReplay->Tag = 0;
+	}
+	
+	return pReplay->Tag;
+}
+
+/**
+ * @brief  Go to next event
+ * @param  pReplay - replay
+ * @param  Used - 1: event was used by driver, 0: event is skipped
+ * @return None
+ */
+static void AD779X_ReplayNext(tAD779X_Replay *pReplay, uint8_t Used)
+{
+	if (Used)
+		pReplay->Stats.Events++;
+	else
+		pReplay->Stats.Skipped++;
+	
+	pReplay->Tag = 0;
+}
+
+/**
+ * @brief  Replay bytes of cs window: recorded data is one stream of bytes
+ *         (TxByte/RxByte and blocks of any size), it is not read over cs edge
+ * @param  pReplay - replay
+ * @param  pTxData - sent bytes, NULL - not compared
+ * @param  pRxData - buffer for received bytes
+ * @param  Size - count of bytes
+ * @return None
+ */
+static void AD779X_ReplayData(tAD779X_Replay *pReplay, const uint8_t *pTxData, uint8_t *pRxData, size_t Size)
+{
+	uint8_t m_tag;
+	size_t i;
+	
+	for (i = 0; i < Size; i++)
+	{
+		pRxData[i] = 0xFF;
+		
+		for (;;)
+		{
+			m_tag = AD779X_ReplayPeek(pReplay);
+			
+			if ((m_tag == AD779X_REC_TX) || (m_tag == AD779X_REC_RX) || (m_tag == AD779X_REC_BLOCK))
+			{
+				if (pReplay->Count)
+					break;
+				
+				/* empty block */
+				AD779X_ReplayNext(pReplay, 1);
+			}
+			else if ((m_tag == AD779X_REC_RDY) || (m_tag == AD779X_REC_TIME) || (m_tag == AD779X_REC_DELAY))
+			{
+				AD779X_ReplayNext(pReplay, 0);
+			}
+			else
+			{
+				/* cs edge or end of record */
+				break;
+			}
+		}
+		
+		if (!m_tag || (m_tag == AD779X_REC_CS_ON) || (m_tag == AD779X_REC_CS_OFF) || (m_tag == AD779X_REC_POLL))
+		{
+			pReplay->Stats.Underruns++;
+			continue;
+		}
+		
+		if (pReplay->pTx)
+		{
+			if (pTxData && (pTxData[i] != *pReplay->pTx))
+				pReplay->Stats.Mismatches++;
+			
+			pReplay->pTx++;
+		}
+		
+		if (pReplay->pRx)
+			pRxData[i] = *pReplay->pRx++;
+		
+		if (--pReplay->Count == 0)
+			AD779X_ReplayNext(pReplay, 1);
+	}
+}
+
+/**
+ * @brief  Replay cs edge (device CSControl callback): recorded events before
+ *         edge are skipped
+ * @param  pReplay - replay
+ * @param  State - state of cs line
+ * @return None
+ */
+static void AD779X_ReplayCS(tAD779X_Replay *pReplay, unsigned char State)
+{
+	uint8_t m_want = (State == cssEnable) ? AD779X_REC_CS_ON : AD779X_REC_CS_OFF;
+	uint8_t m_tag;
+	
+	/* events before cs edge not requested by driver are skipped */
+	while ((m_tag = AD779X_ReplayPeek(pReplay)) && (m_tag != AD779X_REC_CS_ON) && (m_tag != AD779X_REC_CS_OFF) &&
+	       (m_tag != AD779X_REC_POLL))
+		AD779X_ReplayNext(pReplay, 0);
+	
+	if (!m_tag)
+	{
+		pReplay->Stats.Underruns++;
+		return;
+	}
+	
+	/* poll window: cs on, RDY check, cs off */
+	if (m_tag == AD779X_REC_POLL)
+	{
+		if ((State == cssEnable) != (pReplay->Phase == 0))
+			pReplay->Stats.Mismatches++;
+		
+		if (State == cssEnable)
+		{
+			pReplay->Phase = 1;
+		}
+		else
+		{
+			pReplay->Phase = 0;
+			
+			if ((pReplay->Count == 0) || (--pReplay->Count == 0))
+				AD779X_ReplayNext(pReplay, 1);
+		}
+		
+		return;
+	}
+	
+	if (m_tag != m_want)
+		pReplay->Stats.Mismatches++;
+	
+	AD779X_ReplayNext(pReplay, 1);
+}
+
+/**
+ * @brief  Replay sent byte (device TxByte callback): byte is compared with record
+ * @param  pReplay - replay
+ * @param  Data - sent byte
+ * @return None
+ */
+static void AD779X_ReplayTx(tAD779X_Replay *pReplay, unsigned char Data)
+{
+	uint8_t m_tx = Data, m_rx;
+	
+	AD779X_ReplayData(pReplay, &m_tx, &m_rx, 1);
+}
+
+/**
+ * @brief  Replay received byte (device RxByte callback)
+ * @param  pReplay - replay
+ * @return Recorded byte, 0xFF - no recorded byte
+ */
+static unsigned char AD779X_ReplayRx(tAD779X_Replay *pReplay)
+{
+	uint8_t m_rx;
+	
+	AD779X_ReplayData(pReplay, NULL, &m_rx, 1);
+	
+	return m_rx;
+}
+
+/**
+ * @brief  Replay block transfer (device TxRxBlock callback)
+ * @param  pReplay - replay
+ * @param  pTxData - sent bytes
+ * @param  pRxData - buffer for received bytes
+ * @param  Size - count of bytes
+ * @return None
+ */
+static void AD779X_ReplayBlock(tAD779X_Replay *pReplay, const uint8_t *pTxData, uint8_t *pRxData, size_t Size)
+{
+	AD779X_ReplayData(pReplay, pTxData, pRxData, Size);
+}
+
+/**
+ * @brief  Replay RDY check (device RDYState callback)
+ * @param  pReplay - replay
+ * @return Recorded state of RDY line, rdsFree - no recorded check
+ */
+static unsigned char AD779X_ReplayRDY(tAD779X_Replay *pReplay)
+{
+	unsigned char m_state;
+	
+	/* check of poll window */
+	if (AD779X_ReplayPeek(pReplay) == AD779X_REC_POLL)
+	{
+		if (pReplay->Phase == 1)
+			pReplay->Phase = 2;
+		
+		return (unsigned char)pReplay->Value;
+	}
+	
+	/* no recorded check: recorded driver saw ready and went on */
+	if (AD779X_ReplayPeek(pReplay) != AD779X_REC_RDY)
+	{
+		if (!pReplay->Tag)
+			pReplay->Stats.Underruns++;
+		
+		return rdsFree;
+	}
+	
+	m_state = (unsigned char)pReplay->Value;
+	
+	if ((pReplay->Count == 0) || (--pReplay->Count == 0))
+		AD779X_ReplayNext(pReplay, 1);
+	
+	return m_state;
+}
+
+/**
+ * @brief  Replay time request (device GetTimeUs callback)
+ * @param  pReplay - replay
+ * @return Recorded time, time of current event - request is not recorded
+ *         (in RDY run)
+ */
+static uint32_t AD779X_ReplayTime(tAD779X_Replay *pReplay)
+{
+	/* recorded request: its time; else time of next event */
+	if (AD779X_ReplayPeek(pReplay) == AD779X_REC_TIME)
+		AD779X_ReplayNext(pReplay, 1);
+	
+	return pReplay->Time;
+}
+
+/**
+ * @brief  Replay delay (device DelayUs callback): no wait
+ * @param  pReplay - replay
+ * @param  Us - delay, us (not used)
+ * @return None
+ */
+static void AD779X_ReplayDelay(tAD779X_Replay *pReplay, uint32_t Us)
+{
+	(void)Us;
+	
+	if (AD779X_ReplayPeek(pReplay) == AD779X_REC_DELAY)
+		AD779X_ReplayNext(pReplay, 1);
+}
+
+/* Callbacks of slot n: device callbacks have no context, so each slot has own functions */
+#define AD779X_REC_SLOT(n) \
+static void AD779X_RecCS##n(unsigned char State) { AD779X_RecCS(gRecSlots[n], State); } \
+static void AD779X_RecTx##n(unsigned char Data) { AD779X_RecTx(gRecSlots[n], Data); } \
+static unsigned char AD779X_RecRx##n(void) { return AD779X_RecRx(gRecSlots[n]); } \
+static unsigned char AD779X_RecRDY##n(void) { return AD779X_RecRDY(gRecSlots[n]); } \
+static void AD779X_RecBlock##n(const uint8_t *pTxData, uint8_t *pRxData, size_t Size) \
+{ AD779X_RecBlock(gRecSlots[n], pTxData, pRxData, Size); } \
+static uint32_t AD779X_RecTime##n(void) { return AD779X_RecTime(gRecSlots[n]); } \
+static void AD779X_RecDelay##n(uint32_t Us) { AD779X_RecDelay(gRecSlots[n], Us); } \
+static void AD779X_ReplayCS##n(unsigned char State) { AD779X_ReplayCS(gReplaySlots[n], State); } \
+static void AD779X_ReplayTx##n(unsigned char Data) { AD779X_ReplayTx(gReplaySlots[n], Data); } \
+static unsigned char AD779X_ReplayRx##n(void) { return AD779X_ReplayRx(gReplaySlots[n]); } \
+static unsigned char AD779X_ReplayRDY##n(void) { return AD779X_ReplayRDY(gReplaySlots[n]); } \
+static void AD779X_ReplayBlock##n(const uint8_t *pTxData, uint8_t *pRxData, size_t Size) \
+{ AD779X_ReplayBlock(gReplaySlots[n], pTxData, pRxData, Size); } \
+static uint32_t AD779X_ReplayTime##n(void) { return AD779X_ReplayTime(gReplaySlots[n]); } \
+static void AD779X_ReplayDelay##n(uint32_t Us) { AD779X_ReplayDelay(gReplaySlots[n], Us); }
+
+AD779X_REC_SLOT(0) AD779X_REC_SLOT(1) AD779X_REC_SLOT(2) AD779X_REC_SLOT(3)
+AD779X_REC_SLOT(4) AD779X_REC_SLOT(5) AD779X_REC_SLOT(6) AD779X_REC_SLOT(7)
+
+/* Callbacks of slots */
+typedef struct
+{
+	tAD779X_CSControl CSControl;
+	tAD779X_TxByte TxByte;
+	tAD779X_RxByte RxByte;
+	tAD779X_RDYState RDYState;
+	tAD779X_TxRxBlock TxRxBlock;
+	tAD779X_GetTimeUs GetTimeUs;
+	tAD779X_DelayUs DelayUs;
+} tAD779X_RecCallbacks;
+
+#define AD779X_REC_CALLBACKS(Prefix, n) \
+	{Prefix##CS##n, Prefix##Tx##n, Prefix##Rx##n, Prefix##RDY##n, Prefix##Block##n, Prefix##Time##n, Prefix##Delay##n}
+
+static const tAD779X_RecCallbacks gRecCallbacks[8] =
+{
+	AD779X_REC_CALLBACKS(AD779X_Rec, 0), AD779X_REC_CALLBACKS(AD779X_Rec, 1),
+	AD779X_REC_CALLBACKS(AD779X_Rec, 2), AD779X_REC_CALLBACKS(AD779X_Rec, 3),
+	AD779X_REC_CALLBACKS(AD779X_Rec, 4), AD779X_REC_CALLBACKS(AD779X_Rec, 5),
+	AD779X_REC_CALLBACKS(AD779X_Rec, 6), AD779X_REC_CALLBACKS(AD779X_Rec, 7)
+};
+
+static const tAD779X_RecCallbacks gReplayCallbacks[8] =
+{
+	AD779X_REC_CALLBACKS(AD779X_Replay, 0), AD779X_REC_CALLBACKS(AD779X_Replay, 1),
+	AD779X_REC_CALLBACKS(AD779X_Replay, 2), AD779X_REC_CALLBACKS(AD779X_Replay, 3),
+	AD779X_REC_CALLBACKS(AD779X_Replay, 4), AD779X_REC_CALLBACKS(AD779X_Replay, 5),
+	AD779X_REC_CALLBACKS(AD779X_Replay, 6), AD779X_REC_CALLBACKS(AD779X_Replay, 7)
+};
+
+/**
+ * @brief  Start record: write head of file, put recorder between driver and
+ *         callbacks of device
+ * @param  pRec - recorder
+ * @param  pFile - output file (binary)
+ * @param  pDevice - ADC device with callbacks
+ * @return 1 - ok, 0 - no free slots
+ */
+uint8_t AD779X_RecStart(tAD779X_Recorder *pRec, FILE *pFile, tAD779X_Device *pDevice)
+{
+	const tAD779X_RecCallbacks *pSlot;
+	uint8_t i, m_flags = 0;
+	
+	for (i = 0; (i < AD779X_REC_SLOTS) && (i < 8) && gRecSlots[i]; i++);
+	
+	if ((i == AD779X_REC_SLOTS) || (i == 8))
+		return 0;
+	
+	memset(pRec, 0, sizeof(*pRec));
+	gRecSlots[i] = pRec;
+	pSlot = &gRecCallbacks[i];
+	
+	pRec->pFile     = pFile;
+	pRec->pDevice   = pDevice;
+	pRec->CSControl = pDevice->CSControl;
+	pRec->RDYState  = pDevice->RDYState;
+	pRec->TxByte    = pDevice->TxByte;
+	pRec->RxByte    = pDevice->RxByte;
+	pRec->TxRxBlock = pDevice->TxRxBlock;
+	pRec->GetTimeUs = pDevice->GetTimeUs;
+	pRec->DelayUs   = pDevice->DelayUs;
+	
+	if (pDevice->TxRxBlock)
+		m_flags |= AD779X_REC_FLAG_BLOCK;
+	
+	if (pDevice->GetTimeUs)
+		m_flags |= AD779X_REC_FLAG_TIME;
+	
+	if (pDevice->DelayUs)
+		m_flags |= AD779X_REC_FLAG_DELAY;
+	
+	/* head: magic, version, flags, reserved */
+	AD779X_RecPut(pRec, 'A');
+	AD779X_RecPut(pRec, '7');
+	AD779X_RecPut(pRec, '9');
+	AD779X_RecPut(pRec, 'R');
+	AD779X_RecPut(pRec, AD779X_REC_VERSION);
+	AD779X_RecPut(pRec, m_flags);
+	AD779X_RecPut(pRec, 0);
+	AD779X_RecPut(pRec, 0);
+	
+	/* absent callbacks stay absent: driver behaves as without recorder */
+	pDevice->CSControl = pSlot->CSControl;
+	pDevice->RDYState  = pSlot->RDYState;
+	pDevice->TxByte    = pRec->TxByte ? pSlot->TxByte : NULL;
+	pDevice->RxByte    = pRec->RxByte ? pSlot->RxByte : NULL;
+	pDevice->TxRxBlock = pRec->TxRxBlock ? pSlot->TxRxBlock : NULL;
+	pDevice->GetTimeUs = pRec->GetTimeUs ? pSlot->GetTimeUs : NULL;
+	pDevice->DelayUs   = pRec->DelayUs ? pSlot->DelayUs : NULL;
+	
+	return 1;
+}
+
+/**
+ * @brief  Stop record: restore callbacks of device, flush file
+ * @param  pRec - recorder
+ * @return None
+ */
+void AD779X_RecStop(tAD779X_Recorder *pRec)
+{
+	tAD779X_Device *pDevice = pRec->pDevice;
+	uint8_t i;
+	
+	AD779X_RecFlush(pRec);
+	fflush(pRec->pFile);
+	
+	pDevice->CSControl = pRec->CSControl;
+	pDevice->RDYState  = pRec->RDYState;
+	pDevice->TxByte    = pRec->TxByte;
+	pDevice->RxByte    = pRec->RxByte;
+	pDevice->TxRxBlock = pRec->TxRxBlock;
+	pDevice->GetTimeUs = pRec->GetTimeUs;
+	pDevice->DelayUs   = pRec->DelayUs;
+	
+	for (i = 0; i < AD779X_REC_SLOTS; i++)
+	{
+		if (gRecSlots[i] == pRec)
+			gRecSlots[i] = 0;
+	}
+}
+
+/**
+ * @brief  Init replay of record in memory
+ * @param  pReplay - replay
+ * @param  pData - record (must be valid while replay is used)
+ * @param  Size - size of record
+ * @return 1 - ok, 0 - not a record
+ */
+uint8_t AD779X_ReplayInit(tAD779X_Replay *pReplay, const uint8_t *pData, size_t Size)
+{
+	memset(pReplay, 0, sizeof(*pReplay));
+	
+	if ((Size < 8) || memcmp(pData, "A79R", 4) || (pData[4] == 0) || (pData[4] > AD779X_REC_VERSION))
+		return 0;
+	
+	pReplay->pData = pData;
+	pReplay->Size  = Size;
+	pReplay->Pos   = 8;
+	pReplay->Flags = pData[5];
+	
+	return 1;
+}
+
+/**
+ * @brief  Load record from file and init replay
+ * @param  pReplay - replay
+ * @param  pPath - path of record
+ * @return 1 - ok, 0 - error
+ */
+uint8_t AD779X_ReplayLoad(tAD779X_Replay *pReplay, const char *pPath)
+{
+	FILE *pFile = fopen(pPath, "rb");
+	uint8_t *pData = NULL;
+	long m_size = -1;
+	
+	if (!pFile)
+		return 0;
+	
+	if (fseek(pFile, 0, SEEK_END) == 0)
+		m_size = ftell(pFile);
+	
+	if ((m_size > 0) && (fseek(pFile, 0, SEEK_SET) == 0))
+		pData = malloc((size_t)m_size);
+	
+	if (pData && (fread(pData, 1, (size_t)m_size, pFile) != (size_t)m_size))
+	{
+		free(pData);
+		pData = NULL;
+	}
+	
+	fclose(pFile);
+	
+	if (!pData || !AD779X_ReplayInit(pReplay, pData, (size_t)m_size))
+	{
+		free(pData);
+		return 0;
+	}
+	
+	pReplay->pOwned = pData;
+	
+	return 1;
+}
+
+/**
+ * @brief  Free record loaded by AD779X_ReplayLoad
+ * @param  pReplay - replay
+ * @return None
+ */
+void AD779X_ReplayFree(tAD779X_Replay *pReplay)
+{
+	AD779X_ReplayDetach(pReplay);
+	
+	free(pReplay->pOwned);
+	pReplay->pOwned = NULL;
+	pReplay->pData = NULL;
+	pReplay->Size = 0;
+}
+
+/**
+ * @brief  Attach replay to device: set device callbacks as in record
+ * @param  pReplay - replay
+ * @param  pDevice - ADC device
+ * @return 1 - ok, 0 - no free slots
+ */
+uint8_t AD779X_ReplayAttach(tAD779X_Replay *pReplay, tAD779X_Device *pDevice)
+{
+	const tAD779X_RecCallbacks *pSlot;
+	uint8_t i;
+	
+	for (i = 0; (i < AD779X_REC_SLOTS) && (i < 8) && gReplaySlots[i]; i++);
+	
+	if ((i == AD779X_REC_SLOTS) || (i == 8))
+		return 0;
+	
+	gReplaySlots[i] = pReplay;
+	pSlot = &gReplayCallbacks[i];
+	
+	pDevice->CSControl = pSlot->CSControl;
+	pDevice->RDYState  = pSlot->RDYState;
+	pDevice->TxByte    = pSlot->TxByte;
+	pDevice->RxByte    = pSlot->RxByte;
+	pDevice->TxRxBlock = (pReplay->Flags & AD779X_REC_FLAG_BLOCK) ? pSlot->TxRxBlock : NULL;
+	pDevice->GetTimeUs = (pReplay->Flags & AD779X_REC_FLAG_TIME) ? pSlot->GetTimeUs : NULL;
+	pDevice->DelayUs   = (pReplay->Flags & AD779X_REC_FLAG_DELAY) ? pSlot->DelayUs : NULL;
+	
+	return 1;
+}
+
+/**
+ * @brief  Free slots of replay
+ * @param  pReplay - replay
+ * @return None
+ */
+void AD779X_ReplayDetach(tAD779X_Replay *pReplay)
+{
+	uint8_t i;
+	
+	for (i = 0; i < AD779X_REC_SLOTS; i++)
+	{
+		if (gReplaySlots[i] == pReplay)
+			gReplaySlots[i] = 0;
+	}
+}
+
+/**
+ * @brief  Check end of replay
+ * @param  pReplay - replay
+ * @return 1 - all events of record are replayed
+ */
+uint8_t AD779X_ReplayDone(const tAD779X_Replay *pReplay)
+{
+	return !pReplay->Tag && (pReplay->Pos >= pReplay->Size);
+}
@@ -0,0 +1,151 @@
+/**
+  ******************************************************************************
+  * @file    ad779x_record.h
+  * @author  Khusainov Timur
+  * @version 0.0.0.1
+  * @date    16.10.2026
+  * @brief   AD7792/AD7793: record and replay of SPI traffic (host side)
+  ******************************************************************************
+  * @attention
+  * <h2><center>&copy; COPYRIGHT 2011 timypik@gmail.com </center></h2>
+  ******************************************************************************
+  *
+  * Recorder is put between driver and callbacks of device: each cs edge, byte,
+  * block, RDY check, time request and delay is written to file. Replay feeds
+  * recorded session to driver: received bytes, RDY states and times.
+  *
+  * File: header "A79R", version, flags (AD779X_REC_FLAG_xxx), 2 reserved
+  * bytes; then events. Event starts with byte: tag (AD779X_REC_xxx) in low
+  * nibble, time from previous event (us) in high nibble; 15 - time is
+  * 15 + varint. Varint: 7 bits per byte, LSB first, bit 7 - more bytes.
+  *   AD779X_REC_CS_ON, AD779X_REC_CS_OFF, AD779X_REC_TIME - no data; time
+  *                      requests between checks of RDY run (AD779X_WaitRDY)
+  *                      are not written, only request after last check
+  *   AD779X_REC_TX    - sent byte
+  *   AD779X_REC_RX    - received byte
+  *   AD779X_REC_BLOCK - varint size, sent bytes, received bytes
+  *   AD779X_REC_RDY   - varint (count << 1 | state): same state of count checks
+  *   AD779X_REC_DELAY - varint delay, us; delays between windows of poll run
+  *                      (AD779X_WaitReady) are not written
+  *   AD779X_REC_POLL  - varint (count << 1 | state): count poll windows (cs on,
+  *                      one RDY check, cs off, as AD779X_CheckReadyHW) with same
+  *                      state; time of event is time of first window
+  */
+
+#ifndef AD779X_RECORD_H
+#define AD779X_RECORD_H
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stddef.h>
+
+#include "ad779x.h"
+
+/**
+ * @brief Count of recorders/replays, that can be attached to devices at same time
+ */
+#ifndef AD779X_REC_SLOTS
+#define AD779X_REC_SLOTS 8
+#endif
+
+#define AD779X_REC_VERSION 2
+
+/**
+ * @brief Event tags
+ */
+#define AD779X_REC_CS_ON  0x01  /*!< cs line active */
+#define AD779X_REC_CS_OFF 0x02  /*!< cs line inactive */
+#define AD779X_REC_TX     0x03  /*!< TxByte */
+#define AD779X_REC_RX     0x04  /*!< RxByte */
+#define AD779X_REC_BLOCK  0x05  /*!< TxRxBlock */
+#define AD779X_REC_RDY    0x06  /*!< RDYState */
+#define AD779X_REC_TIME   0x07  /*!< GetTimeUs: result is time of event */
+#define AD779X_REC_DELAY  0x08  /*!< DelayUs */
+#define AD779X_REC_POLL   0x09  /*!< run of poll windows (version 2) */
+
+/**
+ * @brief Flags of file: callbacks of recorded device
+ */
+#define AD779X_REC_FLAG_BLOCK 0x01  /*!< TxRxBlock */
+#define AD779X_REC_FLAG_TIME  0x02  /*!< GetTimeUs (else times of events are host time) */
+#define AD779X_REC_FLAG_DELAY 0x04  /*!< DelayUs */
+
+/**
+ * @brief Recorder
+ */
+typedef struct
+{
+	FILE *pFile;                   /*!< output file */
+	tAD779X_Device *pDevice;       /*!< recorded device */
+	
+	tAD779X_CSControl CSControl;   /*!< callbacks of device */
+	tAD779X_RDYState RDYState;
+	tAD779X_TxByte TxByte;
+	tAD779X_RxByte RxByte;
+	tAD779X_TxRxBlock TxRxBlock;
+	tAD779X_GetTimeUs GetTimeUs;
+	tAD779X_DelayUs DelayUs;
+	
+	uint32_t Time;                 /*!< time of last written event, us */
+	uint32_t RDYTime;              /*!< time of first check of pending RDY run */
+	uint32_t RDYCount;             /*!< checks of pending RDY run (0 - none) */
+	uint8_t RDYLast;               /*!< state of pending RDY run */
+	uint8_t RDYTimed;              /*!< time was requested after last check of pending RDY run */
+	uint32_t RDYTimeLast;          /*!< last time requested in pending RDY run */
+	
+	uint8_t Window;                /*!< pending cs window: 0 - none, 1 - cs on, 2 - cs on and RDY check */
+	uint8_t WindowState;           /*!< RDY state of pending cs window */
+	uint32_t WindowTime;           /*!< time of cs on of pending cs window */
+	uint32_t WindowRDYTime;        /*!< time of RDY check of pending cs window */
+	uint32_t PollTime;             /*!< time of first window of pending poll run */
+	uint32_t PollCount;            /*!< windows of pending poll run (0 - none) */
+	uint8_t PollLast;              /*!< state of pending poll run */
+	
+	unsigned long Events;          /*!< count of events */
+	unsigned long Bytes;           /*!< count of written bytes */
+} tAD779X_Recorder;
+
+/**
+ * @brief Replay statistics
+ */
+typedef struct
+{
+	unsigned long Events;      /*!< recorded events used */
+	unsigned long Skipped;     /*!< recorded events not requested by driver */
+	unsigned long Mismatches;  /*!< sent byte or cs state differs from record */
+	unsigned long Underruns;   /*!< requests of driver after end of record or out of cs window */
+} tAD779X_ReplayStats;
+
+/**
+ * @brief Replay
+ */
+typedef struct
+{
+	const uint8_t *pData;      /*!< recorded file */
+	size_t Size;               /*!< size of file */
+	size_t Pos;                /*!< position of next event */
+	uint8_t Flags;             /*!< AD779X_REC_FLAG_xxx */
+	uint8_t *pOwned;           /*!< file loaded by AD779X_ReplayLoad */
+	
+	uint8_t Tag;               /*!< tag of current event, 0 - none */
+	uint32_t Time;             /*!< time of current event, us */
+	uint32_t Value;            /*!< RDY state or delay of current event */
+	uint32_t Count;            /*!< RDY checks, poll windows or data bytes left of current event */
+	uint8_t Phase;             /*!< poll window of current event: 0 - before cs on, 1 - cs on, 2 - RDY checked */
+	const uint8_t *pTx;        /*!< sent bytes of current event (next byte) */
+	const uint8_t *pRx;        /*!< received bytes of current event (next byte) */
+	
+	tAD779X_ReplayStats Stats; /*!< statistics */
+} tAD779X_Replay;
+
+uint8_t AD779X_RecStart(tAD779X_Recorder *pRec, FILE *pFile, tAD779X_Device *pDevice);
+void AD779X_RecStop(tAD779X_Recorder *pRec);
+
+uint8_t AD779X_ReplayInit(tAD779X_Replay *pReplay, const uint8_t *pData, size_t Size);
+uint8_t AD779X_ReplayLoad(tAD779X_Replay *pReplay, const char *pPath);
+void AD779X_ReplayFree(tAD779X_Replay *pReplay);
+uint8_t AD779X_ReplayAttach(tAD779X_Replay *pReplay, tAD779X_Device *pDevice);
+void AD779X_ReplayDetach(tAD779X_Replay *pReplay);
+uint8_t AD779X_ReplayDone(const tAD779X_Replay *pReplay);
+
+#endif
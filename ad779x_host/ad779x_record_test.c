@@ -0,0 +1,224 @@
+/**
+  ******************************************************************************
+  * @file    ad779x_record_test.c
+  * @author  Khusainov Timur
+  * @version 0.0.0.1
+  * @date    16.10.2026
+  * @brief   AD7792/AD7793: round-trip test of record and replay on virtual chip
+  ******************************************************************************
+  * @attention
+  * <h2><center>&copy; COPYRIGHT 2011 timypik@gmail.com </center></h2>
+  ******************************************************************************
+  *
+  * Build for each variant of driver, e.g.:
+  *   cc -O2 -I../ad779x_single ad779x_record_test.c ad779x_record.c ad779x_vchip.c ../ad779x_single/ad779x.c -lm -o ad779x_record_test_single
+  *   cc -O2 -I../ad779x_multiple ad779x_record_test.c ad779x_record.c ad779x_vchip.c ../ad779x_multiple/ad779x.c -lm -o ad779x_record_test_multiple
+  *
+  * Session of driver on virtual chip (RDY waits, poll loop, continuous read,
+  * exit of continuous read on idle chip by timeout) is recorded, then replayed
+  * to driver without chip: results and register images must be same, all
+  * events are used. Record with GetTimeUs must be as compact as without it.
+  * Exit code is count of failed checks.
+  */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "ad779x_vchip.h"
+#include "ad779x_record.h"
+
+/* Count of samples of each part of session */
+#define AD779X_TEST_SAMPLES 20
+
+/* Max count of results of session */
+#define AD779X_TEST_RESULTS (4 * AD779X_TEST_SAMPLES + 8)
+
+#if defined(AD779X_VARIANT_SINGLE)
+tAD779X_Device ADCDevice;
+#define AD779X_TEST_VARIANT "single"
+#define DEV
+#define DEV_
+#define pTestDevice (&ADCDevice)
+#else
+static tAD779X_Device gTestDevice;
+#define AD779X_TEST_VARIANT "multiple"
+#define DEV  &gTestDevice
+#define DEV_ &gTestDevice,
+#define pTestDevice (&gTestDevice)
+#endif
+
+/* Virtual chip of record */
+static tAD779X_VChip gChip;
+
+/* Count of failed checks */
+static unsigned int gFails;
+
+#define AD779X_TEST_CHECK(Cond) TestCheck((Cond), #Cond, __LINE__)
+
+/**
+ * @brief  Count and print failed check
+ * @param  Cond - result of check
+ * @param  pText - text of check
+ * @param  Line - line of check
+ * @return None
+ */
+static void TestCheck(int Cond, const char *pText, int Line)
+{
+	if (Cond)
+		return;
+	
+	gFails++;
+	printf("  FAIL line %d: %s\n", Line, pText);
+}
+
+/**
+ * @brief  Session of driver: same calls on record and on replay
+ * @param  pResults - results of driver calls
+ * @return Count of results
+ */
+static unsigned int TestSession(unsigned long *pResults)
+{
+	unsigned int i, m_count = 0;
+	
+	AD779X_Reset(DEV);
+	AD779X_Init(DEV);
+	pResults[m_count++] = pTestDevice->SuState;
+	
+	AD779X_SetGain(DEV_ gain1);
+	AD779X_SetReference(DEV_ refInt);
+	AD779X_SetChannel(DEV_ chsAIN1);
+	AD779X_SetUpdateRate(DEV_ fs500);
+	AD779X_SetMode(DEV_ mdsContinuous);
+	
+	/* RDY waits of driver */
+	for (i = 0; i < AD779X_TEST_SAMPLES; i++)
+	{
+		pResults[m_count++] = AD779X_WaitReady(DEV_ 100000);
+		pResults[m_count++] = AD779X_ReadDataSample24(DEV);
+	}
+	
+	/* poll loop of application */
+	for (i = 0; i < AD779X_TEST_SAMPLES; i++)
+	{
+		while (!AD779X_CheckReadyHW(DEV));
+		pResults[m_count++] = AD779X_ReadDataSample24(DEV);
+	}
+	
+	/* continuous read: RDY wait in one cs window */
+	AD779X_StartContinuousRead(DEV);
+	
+	for (i = 0; i < AD779X_TEST_SAMPLES; i++)
+		pResults[m_count++] = AD779X_ReadContinuousSample24(DEV);
+	
+	pResults[m_count++] = AD779X_StopContinuousRead(DEV);
+	
+	/* exit of continuous read on idle chip: RDY timeout */
+	AD779X_SetMode(DEV_ mdsIdle);
+	AD779X_StartContinuousRead(DEV);
+	pResults[m_count++] = AD779X_StopContinuousRead(DEV);
+	
+	pResults[m_count++] = pTestDevice->ModeReg.DATA;
+	pResults[m_count++] = pTestDevice->ConfigReg.DATA;
+	pResults[m_count++] = pTestDevice->IOReg.DATA;
+	
+	return m_count;
+}
+
+/**
+ * @brief  Record session on virtual chip and replay it
+ * @param  UseBlock - use TxRxBlock callback
+ * @param  UseTime - use GetTimeUs callback
+ * @return Count of events of record
+ */
+static unsigned long TestRoundTrip(uint8_t UseBlock, uint8_t UseTime)
+{
+	unsigned long m_recorded[AD779X_TEST_RESULTS], m_replayed[AD779X_TEST_RESULTS];
+	unsigned int m_fails = gFails;
+	unsigned int m_count, i;
+	tAD779X_Recorder m_rec;
+	tAD779X_Replay m_replay;
+	uint8_t *pData;
+	FILE *pFile;
+	long m_size;
+	
+	/* record */
+	AD779X_VChipDetach(&gChip);
+	AD779X_VChipInit(&gChip, ad7793);
+	gChip.Signals[chsAIN1].Dc = 0.3;
+	gChip.Signals[chsAIN1].Noise = 0.001;
+	
+	memset(pTestDevice, 0, sizeof(*pTestDevice));
+	AD779X_VChipAttach(&gChip, pTestDevice, UseBlock);
+	
+	if (!UseTime)
+		pTestDevice->GetTimeUs = NULL;
+	
+	pFile = tmpfile();
+	AD779X_TEST_CHECK(pFile != NULL);
+	
+	if (!pFile)
+		return 0;
+	
+	AD779X_TEST_CHECK(AD779X_RecStart(&m_rec, pFile, pTestDevice));
+	m_count = TestSession(m_recorded);
+	AD779X_RecStop(&m_rec);
+	
+	m_size = ftell(pFile);
+	AD779X_TEST_CHECK(m_size == (long)m_rec.Bytes);
+	
+	pData = malloc((size_t)m_size);
+	rewind(pFile);
+	AD779X_TEST_CHECK(pData && (fread(pData, 1, (size_t)m_size, pFile) == (size_t)m_size));
+	fclose(pFile);
+	
+	/* replay to device without chip */
+	memset(pTestDevice, 0, sizeof(*pTestDevice));
+	AD779X_TEST_CHECK(AD779X_ReplayInit(&m_replay, pData, (size_t)m_size));
+	AD779X_TEST_CHECK(AD779X_ReplayAttach(&m_replay, pTestDevice));
+	AD779X_TEST_CHECK((pTestDevice->TxRxBlock != NULL) == (UseBlock != 0));
+	AD779X_TEST_CHECK((pTestDevice->GetTimeUs != NULL) == (UseTime != 0));
+	
+	AD779X_TEST_CHECK(TestSession(m_replayed) == m_count);
+	
+	for (i = 0; i < m_count; i++)
+		AD779X_TEST_CHECK(m_replayed[i] == m_recorded[i]);
+	
+	/* RDY timeout is replayed too */
+	AD779X_TEST_CHECK(m_recorded[m_count - 4] == AD779X_SAMPLE_TIMEOUT);
+	
+	AD779X_TEST_CHECK(AD779X_ReplayDone(&m_replay));
+	AD779X_TEST_CHECK(m_replay.Stats.Events == m_rec.Events);
+	AD779X_TEST_CHECK(m_replay.Stats.Skipped == 0);
+	AD779X_TEST_CHECK(m_replay.Stats.Mismatches == 0);
+	AD779X_TEST_CHECK(m_replay.Stats.Underruns == 0);
+	
+	AD779X_ReplayDetach(&m_replay);
+	free(pData);
+	
+	printf("%s, %s: %lu events, %lu bytes: %s\n", UseBlock ? "TxRxBlock" : "TxByte/RxByte", UseTime ? "GetTimeUs" : "no GetTimeUs",
+		m_rec.Events, m_rec.Bytes, (gFails == m_fails) ? "ok" : "FAIL");
+	
+	return m_rec.Events;
+}
+
+int main(void)
+{
+	unsigned long m_events, m_events_time;
+	uint8_t m_block;
+	
+	printf("record/replay test, driver variant: %s\n", AD779X_TEST_VARIANT);
+	
+	for (m_block = 0; m_block < 2; m_block++)
+	{
+		m_events = TestRoundTrip(m_block, 0);
+		m_events_time = TestRoundTrip(m_block, 1);
+		
+		/* time requests and delays of RDY waits are not events */
+		AD779X_TEST_CHECK(m_events_time < m_events + m_events / 2);
+	}
+	
+	printf("%u failed checks\n", gFails);
+	
+	return (gFails != 0);
+}
@@ -0,0 +1,179 @@
+/**
+  ******************************************************************************
+  * @file    ad779x_sbus.c
+  * @author  Khusainov Timur
+  * @version 0.0.0.1
+  * @date    16.10.2026
+  * @brief   AD7792/AD7793: SPI bus shared by threads (host side, pthreads)
+  ******************************************************************************
+  * @attention
+  * <h2><center>&copy; COPYRIGHT 2011 timypik@gmail.com </center></h2>
+  ******************************************************************************
+  */
+
+#include <time.h>
+#include <sched.h>
+#include "ad779x_sbus.h"
+
+/**
+ * @brief  Get monotonic time
+ * @param  None
+ * @return Time, ns
+ */
+static uint64_t AD779X_SBusNowNs(void)
+{
+	struct timespec m_ts;
+	
+	clock_gettime(CLOCK_MONOTONIC, &m_ts);
+	
+	return (uint64_t)m_ts.tv_sec * 1000000000ULL + (uint64_t)m_ts.tv_nsec;
+}
+
+/**
+ * @brief  Init shared bus
+ * @param  pBus - bus
+ * @return None
+ */
+void AD779X_SBusInit(tAD779X_SBus *pBus)
+{
+	pthread_mutex_init(&pBus->Lock, NULL);
+	pBus->pPending = NULL;
+	
+	pBus->Stats.Requests  = 0;
+	pBus->Stats.Contended = 0;
+	pBus->Stats.Batches   = 0;
+	pBus->Stats.MaxBatch  = 0;
+	pBus->Stats.WaitNs    = 0;
+	pBus->Stats.MaxWaitNs = 0;
+	pBus->Stats.BusyNs    = 0;
+}
+
+/**
+ * @brief  Free shared bus (no jobs must be pending)
+ * @param  pBus - bus
+ * @return None
+ */
+void AD779X_SBusDestroy(tAD779X_SBus *pBus)
+{
+	pthread_mutex_destroy(&pBus->Lock);
+}
+
+/**
+ * @brief  Push job to pending jobs (lock-free)
+ * @param  pBus - bus
+ * @param  pRequest - request
+ * @return None
+ */
+static void AD779X_SBusPush(tAD779X_SBus *pBus, tAD779X_SBusRequest *pRequest)
+{
+	pRequest->pNext = __atomic_load_n(&pBus->pPending, __ATOMIC_RELAXED);
+	
+	while (!__atomic_compare_exchange_n(&pBus->pPending, &pRequest->pNext, pRequest, 1, __ATOMIC_RELEASE, __ATOMIC_RELAXED));
+}
+
+/**
+ * @brief  Execute all submitted jobs back to back (Lock is held)
+ * @param  pBus - bus
+ * @return None
+ */
+static void AD779X_SBusCombine(tAD779X_SBus *pBus)
+{
+	tAD779X_SBusRequest *m_list, *m_fifo, *m_next;
+	uint64_t m_start, m_wait, m_count;
+	uint8_t m_pass;
+	
+	/* take all submitted jobs at once, limited passes: combiner is not starved */
+	for (m_pass = 0; m_pass < AD779X_SBUS_PASSES; m_pass++)
+	{
+		if ((m_list = __atomic_exchange_n(&pBus->pPending, NULL, __ATOMIC_ACQUIRE)) == NULL)
+			break;
+		
+		/* LIFO -> FIFO: jobs are executed in order of submit */
+		for (m_fifo = NULL; m_list; m_list = m_next)
+		{
+			m_next = m_list->pNext;
+			m_list->pNext = m_fifo;
+			m_fifo = m_list;
+		}
+		
+		for (m_count = 0; m_fifo; m_fifo = m_next, m_count++)
+		{
+			m_next = m_fifo->pNext;
+			m_start = AD779X_SBusNowNs();
+			m_wait = m_start - m_fifo->SubmitNs;
+			
+			m_fifo->Job(m_fifo->pArg);
+			
+			pBus->Stats.Requests++;
+			pBus->Stats.Contended += m_fifo->Contended;
+			pBus->Stats.WaitNs += m_wait;
+			pBus->Stats.BusyNs += AD779X_SBusNowNs() - m_start;
+			
+			if (m_wait > pBus->Stats.MaxWaitNs)
+				pBus->Stats.MaxWaitNs = m_wait;
+			
+			/* request belongs to waiting thread: not touched after Done */
+			__atomic_store_n(&m_fifo->Done, 1, __ATOMIC_RELEASE);
+		}
+		
+		pBus->Stats.Batches++;
+		
+		if (m_count > pBus->Stats.MaxBatch)
+			pBus->Stats.MaxBatch = m_count;
+	}
+}
+
+/**
+ * @brief  Execute job on bus: job of other threads are never interleaved with it;
+ *         waiting thread spins on Done of own job, Lock is only tried, if
+ *         no combiner has taken job
+ * @param  pBus - bus
+ * @param  Job - job (driver calls)
+ * @param  pArg - argument of job
+ * @return None (on return job is executed)
+ */
+void AD779X_SBusExecute(tAD779X_SBus *pBus, tAD779X_SBusJob Job, void *pArg)
+{
+	tAD779X_SBusRequest m_request;
+	uint8_t m_combiner;
+	
+	/* bus is free: this thread is combiner, else job waits for combiner */
+	m_combiner = (pthread_mutex_trylock(&pBus->Lock) == 0);
+	
+	m_request.Job = Job;
+	m_request.pArg = pArg;
+	m_request.Done = 0;
+	m_request.SubmitNs = AD779X_SBusNowNs();
+	m_request.Contended = !m_combiner;
+	
+	AD779X_SBusPush(pBus, &m_request);
+	
+	while (!__atomic_load_n(&m_request.Done, __ATOMIC_ACQUIRE))
+	{
+		/* combiner has left without own job: execute all pending jobs */
+		if (m_combiner || (pthread_mutex_trylock(&pBus->Lock) == 0))
+		{
+			AD779X_SBusCombine(pBus);
+			pthread_mutex_unlock(&pBus->Lock);
+			
+			m_combiner = 0;
+		}
+		else
+		{
+			sched_yield();
+		}
+	}
+}
+
+/**
+ * @brief  Get snapshot of counters
+ * @param  pBus - bus
+ * @param  pStats - counters
+ * @return None
+ */
+void AD779X_SBusGetStats(tAD779X_SBus *pBus, tAD779X_SBusStats *pStats)
+{
+	pthread_mutex_lock(&pBus->Lock);
+	*pStats = pBus->Stats;
+	pthread_mutex_unlock(&pBus->Lock);
+}
@@ -0,0 +1,79 @@
+/**
+  ******************************************************************************
+  * @file    ad779x_sbus.h
+  * @author  Khusainov Timur
+  * @version 0.0.0.1
+  * @date    16.10.2026
+  * @brief   AD7792/AD7793: SPI bus shared by threads (host side, pthreads)
+  ******************************************************************************
+  * @attention
+  * <h2><center>&copy; COPYRIGHT 2011 timypik@gmail.com </center></h2>
+  ******************************************************************************
+  *
+  * Driver calls of devices on one physical bus are executed one after another:
+  * each thread submits job (e.g. AD779X_ReadDataSample24 of its device), thread
+  * holding bus lock executes all submitted jobs back to back (flat combining),
+  * other threads wait for completion of own job (spin on Done, not on lock).
+  */
+
+#ifndef AD779X_SBUS_H
+#define AD779X_SBUS_H
+
+#include <stdint.h>
+#include <pthread.h>
+
+/**
+ * @brief Max passes of combiner over submitted jobs (jobs of next passes wait for next combiner)
+ */
+#ifndef AD779X_SBUS_PASSES
+#define AD779X_SBUS_PASSES 4
+#endif
+
+/**
+ * @brief Job: driver calls with cs windows of one device
+ */
+typedef void (* tAD779X_SBusJob)(void *pArg);
+
+/**
+ * @brief Submitted job
+ */
+typedef struct tAD779X_SBusRequest
+{
+	tAD779X_SBusJob Job;
+	void *pArg;
+	uint64_t SubmitNs;                 /*!< time of submit */
+	uint8_t Contended;                 /*!< bus was busy on submit */
+	volatile uint8_t Done;             /*!< job is executed */
+	struct tAD779X_SBusRequest *pNext;
+} tAD779X_SBusRequest;
+
+/**
+ * @brief Counters of bus
+ */
+typedef struct
+{
+	uint64_t Requests;   /*!< Executed jobs */
+	uint64_t Contended;  /*!< Jobs submitted, while bus was busy */
+	uint64_t Batches;    /*!< Passes of combiner (jobs executed back to back) */
+	uint64_t MaxBatch;   /*!< Max jobs in one pass */
+	uint64_t WaitNs;     /*!< Sum of time from submit to start of job */
+	uint64_t MaxWaitNs;  /*!< Max time from submit to start of job */
+	uint64_t BusyNs;     /*!< Sum of time of jobs execution */
+} tAD779X_SBusStats;
+
+/**
+ * @brief Shared bus
+ */
+typedef struct
+{
+	pthread_mutex_t Lock;              /*!< Held by combiner */
+	tAD779X_SBusRequest *pPending;     /*!< Submitted jobs (LIFO, lock-free push) */
+	tAD779X_SBusStats Stats;           /*!< Counters (changed under Lock) */
+} tAD779X_SBus;
+
+void AD779X_SBusInit(tAD779X_SBus *pBus);
+void AD779X_SBusDestroy(tAD779X_SBus *pBus);
+void AD779X_SBusExecute(tAD779X_SBus *pBus, tAD779X_SBusJob Job, void *pArg);
+void AD779X_SBusGetStats(tAD779X_SBus *pBus, tAD779X_SBusStats *pStats);
+
+#endif
@@ -0,0 +1,237 @@
+/**
+  ******************************************************************************
+  * @file    ad779x_sbus_test.c
+  * @author  Khusainov Timur
+  * @version 0.0.0.1
+  * @date    16.10.2026
+  * @brief   AD7792/AD7793: multi-thread test of SPI bus shared by threads
+  ******************************************************************************
+  * @attention
+  * <h2><center>&copy; COPYRIGHT 2011 timypik@gmail.com </center></h2>
+  ******************************************************************************
+  *
+  * Build (multiple variant of driver only):
+  *   cc -O2 -I../ad779x_multiple ad779x_sbus_test.c ad779x_sbus.c ../ad779x_multiple/ad779x.c -lpthread -o ad779x_sbus_test
+  *
+  * Each thread reads samples of own device through one shared bus. Devices are
+  * on one physical bus model: cs window of device must not be opened, while cs
+  * window of other device is open, bytes go to selected device only. Each job
+  * must be executed once on own device, counters of bus must add up.
+  * Exit code is count of failed checks.
+  */
+
+#include <stdio.h>
+#include <string.h>
+#include <pthread.h>
+
+#include "ad779x.h"
+#include "ad779x_sbus.h"
+
+/* Count of threads (one device of each thread) */
+#define AD779X_TEST_THREADS 4
+
+/* Count of jobs of each thread */
+#define AD779X_TEST_JOBS 20000
+
+/* No device is selected on physical bus */
+#define AD779X_TEST_NONE (-1)
+
+/* Devices and shared bus under test */
+static tAD779X_Device gDevices[AD779X_TEST_THREADS];
+static tAD779X_SBus gBus;
+
+/* Physical bus model: selected device, cs windows and errors of each device */
+static int gSelected = AD779X_TEST_NONE;
+static unsigned long gWindows[AD779X_TEST_THREADS];
+static unsigned long gErrors;
+
+/* Jobs executed on each device */
+static unsigned long gExecuted[AD779X_TEST_THREADS];
+
+/* Count of failed checks */
+static unsigned int gFails;
+
+#define AD779X_TEST_CHECK(Cond) TestCheck((Cond), #Cond, __LINE__)
+
+/**
+ * @brief  Count and print failed check
+ * @param  Cond - result of check
+ * @param  pText - text of check
+ * @param  Line - line of check
+ * @return None
+ */
+static void TestCheck(int Cond, const char *pText, int Line)
+{
+	if (Cond)
+		return;
+	
+	gFails++;
+	printf("  FAIL line %d: %s\n", Line, pText);
+}
+
+/**
+ * @brief  Open or close cs window of device on physical bus
+ * @param  Index - index of device
+ * @param  State - cs line state
+ * @return None
+ */
+static void TestCS(int Index, unsigned char State)
+{
+	int m_none = AD779X_TEST_NONE;
+	
+	if (State == cssEnable)
+	{
+		/* other window is open: windows are interleaved */
+		if (!__atomic_compare_exchange_n(&gSelected, &m_none, Index, 0, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE))
+			__atomic_add_fetch(&gErrors, 1, __ATOMIC_RELAXED);
+		
+		gWindows[Index]++;
+	}
+	else
+	{
+		if (!__atomic_compare_exchange_n(&gSelected, &Index, AD779X_TEST_NONE, 0, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE))
+			__atomic_add_fetch(&gErrors, 1, __ATOMIC_RELAXED);
+	}
+}
+
+/**
+ * @brief  Transfer byte of device on physical bus (byte takes some time)
+ * @param  Index - index of device
+ * @return Byte of device: index + 1
+ */
+static unsigned char TestByte(int Index)
+{
+	volatile unsigned int i;
+	
+	if (__atomic_load_n(&gSelected, __ATOMIC_ACQUIRE) != Index)
+		__atomic_add_fetch(&gErrors, 1, __ATOMIC_RELAXED);
+	
+	for (i = 0; i < 200; i++);
+	
+	return (unsigned char)(Index + 1);
+}
+
+/* Callbacks of each device */
+#define AD779X_TEST_CALLBACKS(n) \
+	static void TestCS##n(unsigned char State) { TestCS(n, State); } \
+	static void TestTx##n(unsigned char Data) { (void)Data; TestByte(n); } \
+	static unsigned char TestRx##n(void) { return TestByte(n); }
+
+AD779X_TEST_CALLBACKS(0)
+AD779X_TEST_CALLBACKS(1)
+AD779X_TEST_CALLBACKS(2)
+AD779X_TEST_CALLBACKS(3)
+
+/**
+ * @brief  Job argument: device and result
+ */
+typedef struct
+{
+	int Index;
+	unsigned long Sample;
+} tAD779X_TestJob;
+
+/**
+ * @brief  Job: read sample of device
+ * @param  pArg - job argument
+ * @return None
+ */
+static void TestRead(void *pArg)
+{
+	tAD779X_TestJob *pJob = pArg;
+	
+	pJob->Sample = AD779X_ReadDataSample24(&gDevices[pJob->Index]);
+	gExecuted[pJob->Index]++;
+}
+
+/**
+ * @brief  Thread: jobs of own device
+ * @param  pArg - index of device
+ * @return Count of wrong samples
+ */
+static void *TestThread(void *pArg)
+{
+	tAD779X_TestJob m_job;
+	unsigned long m_wrong = 0;
+	unsigned int i;
+	
+	m_job.Index = (int)(long)pArg;
+	
+	for (i = 0; i < AD779X_TEST_JOBS; i++)
+	{
+		m_job.Sample = 0;
+		AD779X_SBusExecute(&gBus, TestRead, &m_job);
+		
+		/* job is executed on return, on own device */
+		if (m_job.Sample != 0x010101UL * (unsigned long)(m_job.Index + 1))
+			m_wrong++;
+	}
+	
+	return (void *)m_wrong;
+}
+
+int main(void)
+{
+	static void (* const m_cs[AD779X_TEST_THREADS])(unsigned char) = {TestCS0, TestCS1, TestCS2, TestCS3};
+	static void (* const m_tx[AD779X_TEST_THREADS])(unsigned char) = {TestTx0, TestTx1, TestTx2, TestTx3};
+	static unsigned char (* const m_rx[AD779X_TEST_THREADS])(void) = {TestRx0, TestRx1, TestRx2, TestRx3};
+	pthread_t m_threads[AD779X_TEST_THREADS];
+	tAD779X_SBusStats m_stats;
+	unsigned long m_windows;
+	void *pWrong;
+	long i;
+	
+	for (i = 0; i < AD779X_TEST_THREADS; i++)
+	{
+		memset(&gDevices[i], 0, sizeof(gDevices[i]));
+		gDevices[i].Model = ad7793;
+		gDevices[i].CSControl = m_cs[i];
+		gDevices[i].TxByte = m_tx[i];
+		gDevices[i].RxByte = m_rx[i];
+	}
+	
+	/* cs windows of one job */
+	AD779X_ReadDataSample24(&gDevices[0]);
+	m_windows = gWindows[0];
+	gWindows[0] = 0;
+	
+	AD779X_SBusInit(&gBus);
+	
+	for (i = 0; i < AD779X_TEST_THREADS; i++)
+		AD779X_TEST_CHECK(pthread_create(&m_threads[i], NULL, TestThread, (void *)i) == 0);
+	
+	for (i = 0; i < AD779X_TEST_THREADS; i++)
+	{
+		AD779X_TEST_CHECK(pthread_join(m_threads[i], &pWrong) == 0);
+		AD779X_TEST_CHECK(pWrong == NULL);
+	}
+	
+	AD779X_SBusGetStats(&gBus, &m_stats);
+	AD779X_SBusDestroy(&gBus);
+	
+	/* cs windows are never interleaved, each job is executed once */
+	AD779X_TEST_CHECK(gErrors == 0);
+	AD779X_TEST_CHECK(gSelected == AD779X_TEST_NONE);
+	
+	for (i = 0; i < AD779X_TEST_THREADS; i++)
+	{
+		AD779X_TEST_CHECK(gExecuted[i] == AD779X_TEST_JOBS);
+		AD779X_TEST_CHECK(gWindows[i] == AD779X_TEST_JOBS * m_windows);
+	}
+	
+	/* counters add up: each pass has one job of thread at most */
+	AD779X_TEST_CHECK(m_stats.Requests == (uint64_t)AD779X_TEST_THREADS * AD779X_TEST_JOBS);
+	AD779X_TEST_CHECK(m_stats.Contended <= m_stats.Requests);
+	AD779X_TEST_CHECK(m_stats.Batches >= 1);
+	AD779X_TEST_CHECK(m_stats.Batches <= m_stats.Requests);
+	AD779X_TEST_CHECK(m_stats.MaxBatch >= 1);
+	AD779X_TEST_CHECK(m_stats.MaxBatch <= AD779X_TEST_THREADS);
+	AD779X_TEST_CHECK(m_stats.Requests <= m_stats.Batches * m_stats.MaxBatch);
+	AD779X_TEST_CHECK(m_stats.MaxWaitNs <= m_stats.WaitNs);
+	
+	printf("%d threads, %d jobs each: %llu batches, max batch %llu, %llu contended\n", AD779X_TEST_THREADS, AD779X_TEST_JOBS,
+		(unsigned long long)m_stats.Batches, (unsigned long long)m_stats.MaxBatch, (unsigned long long)m_stats.Contended);
+	printf("%u failed checks\n", gFails);
+	
+	return (gFails != 0);
+}
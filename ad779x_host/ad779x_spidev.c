@@ -0,0 +1,567 @@
+/**
+  ******************************************************************************
+  * @file    ad779x_spidev.c
+  * @author  Khusainov Timur
+  * @version 0.0.0.1
+  * @date    16.10.2026
+  * @brief   AD7792/AD7793: Linux spidev backend (host side)
+  ******************************************************************************
+  * @attention
+  * <h2><center>&copy; COPYRIGHT 2011 timypik@gmail.com </center></h2>
+  ******************************************************************************
+  */
+
+#include <string.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+
+#include "ad779x_spidev.h"
+
+/* Ports attached to slots */
+static tAD779X_Spidev *gSpidevSlots[AD779X_SPIDEV_SLOTS];
+
+/**
+ * @brief  ioctl of spidev
+ * @param  Fd - file of spidev
+ * @param  Request - SPI_IOC_xxx
+ * @param  pArg - argument of request
+ * @return Result of ioctl
+ */
+static int AD779X_SpidevSysIoctl(int Fd, unsigned long Request, void *pArg)
+{
+	return ioctl(Fd, Request, pArg);
+}
+
+/**
+ * @brief  Send queued segments by one ioctl
+ * @param  pPort - port
+ * @param  Hold - 1: cs line stays active after message, 0: cs line inactive
+ * @param  CopyBack - 1: copy received data to buffers of driver (buffers are valid)
+ * @return None
+ */
+static void AD779X_SpidevFlush(tAD779X_Spidev *pPort, uint8_t Hold, uint8_t CopyBack)
+{
+	uint8_t i;
+	
+	if (pPort->Count == 0)
+	{
+		/* cs line already in required state */
+		if (pPort->Held == Hold)
+			return;
+		
+		/* empty segment: only change cs line */
+		memset(&pPort->Segments[0], 0, sizeof(pPort->Segments[0]));
+		pPort->Segments[0].speed_hz = pPort->SpeedHz;
+		pPort->Segments[0].bits_per_word = 8;
+		pPort->pRxDest[0] = NULL;
+		pPort->Count = 1;
+	}
+	
+	/* cs_change of last segment: keep cs line active after message */
+	pPort->Segments[pPort->Count - 1].cs_change = Hold;
+	
+	pPort->Stats.Messages++;
+	pPort->Stats.Segments += pPort->Count;
+	pPort->Stats.Bytes += pPort->Used;
+	
+	if (pPort->Ioctl(pPort->Fd, SPI_IOC_MESSAGE(pPort->Count), pPort->Segments) < 0)
+	{
+		pPort->Stats.Errors++;
+		
+		/* no answer: bus is idle high */
+		memset(pPort->Rx, 0xFF, pPort->Used);
+	}
+	
+	if (CopyBack)
+	{
+		for (i = 0; i < pPort->Count; i++)
+		{
+			if (pPort->pRxDest[i])
+				memcpy(pPort->pRxDest[i], (const void *)(uintptr_t)pPort->Segments[i].rx_buf, pPort->Segments[i].len);
+		}
+	}
+	
+	pPort->Held = Hold;
+	pPort->Count = 0;
+	pPort->Used = 0;
+}
+
+/**
+ * @brief  Queue segments of message: data is copied to buffers of port
+ * @param  pPort - port
+ * @param  pTxData - data for send
+ * @param  pRxData - buffer for received data (copied on flush), may be NULL
+ * @param  Size - size of data
+ * @return None
+ */
+static void AD779X_SpidevQueue(tAD779X_Spidev *pPort, const uint8_t *pTxData, uint8_t *pRxData, size_t Size)
+{
+	struct spi_ioc_transfer *pSegment;
+	size_t m_size;
+	
+	do
+	{
+		/* message is full: send it, cs line stays active */
+		if ((pPort->Count == AD779X_SPIDEV_SEGMENTS) || (pPort->Used == AD779X_SPIDEV_BUFFER))
+			AD779X_SpidevFlush(pPort, 1, 1);
+		
+		m_size = AD779X_SPIDEV_BUFFER - pPort->Used;
+		
+		if (m_size > Size)
+			m_size = Size;
+		
+		memcpy(&pPort->Tx[pPort->Used], pTxData, m_size);
+		
+		pPort->pRxDest[pPort->Count] = pRxData;
+		pSegment = &pPort->Segments[pPort->Count++];
+		memset(pSegment, 0, sizeof(*pSegment));
+		
+		pSegment->tx_buf = (uintptr_t)&pPort->Tx[pPort->Used];
+		pSegment->rx_buf = (uintptr_t)&pPort->Rx[pPort->Used];
+		pSegment->len = (uint32_t)m_size;
+		pSegment->speed_hz = pPort->SpeedHz;
+		pSegment->bits_per_word = 8;
+		
+		pPort->Used += (uint16_t)m_size;
+		pTxData += m_size;
+		
+		if (pRxData)
+			pRxData += m_size;
+		
+		Size -= m_size;
+	}
+	while (Size);
+}
+
+/**
+ * @brief  Set state of cs line (device callback)
+ * @param  pPort - port
+ * @param  State - cssEnable, cssDisable
+ * @return None
+ */
+static void AD779X_SpidevSelect(tAD779X_Spidev *pPort, unsigned char State)
+{
+	pPort->Selected = (State == cssEnable);
+	
+	/* end of cs window: whole window by one ioctl */
+	if (!pPort->Selected)
+		AD779X_SpidevFlush(pPort, 0, 1);
+}
+
+/**
+ * @brief  Full-duplex block transfer (device callback)
+ * @param  pPort - port
+ * @param  pTxData - data for send
+ * @param  pRxData - buffer for received data
+ * @param  Size - size of block
+ * @return None
+ */
+static void AD779X_SpidevBlock(tAD779X_Spidev *pPort, const uint8_t *pTxData, uint8_t *pRxData, size_t Size)
+{
+	AD779X_SpidevQueue(pPort, pTxData, pRxData, Size);
+	
+	/* continuous read mode: sample is used before cs line goes inactive */
+	if (pPort->pDevice->ReadMode == rdmContinuous)
+		AD779X_SpidevFlush(pPort, 1, 1);
+}
+
+/**
+ * @brief  Send one byte (device callback)
+ * @param  pPort - port
+ * @param  Data - byte
+ * @return None
+ */
+static void AD779X_SpidevTx(tAD779X_Spidev *pPort, unsigned char Data)
+{
+	uint8_t m_data = Data;
+	
+	AD779X_SpidevQueue(pPort, &m_data, NULL, 1);
+}
+
+/**
+ * @brief  Receive one byte (device callback)
+ * @param  pPort - port
+ * @return Received byte
+ */
+static unsigned char AD779X_SpidevRx(tAD779X_Spidev *pPort)
+{
+	uint8_t m_data = 0x00;
+	
+	AD779X_SpidevQueue(pPort, &m_data, &m_data, 1);
+	
+	/* byte is used now: send queued bytes, cs line stays active */
+	AD779X_SpidevFlush(pPort, 1, 1);
+	
+	return m_data;
+}
+
+/**
+ * @brief  Get state of DOUT/RDY line (device callback)
+ * @param  pPort - port
+ * @return rdsFree - data ready, rdsBusy - not ready
+ */
+static unsigned char AD779X_SpidevRDY(tAD779X_Spidev *pPort)
+{
+	uint8_t m_frame[2] = {AD779X_RDR_STATUS, 0};
+	uint8_t i;
+	
+	if (pPort->RDYState)
+	{
+		/* RDY is valid while cs line is active: send queued segments (their
+		   received data is not used by driver), hold cs line */
+		if (pPort->Selected)
+			AD779X_SpidevFlush(pPort, 1, 0);
+		
+		return pPort->RDYState(pPort->pRDYArg);
+	}
+	
+	/* no RDY line: STATUS can not be read in continuous read mode and DOUT
+	   can not be seen, data is never ready (driver reports RDY timeout) */
+	if (pPort->pDevice->ReadMode == rdmContinuous)
+		return rdsBusy;
+	
+	/* received data of queued segments is not used by driver */
+	for (i = 0; i < pPort->Count; i++)
+		pPort->pRxDest[i] = NULL;
+	
+	/* no RDY line: STATUS read is complete command, so one message with queued
+	   segments releases cs line too (one ioctl per check) */
+	AD779X_SpidevQueue(pPort, m_frame, m_frame, 2);
+	AD779X_SpidevFlush(pPort, 0, 1);
+	
+	return (m_frame[1] & AD779X_SR_RDY) ? rdsBusy : rdsFree;
+}
+
+/* Callbacks of slot n: device callbacks have no context, so each slot has own functions */
+#define AD779X_SPIDEV_SLOT(n) \
+static void AD779X_SpidevCS##n(unsigned char State) \
+{ AD779X_SpidevSelect(gSpidevSlots[n], State); } \
+static void AD779X_SpidevTx##n(unsigned char Data) \
+{ AD779X_SpidevTx(gSpidevSlots[n], Data); } \
+static unsigned char AD779X_SpidevRx##n(void) \
+{ return AD779X_SpidevRx(gSpidevSlots[n]); } \
+static unsigned char AD779X_SpidevRDY##n(void) \
+{ return AD779X_SpidevRDY(gSpidevSlots[n]); } \
+static void AD779X_SpidevBlock##n(const uint8_t *pTxData, uint8_t *pRxData, size_t Size) \
+{ AD779X_SpidevBlock(gSpidevSlots[n], pTxData, pRxData, Size); }
+
+AD779X_SPIDEV_SLOT(0)  AD779X_SPIDEV_SLOT(1)  AD779X_SPIDEV_SLOT(2)  AD779X_SPIDEV_SLOT(3)
+AD779X_SPIDEV_SLOT(4)  AD779X_SPIDEV_SLOT(5)  AD779X_SPIDEV_SLOT(6)  AD779X_SPIDEV_SLOT(7)
+AD779X_SPIDEV_SLOT(8)  AD779X_SPIDEV_SLOT(9)  AD779X_SPIDEV_SLOT(10) AD779X_SPIDEV_SLOT(11)
+AD779X_SPIDEV_SLOT(12) AD779X_SPIDEV_SLOT(13) AD779X_SPIDEV_SLOT(14) AD779X_SPIDEV_SLOT(15)
+
+#define AD779X_SPIDEV_CALLBACKS(n) \
+	{AD779X_SpidevCS##n, AD779X_SpidevTx##n, AD779X_SpidevRx##n, AD779X_SpidevRDY##n, AD779X_SpidevBlock##n}
+
+/* Callbacks of slots */
+static const struct
+{
+	tAD779X_CSControl CSControl;
+	tAD779X_TxByte TxByte;
+	tAD779X_RxByte RxByte;
+	tAD779X_RDYState RDYState;
+	tAD779X_TxRxBlock TxRxBlock;
+} gSpidevCallbacks[16] =
+{
+	AD779X_SPIDEV_CALLBACKS(0),  AD779X_SPIDEV_CALLBACKS(1),  AD779X_SPIDEV_CALLBACKS(2),  AD779X_SPIDEV_CALLBACKS(3),
+	AD779X_SPIDEV_CALLBACKS(4),  AD779X_SPIDEV_CALLBACKS(5),  AD779X_SPIDEV_CALLBACKS(6),  AD779X_SPIDEV_CALLBACKS(7),
+	AD779X_SPIDEV_CALLBACKS(8),  AD779X_SPIDEV_CALLBACKS(9),  AD779X_SPIDEV_CALLBACKS(10), AD779X_SPIDEV_CALLBACKS(11),
+	AD779X_SPIDEV_CALLBACKS(12), AD779X_SPIDEV_CALLBACKS(13), AD779X_SPIDEV_CALLBACKS(14), AD779X_SPIDEV_CALLBACKS(15)
+};
+
+/**
+ * @brief  Init port on opened file
+ * @param  pPort - port
+ * @param  Fd - file of spidev
+ * @param  Ioctl - ioctl function, if NULL - ioctl of system
+ * @return None
+ */
+void AD779X_SpidevInit(tAD779X_Spidev *pPort, int Fd, tAD779X_SpidevIoctl Ioctl)
+{
+	memset(pPort, 0, sizeof(*pPort));
+	
+	pPort->Fd = Fd;
+	pPort->Ioctl = Ioctl ? Ioctl : AD779X_SpidevSysIoctl;
+	pPort->SpeedHz = AD779X_SPIDEV_SPEED_HZ;
+}
+
+/**
+ * @brief  Open spidev and set SPI mode 3, 8 bit words, clock
+ * @param  pPort - port
+ * @param  pPath - path of spidev, e.g. "/dev/spidev0.0"
+ * @param  SpeedHz - SPI clock, Hz (0 - default)
+ * @return 0 - ok, -1 - error
+ */
+int AD779X_SpidevOpen(tAD779X_Spidev *pPort, const char *pPath, uint32_t SpeedHz)
+{
+	uint8_t m_mode = SPI_MODE_3, m_bits = 8;
+	int m_fd;
+	
+	m_fd = open(pPath, O_RDWR);
+	
+	if (m_fd < 0)
+		return -1;
+	
+	AD779X_SpidevInit(pPort, m_fd, NULL);
+	
+	if (SpeedHz)
+		pPort->SpeedHz = SpeedHz;
+	
+	if ((pPort->Ioctl(m_fd, SPI_IOC_WR_MODE, &m_mode) < 0) ||
+	    (pPort->Ioctl(m_fd, SPI_IOC_WR_BITS_PER_WORD, &m_bits) < 0) ||
+	    (pPort->Ioctl(m_fd, SPI_IOC_WR_MAX_SPEED_HZ, &pPort->SpeedHz) < 0))
+	{
+		close(m_fd);
+		pPort->Fd = -1;
+		
+		return -1;
+	}
+	
+	return 0;
+}
+
+/**
+ * @brief  Close spidev
+ * @param  pPort - port
+ * @return None
+ */
+void AD779X_SpidevClose(tAD779X_Spidev *pPort)
+{
+	AD779X_SpidevDetach(pPort);
+	
+	if (pPort->Fd >= 0)
+		close(pPort->Fd);
+	
+	pPort->Fd = -1;
+}
+
+/**
+ * @brief  Attach port to device: set device callbacks
+ * @param  pPort - port
+ * @param  pDevice - ADC device
+ * @return Number of slot, 0xFF - no free slots
+ */
+uint8_t AD779X_SpidevAttach(tAD779X_Spidev *pPort, tAD779X_Device *pDevice)
+{
+	uint8_t i;
+	
+	for (i = 0; (i < AD779X_SPIDEV_SLOTS) && (i < 16); i++)
+	{
+		if (gSpidevSlots[i] == 0)
+		{
+			gSpidevSlots[i] = pPort;
+			pPort->pDevice = pDevice;
+			
+			pDevice->CSControl = gSpidevCallbacks[i].CSControl;
+			pDevice->TxByte    = gSpidevCallbacks[i].TxByte;
+			pDevice->RxByte    = gSpidevCallbacks[i].RxByte;
+			pDevice->RDYState  = gSpidevCallbacks[i].RDYState;
+			pDevice->TxRxBlock = gSpidevCallbacks[i].TxRxBlock;
+			pDevice->GetTimeUs = AD779X_SpidevTimeUs;
+			pDevice->DelayUs   = AD779X_SpidevDelayUs;
+			
+			return i;
+		}
+	}
+	
+	return 0xFF;
+}
+
+/**
+ * @brief  Free slots of port
+ * @param  pPort - port
+ * @return None
+ */
+void AD779X_SpidevDetach(tAD779X_Spidev *pPort)
+{
+	uint8_t i;
+	
+	for (i = 0; i < AD779X_SPIDEV_SLOTS; i++)
+	{
+		if (gSpidevSlots[i] == pPort)
+			gSpidevSlots[i] = 0;
+	}
+}
+
+/**
+ * @brief  Read registers by one ioctl: each read in own cs window
+ * @param  pPort - port (cs line must be inactive)
+ * @param  pReads - reads: Cmd and Size are set, Value is result
+ * @param  Count - count of reads, max AD779X_SPIDEV_SEGMENTS
+ * @return Count of reads done, 0 - ioctl error
+ */
+uint8_t AD779X_SpidevReadBatch(tAD779X_Spidev *pPort, tAD779X_SpidevRead *pReads, uint8_t Count)
+{
+	unsigned long m_errors = pPort->Stats.Errors;
+	uint8_t m_frame[5] = {0, 0, 0, 0, 0};
+	const uint8_t *pData;
+	uint8_t i, j;
+	
+	if (Count > AD779X_SPIDEV_SEGMENTS)
+		Count = AD779X_SPIDEV_SEGMENTS;
+	
+	for (i = 0; i < Count; i++)
+	{
+		m_frame[0] = pReads[i].Cmd;
+		
+		AD779X_SpidevQueue(pPort, m_frame, NULL, 1 + pReads[i].Size);
+		
+		/* cs line inactive between reads */
+		pPort->Segments[i].cs_change = 1;
+	}
+	
+	AD779X_SpidevFlush(pPort, 0, 0);
+	
+	if (pPort->Stats.Errors != m_errors)
+		return 0;
+	
+	/* received data of all reads one by one: skip command byte */
+	pData = pPort->Rx;
+	
+	for (i = 0; i < Count; i++)
+	{
+		pReads[i].Value = 0;
+		pData++;
+		
+		for (j = 0; j < pReads[i].Size; j++)
+			pReads[i].Value = (pReads[i].Value << 8) | *pData++;
+	}
+	
+	return Count;
+}
+
+/**
+ * @brief  Free-running time (device callback)
+ * @param  None
+ * @return Monotonic time, us
+ */
+uint32_t AD779X_SpidevTimeUs(void)
+{
+	struct timespec m_ts;
+	
+	clock_gettime(CLOCK_MONOTONIC, &m_ts);
+	
+	return (uint32_t)((uint64_t)m_ts.tv_sec * 1000000ULL + (uint64_t)m_ts.tv_nsec / 1000);
+}
+
+/**
+ * @brief  Sleep (device callback)
+ * @param  Us - time, us
+ * @return None
+ */
+void AD779X_SpidevDelayUs(uint32_t Us)
+{
+	struct timespec m_ts;
+	
+	m_ts.tv_sec  = Us / 1000000UL;
+	m_ts.tv_nsec = (long)(Us % 1000000UL) * 1000L;
+	
+	nanosleep(&m_ts, NULL);
+}
+
+/* Virtual chips bound to file numbers of ioctl shim */
+static struct
+{
+	int Fd;
+	tAD779X_VChip *pChip;
+} gSpidevVChips[AD779X_VCHIP_SLOTS];
+
+static uint8_t gSpidevVChipCount;
+
+/**
+ * @brief  Bind virtual chip to file number for AD779X_SpidevVChipIoctl
+ * @param  Fd - file number (any value)
+ * @param  pChip - virtual chip
+ * @return 1 - ok, 0 - no free entries
+ */
+uint8_t AD779X_SpidevVChipBind(int Fd, tAD779X_VChip *pChip)
+{
+	if (gSpidevVChipCount == AD779X_VCHIP_SLOTS)
+		return 0;
+	
+	gSpidevVChips[gSpidevVChipCount].Fd = Fd;
+	gSpidevVChips[gSpidevVChipCount].pChip = pChip;
+	gSpidevVChipCount++;
+	
+	return 1;
+}
+
+/**
+ * @brief  ioctl shim: spidev requests are executed on virtual chip
+ * @param  Fd - file number bound by AD779X_SpidevVChipBind
+ * @param  Request - SPI_IOC_MESSAGE(n), SPI_IOC_WR_xxx
+ * @param  pArg - argument of request
+ * @return Count of bytes of message, 0 - setup request, -1 - error
+ */
+int AD779X_SpidevVChipIoctl(int Fd, unsigned long Request, void *pArg)
+{
+	static const uint8_t m_zero[8] = {0};
+	const struct spi_ioc_transfer *pSegments = pArg;
+	tAD779X_VChip *pChip = 0;
+	uint8_t m_data[8];
+	size_t m_count, m_total = 0, i, j, m_size;
+	
+	for (i = 0; i < gSpidevVChipCount; i++)
+	{
+		if (gSpidevVChips[i].Fd == Fd)
+			pChip = gSpidevVChips[i].pChip;
+	}
+	
+	if (!pChip)
+		return -1;
+	
+	if (Request == SPI_IOC_WR_MAX_SPEED_HZ)
+	{
+		pChip->SclkHz = *(const uint32_t *)pArg;
+		return 0;
+	}
+	
+	if ((Request == SPI_IOC_WR_MODE) || (Request == SPI_IOC_WR_BITS_PER_WORD))
+		return 0;
+	
+	/* SPI_IOC_MESSAGE(n): count of segments from size of argument */
+	if ((_IOC_TYPE(Request) != SPI_IOC_MAGIC) || (_IOC_NR(Request) != 0) || (_IOC_DIR(Request) != _IOC_WRITE))
+		return -1;
+	
+	m_count = _IOC_SIZE(Request) / sizeof(struct spi_ioc_transfer);
+	
+	for (i = 0; i < m_count; i++)
+	{
+		if (!pChip->Selected)
+			AD779X_VChipSelect(pChip, cssEnable);
+		
+		/* absent buffers: zeros are sent, received data is dropped */
+		for (j = 0; j < pSegments[i].len; j += m_size)
+		{
+			m_size = pSegments[i].len - j;
+			
+			if (m_size > sizeof(m_data))
+				m_size = sizeof(m_data);
+			
+			AD779X_VChipBlock(pChip, pSegments[i].tx_buf ? (const uint8_t *)(uintptr_t)pSegments[i].tx_buf + j : m_zero, m_data, m_size);
+			
+			if (pSegments[i].rx_buf)
+				memcpy((uint8_t *)(uintptr_t)pSegments[i].rx_buf + j, m_data, m_size);
+		}
+		
+		m_total += pSegments[i].len;
+		
+		/* cs_change: inactive cs line between segments, active cs line after last segment */
+		if ((i + 1 < m_count) ? pSegments[i].cs_change : !pSegments[i].cs_change)
+			AD779X_VChipSelect(pChip, cssDisable);
+	}
+	
+	return (int)m_total;
+}
+
+/**
+ * @brief  DOUT/RDY line of virtual chip (RDYState of port)
+ * @param  pArg - virtual chip
+ * @return rdsFree - data ready, rdsBusy - not ready
+ */
+unsigned char AD779X_SpidevVChipRDY(void *pArg)
+{
+	return AD779X_VChipRDY((tAD779X_VChip *)pArg);
+}
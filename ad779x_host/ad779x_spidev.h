@@ -0,0 +1,123 @@
+/**
+  ******************************************************************************
+  * @file    ad779x_spidev.h
+  * @author  Khusainov Timur
+  * @version 0.0.0.1
+  * @date    16.10.2026
+  * @brief   AD7792/AD7793: Linux spidev backend (host side)
+  ******************************************************************************
+  * @attention
+  * <h2><center>&copy; COPYRIGHT 2011 timypik@gmail.com </center></h2>
+  ******************************************************************************
+  *
+  * Device callbacks are mapped to SPI_IOC_MESSAGE: blocks of one cs window are
+  * queued as spi_ioc_transfer segments and sent by one ioctl when cs line goes
+  * inactive. cs line is held between ioctls by cs_change of last segment
+  * (RDY line polling, continuous read mode). Reads of several registers are
+  * sent by one ioctl, cs_change makes separate cs window for each read.
+  *
+  * Continuous read mode needs RDY line (RDYState): without it STATUS register
+  * is polled (one ioctl per check, it releases cs line), that is not possible
+  * while data is clocked out continuously, so continuous reads end with
+  * AD779X_SAMPLE_TIMEOUT.
+  *
+  * ioctl is called through pointer: AD779X_SpidevVChipIoctl sends messages to
+  * virtual chip, so backend runs without hardware.
+  */
+
+#ifndef AD779X_SPIDEV_H
+#define AD779X_SPIDEV_H
+
+#include <stdint.h>
+#include <linux/spi/spidev.h>
+
+#include "ad779x_vchip.h"
+
+/**
+ * @brief Count of ports, that can be attached to devices at same time
+ */
+#ifndef AD779X_SPIDEV_SLOTS
+#define AD779X_SPIDEV_SLOTS 16
+#endif
+
+/**
+ * @brief Max segments of one SPI_IOC_MESSAGE
+ */
+#ifndef AD779X_SPIDEV_SEGMENTS
+#define AD779X_SPIDEV_SEGMENTS 32
+#endif
+
+/**
+ * @brief Size of frame buffers of one SPI_IOC_MESSAGE
+ */
+#ifndef AD779X_SPIDEV_BUFFER
+#define AD779X_SPIDEV_BUFFER 256
+#endif
+
+/**
+ * @brief Default SPI clock, Hz
+ */
+#define AD779X_SPIDEV_SPEED_HZ 1000000UL
+
+typedef int (* tAD779X_SpidevIoctl)(int Fd, unsigned long Request, void *pArg);
+typedef unsigned char (* tAD779X_SpidevRDY)(void *pArg);
+
+/**
+ * @brief Register read of batch
+ */
+typedef struct
+{
+	uint8_t Cmd;    /*!< command: AD779X_RDR_xxx */
+	uint8_t Size;   /*!< size of register, 1..4 */
+	uint32_t Value; /*!< read value */
+} tAD779X_SpidevRead;
+
+/**
+ * @brief Counters of port
+ */
+typedef struct
+{
+	unsigned long Messages; /*!< count of ioctl calls */
+	unsigned long Segments; /*!< count of spi_ioc_transfer segments */
+	unsigned long Bytes;    /*!< count of bytes on SPI bus */
+	unsigned long Errors;   /*!< count of failed ioctl calls */
+} tAD779X_SpidevStats;
+
+/**
+ * @brief spidev port: one chip select of SPI controller
+ */
+typedef struct
+{
+	int Fd;                                               /*!< /dev/spidevB.C */
+	tAD779X_SpidevIoctl Ioctl;                            /*!< ioctl or shim */
+	uint32_t SpeedHz;                                     /*!< SPI clock, Hz */
+	tAD779X_SpidevRDY RDYState;                           /*!< DOUT/RDY line (e.g. GPIO on MISO), if NULL - STATUS register is read (no continuous read) */
+	void *pRDYArg;                                        /*!< argument of RDYState */
+	tAD779X_Device *pDevice;                              /*!< attached device */
+	
+	struct spi_ioc_transfer Segments[AD779X_SPIDEV_SEGMENTS]; /*!< message being built */
+	uint8_t *pRxDest[AD779X_SPIDEV_SEGMENTS];            /*!< where received data of segment is copied, may be NULL */
+	uint8_t Tx[AD779X_SPIDEV_BUFFER];                    /*!< sent data of message */
+	uint8_t Rx[AD779X_SPIDEV_BUFFER];                    /*!< received data of message */
+	uint16_t Used;                                       /*!< used bytes of Tx/Rx */
+	uint8_t Count;                                        /*!< count of queued segments */
+	uint8_t Selected;                                     /*!< cs line is active by driver */
+	uint8_t Held;                                         /*!< cs line is held after last ioctl */
+	
+	tAD779X_SpidevStats Stats;                            /*!< Counters */
+} tAD779X_Spidev;
+
+void AD779X_SpidevInit(tAD779X_Spidev *pPort, int Fd, tAD779X_SpidevIoctl Ioctl);
+int AD779X_SpidevOpen(tAD779X_Spidev *pPort, const char *pPath, uint32_t SpeedHz);
+void AD779X_SpidevClose(tAD779X_Spidev *pPort);
+uint8_t AD779X_SpidevAttach(tAD779X_Spidev *pPort, tAD779X_Device *pDevice);
+void AD779X_SpidevDetach(tAD779X_Spidev *pPort);
+uint8_t AD779X_SpidevReadBatch(tAD779X_Spidev *pPort, tAD779X_SpidevRead *pReads, uint8_t Count);
+uint32_t AD779X_SpidevTimeUs(void);
+void AD779X_SpidevDelayUs(uint32_t Us);
+
+uint8_t AD779X_SpidevVChipBind(int Fd, tAD779X_VChip *pChip);
+int AD779X_SpidevVChipIoctl(int Fd, unsigned long Request, void *pArg);
+unsigned char AD779X_SpidevVChipRDY(void *pArg);
+
+#endif
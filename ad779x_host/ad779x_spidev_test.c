@@ -0,0 +1,231 @@
+/**
+  ******************************************************************************
+  * @file    ad779x_spidev_test.c
+  * @author  Khusainov Timur
+  * @version 0.0.0.1
+  * @date    16.10.2026
+  * @brief   AD7792/AD7793 driver: test of spidev backend on virtual chip
+  ******************************************************************************
+  * @attention
+  * <h2><center>&copy; COPYRIGHT 2011 timypik@gmail.com </center></h2>
+  ******************************************************************************
+  *
+  * Build for each variant of driver, e.g.:
+  *   cc -O2 -I../ad779x_single ad779x_spidev_test.c ad779x_spidev.c ad779x_vchip.c ../ad779x_single/ad779x.c -lm -o ad779x_spidev_test_single
+  *   cc -O2 -I../ad779x_multiple ad779x_spidev_test.c ad779x_spidev.c ad779x_vchip.c ../ad779x_multiple/ad779x.c -lm -o ad779x_spidev_test_multiple
+  *
+  * Driver runs on spidev port, messages are executed on virtual chip by
+  * AD779X_SpidevVChipIoctl: init, register and data reads, AD779X_SpidevReadBatch
+  * and continuous read (with and without RDY line) are checked against state
+  * of virtual chip. Exit code is count of failed checks.
+  */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "ad779x_spidev.h"
+
+/* File number of virtual spidev */
+#define AD779X_TEST_FD 3
+
+/* Count of samples of continuous read */
+#define AD779X_TEST_SAMPLES 16
+
+#if defined(AD779X_VARIANT_SINGLE)
+tAD779X_Device ADCDevice;
+#define AD779X_TEST_VARIANT "single"
+#define DEV
+#define DEV_
+#define pTestDevice (&ADCDevice)
+#else
+static tAD779X_Device gTestDevice;
+#define AD779X_TEST_VARIANT "multiple"
+#define DEV  &gTestDevice
+#define DEV_ &gTestDevice,
+#define pTestDevice (&gTestDevice)
+#endif
+
+/* Virtual chip and port under test */
+static tAD779X_VChip gChip;
+static tAD779X_Spidev gPort;
+
+/* Count of failed checks */
+static unsigned int gFails;
+
+#define AD779X_TEST_CHECK(Cond) TestCheck((Cond), #Cond, __LINE__)
+
+/**
+ * @brief  Count and print failed check
+ * @param  Cond - result of check
+ * @param  pText - text of check
+ * @param  Line - line of check
+ * @return None
+ */
+static void TestCheck(int Cond, const char *pText, int Line)
+{
+	if (Cond)
+		return;
+	
+	gFails++;
+	printf("  FAIL line %d: %s\n", Line, pText);
+}
+
+/**
+ * @brief  Virtual time of chip (device callback): deadlines follow chip
+ * @param  None
+ * @return Time, us
+ */
+static uint32_t TestTimeUs(void)
+{
+	return AD779X_VChipTimeUs(&gChip);
+}
+
+/**
+ * @brief  Sleep in virtual time of chip (device callback)
+ * @param  Us - time, us
+ * @return None
+ */
+static void TestDelayUs(uint32_t Us)
+{
+	AD779X_VChipDelayUs(&gChip, Us);
+}
+
+/**
+ * @brief  Expected sample of driver (24-bit range) from DATA register of chip
+ * @param  None
+ * @return Sample value
+ */
+static unsigned long TestExpected(void)
+{
+	return (gChip.Model == ad7793) ? gChip.DataReg : (gChip.DataReg << 8);
+}
+
+/**
+ * @brief  Run checks on model
+ * @param  Model - model of virtual chip
+ * @return None
+ */
+static void TestModel(tAD779X_Model Model)
+{
+	const uint8_t m_size = (Model == ad7793) ? 3 : 2;
+	tAD779X_SpidevRead m_reads[5];
+	unsigned long m_sample, m_messages;
+	unsigned int m_fails = gFails;
+	uint8_t i, m_ok;
+	
+	AD779X_VChipInit(&gChip, Model);
+	gChip.Signals[chsAIN1].Dc = 0.5;
+	
+	AD779X_SpidevInit(&gPort, AD779X_TEST_FD, AD779X_SpidevVChipIoctl);
+	gPort.RDYState = AD779X_SpidevVChipRDY;
+	gPort.pRDYArg  = &gChip;
+	
+	memset(pTestDevice, 0, sizeof(*pTestDevice));
+	AD779X_TEST_CHECK(AD779X_SpidevAttach(&gPort, pTestDevice) != 0xFF);
+	
+	pTestDevice->GetTimeUs = TestTimeUs;
+	pTestDevice->DelayUs   = TestDelayUs;
+	
+	/* init: model is detected by ID register read */
+	AD779X_Reset(DEV);
+	AD779X_Init(DEV);
+	
+	AD779X_TEST_CHECK(pTestDevice->SuState == susActivate);
+	AD779X_TEST_CHECK(pTestDevice->Model == Model);
+	
+	AD779X_SetGain(DEV_ gain1);
+	AD779X_SetReference(DEV_ refInt);
+	AD779X_SetUpdateRate(DEV_ fs500);
+	AD779X_SetMode(DEV_ mdsContinuous);
+	
+	/* register writes reach chip */
+	AD779X_TEST_CHECK(gChip.ModeReg.DATA == pTestDevice->ModeReg.DATA);
+	AD779X_TEST_CHECK(gChip.ConfigReg.DATA == pTestDevice->ConfigReg.DATA);
+	AD779X_TEST_CHECK(gChip.IOReg.DATA == pTestDevice->IOReg.DATA);
+	
+	/* data read: RDY line, then STATUS register polling */
+	AD779X_TEST_CHECK(AD779X_WaitReady(DEV_ 100000));
+	m_sample = AD779X_ReadDataSample24(DEV);
+	AD779X_TEST_CHECK(m_sample == TestExpected());
+	AD779X_TEST_CHECK(m_sample > 0x800000UL);
+	
+	gPort.RDYState = NULL;
+	
+	/* without RDY line: one ioctl per check, STATUS read releases cs line */
+	m_messages = gPort.Stats.Messages;
+	AD779X_CheckReadyHW(DEV);
+	AD779X_TEST_CHECK(gPort.Stats.Messages == m_messages + 1);
+	AD779X_TEST_CHECK(!gChip.Selected);
+	
+	AD779X_TEST_CHECK(AD779X_WaitReady(DEV_ 100000));
+	AD779X_TEST_CHECK(AD779X_ReadDataSample24(DEV) == TestExpected());
+	
+	gPort.RDYState = AD779X_SpidevVChipRDY;
+	
+	/* batch of reads by one ioctl */
+	m_reads[0].Cmd = AD779X_RDR_ID;     m_reads[0].Size = 1;
+	m_reads[1].Cmd = AD779X_RDR_MODE;   m_reads[1].Size = 2;
+	m_reads[2].Cmd = AD779X_RDR_CONFIG; m_reads[2].Size = 2;
+	m_reads[3].Cmd = AD779X_RDR_OFFSET; m_reads[3].Size = m_size;
+	m_reads[4].Cmd = AD779X_RDR_FSCLAE; m_reads[4].Size = m_size;
+	
+	m_ok = AD779X_SpidevReadBatch(&gPort, m_reads, 5);
+	
+	AD779X_TEST_CHECK(m_ok == 5);
+	AD779X_TEST_CHECK((m_reads[0].Value & 0x0F) == ((Model == ad7793) ? AD7793_PARTID : AD7792_PARTID));
+	AD779X_TEST_CHECK(m_reads[1].Value == gChip.ModeReg.DATA);
+	AD779X_TEST_CHECK(m_reads[2].Value == gChip.ConfigReg.DATA);
+	AD779X_TEST_CHECK(m_reads[3].Value == gChip.OffsetReg[0]);
+	AD779X_TEST_CHECK(m_reads[4].Value == gChip.FScaleReg[0]);
+	
+	/* continuous read with RDY line: each sample is new result of chip */
+	AD779X_StartContinuousRead(DEV);
+	
+	for (i = 0; i < AD779X_TEST_SAMPLES; i++)
+	{
+		m_sample = AD779X_ReadContinuousSample24(DEV);
+		AD779X_TEST_CHECK(m_sample == TestExpected());
+		AD779X_TEST_CHECK(gChip.Continuous && gChip.Selected);
+	}
+	
+	m_sample = AD779X_StopContinuousRead(DEV);
+	
+	AD779X_TEST_CHECK(m_sample == TestExpected());
+	AD779X_TEST_CHECK(!gChip.Continuous);
+	AD779X_TEST_CHECK(!gChip.Selected);
+	AD779X_TEST_CHECK(pTestDevice->ReadMode == rdmSingle);
+	AD779X_TEST_CHECK(gChip.Stats.Conversions >= AD779X_TEST_SAMPLES);
+	
+	/* continuous read without RDY line: timeout, no data of idle bus */
+	gPort.RDYState = NULL;
+	pTestDevice->GetTimeUs = AD779X_SpidevTimeUs;
+	
+	AD779X_StartContinuousRead(DEV);
+	AD779X_TEST_CHECK(AD779X_ReadContinuousSample24(DEV) == AD779X_SAMPLE_TIMEOUT);
+	AD779X_StopContinuousRead(DEV);
+	
+	AD779X_TEST_CHECK(pTestDevice->Telemetry.Timeouts == 2);
+	AD779X_TEST_CHECK(!gChip.Selected);
+	
+	AD779X_TEST_CHECK(gPort.Stats.Errors == 0);
+	
+	printf("%s: %s, %lu messages, %lu segments, %lu bytes\n", (Model == ad7793) ? "AD7793" : "AD7792",
+		(gFails == m_fails) ? "ok" : "FAIL", gPort.Stats.Messages, gPort.Stats.Segments, gPort.Stats.Bytes);
+	
+	AD779X_SpidevDetach(&gPort);
+}
+
+int main(void)
+{
+	printf("spidev backend test, driver variant: %s\n", AD779X_TEST_VARIANT);
+	
+	if (!AD779X_SpidevVChipBind(AD779X_TEST_FD, &gChip))
+		return 1;
+	
+	TestModel(ad7792);
+	TestModel(ad7793);
+	
+	printf("%u failed checks\n", gFails);
+	
+	return (gFails != 0);
+}
@@ -0,0 +1,702 @@
+/**
+  ******************************************************************************
+  * @file    ad779x_vchip.c
+  * @author  Khusainov Timur
+  * @version 0.0.0.1
+  * @date    16.10.2026
+  * @brief   Virtual AD7792/AD7793: software model of ADC for host (PC) side
+  ******************************************************************************
+  * @attention
+  * <h2><center>&copy; COPYRIGHT 2011 timypik@gmail.com </center></h2>
+  ******************************************************************************
+  */
+
+#include <math.h>
+#include <string.h>
+
+#include "ad779x_vchip.h"
+
+/* ID register value */
+#define AD779X_VCHIP_ID_AD7792 (0x40 | AD7792_PARTID)
+#define AD779X_VCHIP_ID_AD7793 (0x40 | AD7793_PARTID)
+
+/* Virtual chips attached to slots */
+static tAD779X_VChip *gVChipSlots[AD779X_VCHIP_SLOTS];
+
+/**
+ * @brief  Get resolution of virtual chip
+ * @param  pChip - virtual chip
+ * @return Count of bits
+ */
+static uint8_t AD779X_VChipBits(const tAD779X_VChip *pChip)
+{
+	return (pChip->Model == ad7793) ? 24 : 16;
+}
+
+/**
+ * @brief  Get size of register
+ * @param  pChip - virtual chip
+ * @param  Reg - register address (AD779X_REG_xxx)
+ * @return Size, bytes
+ */
+static uint8_t AD779X_VChipRegSize(const tAD779X_VChip *pChip, uint8_t Reg)
+{
+	switch (Reg)
+	{
+		case AD779X_REG_MODE:
+		case AD779X_REG_CONFIG:
+			return 2;
+		
+		case AD779X_REG_DATA:
+		case AD779X_REG_OFFSET:
+		case AD779X_REG_FSCALE:
+			return AD779X_VChipBits(pChip) / 8;
+		
+		default:
+			return 1;
+	}
+}
+
+/**
+ * @brief  Make random value -1..1 (xorshift)
+ * @param  pChip - virtual chip
+ * @return Random value
+ */
+static double AD779X_VChipRandom(tAD779X_VChip *pChip)
+{
+	uint32_t x = pChip->Seed;
+	
+	x ^= x << 13;
+	x ^= x >> 17;
+	x ^= x << 5;
+	pChip->Seed = x;
+	
+	return ((double)x / 2147483648.0) - 1.0;
+}
+
+/**
+ * @brief  Get input of modulator in part of full scale for selected channel
+ * @param  pChip - virtual chip
+ * @param  Channel - channel
+ * @param  Vin - input voltage of channel, V
+ * @return Modulator input (1.0 - positive full scale)
+ */
+static double AD779X_VChipInput(const tAD779X_VChip *pChip, uint8_t Channel, double Vin)
+{
+	double m_vref = pChip->ConfigReg.REFSEL ? AD779X_VCHIP_VREF_INT : pChip->VRefExt;
+	double m_gain = (double)(1 << pChip->ConfigReg.GAIN);
+	
+	switch (Channel)
+	{
+		/* temperature sensor: gain = 1, internal reference */
+		case chsTempSensor:
+			m_gain = 1.0;
+			m_vref = AD779X_VCHIP_VREF_INT;
+			break;
+		
+		/* AVDD monitor: gain = 1/6, internal reference */
+		case chsAVMonitor:
+			m_gain = 1.0 / 6.0;
+			m_vref = AD779X_VCHIP_VREF_INT;
+			break;
+		
+		case chsReserved0:
+		case chsReserved1:
+			Vin = 0.0;
+			break;
+	}
+	
+	return (Vin * m_gain + pChip->OffsetError) * (1.0 + pChip->GainError) / m_vref;
+}
+
+/**
+ * @brief  Get calibration pair (OFFSET/FULL-SCALE registers) of channel
+ * @param  Channel - channel
+ * @return Number of pair
+ */
+static uint8_t AD779X_VChipCalPair(uint8_t Channel)
+{
+	switch (Channel)
+	{
+		case chsAIN2: return 1;
+		case chsAIN3: return 2;
+		default:      return 0;
+	}
+}
+
+/**
+ * @brief  Get voltage on channel input at current time
+ * @param  pChip - virtual chip
+ * @param  Channel - channel
+ * @return Voltage, V
+ */
+static double AD779X_VChipSignal(tAD779X_VChip *pChip, uint8_t Channel)
+{
+	const tAD779X_VChipSignal *m_signal = &pChip->Signals[Channel & 7];
+	double m_time = (double)pChip->Now * 1e-9;
+	
+	return m_signal->Dc
+		+ m_signal->Amplitude * sin(2.0 * M_PI * m_signal->Frequency * m_time)
+		+ m_signal->Noise * AD779X_VChipRandom(pChip);
+}
+
+/**
+ * @brief  Make conversion of selected channel
+ * @param  pChip - virtual chip
+ * @return None
+ */
+static void AD779X_VChipConversion(tAD779X_VChip *pChip)
+{
+	uint8_t m_bits = AD779X_VChipBits(pChip);
+	uint8_t m_channel = pChip->ConfigReg.CHSEL;
+	uint8_t m_pair = AD779X_VChipCalPair(m_channel);
+	double m_half = (double)(1UL << (m_bits - 1));
+	double m_max = (double)((1UL << m_bits) - 1);
+	double m_offset = ((double)pChip->OffsetReg[m_pair] - m_half) / m_half;
+	double m_fscale = (double)pChip->FScaleReg[m_pair] / (double)((m_bits == 24) ? AD779X_FULLSCALE_RESET_24 : AD779X_FULLSCALE_RESET_16);
+	double m_value, m_code;
+	
+	m_value = (AD779X_VChipInput(pChip, m_channel, AD779X_VChipSignal(pChip, m_channel)) - m_offset) * m_fscale;
+	
+	if (pChip->ConfigReg.UB == ubUnipolar)
+		m_code = m_value * (m_max + 1.0);
+	else
+		m_code = (m_value + 1.0) * m_half;
+	
+	pChip->Status = (pChip->Model == ad7793) ? AD779X_SR_PID : 0;
+	pChip->Status |= m_channel;
+	
+	/* result is clamped: all 0s or all 1s */
+	if (m_code < 0.0)
+	{
+		m_code = 0.0;
+		pChip->Status |= AD779X_SR_ERR;
+	}
+	else if (m_code > m_max)
+	{
+		m_code = m_max;
+		pChip->Status |= AD779X_SR_ERR;
+	}
+	
+	/* new data, RDY -> 0 */
+	pChip->DataReg = (uint32_t)m_code;
+	pChip->Stats.Conversions++;
+}
+
+/**
+ * @brief  Make calibration
+ * @param  pChip - virtual chip
+ * @param  Mode - calibration mode
+ * @return None
+ */
+static void AD779X_VChipCalibration(tAD779X_VChip *pChip, uint8_t Mode)
+{
+	uint8_t m_bits = AD779X_VChipBits(pChip);
+	uint8_t m_channel = pChip->ConfigReg.CHSEL;
+	uint8_t m_pair = AD779X_VChipCalPair(m_channel);
+	double m_half = (double)(1UL << (m_bits - 1));
+	double m_fs_reset = (double)((m_bits == 24) ? AD779X_FULLSCALE_RESET_24 : AD779X_FULLSCALE_RESET_16);
+	double m_vref = pChip->ConfigReg.REFSEL ? AD779X_VCHIP_VREF_INT : pChip->VRefExt;
+	double m_vin, m_value;
+	
+	switch (Mode)
+	{
+		/* zero-scale: inputs shorted internally or zero applied by system */
+		case mdsIntZeroCal:
+		case mdsSysZeroCal:
+			m_vin = (Mode == mdsIntZeroCal) ? 0.0 : AD779X_VChipSignal(pChip, m_channel);
+			m_value = AD779X_VChipInput(pChip, m_channel, m_vin) * m_half + m_half;
+			pChip->OffsetReg[m_pair] = (uint32_t)(m_value + 0.5);
+			break;
+		
+		/* full-scale: reference on inputs or full scale applied by system */
+		case mdsIntFullCal:
+		case mdsSysFullCal:
+			m_vin = (Mode == mdsIntFullCal) ? m_vref / (double)(1 << pChip->ConfigReg.GAIN) : AD779X_VChipSignal(pChip, m_channel);
+			m_value = AD779X_VChipInput(pChip, m_channel, m_vin) - ((double)pChip->OffsetReg[m_pair] - m_half) / m_half;
+			if (m_value > 0.0)
+				pChip->FScaleReg[m_pair] = (uint32_t)(m_fs_reset / m_value + 0.5);
+			break;
+	}
+	
+	pChip->Status = ((pChip->Model == ad7793) ? AD779X_SR_PID : 0) | m_channel;
+}
+
+/**
+ * @brief  Get conversion period of chip: same as driver (AD779X_ConversionTimeUs)
+ * @param  pChip - virtual chip
+ * @return Conversion period t_adc, ns (0 - fsNone)
+ */
+static uint64_t AD779X_VChipPeriod(const tAD779X_VChip *pChip)
+{
+	return (uint64_t)AD779X_ConversionTimeUs((tAD779X_FilterSelect)pChip->ModeReg.FS, (tAD779X_ClkSourceSelect)pChip->ModeReg.CLKS) * 1000;
+}
+
+/**
+ * @brief  Start operation selected in MODE register
+ * @param  pChip - virtual chip
+ * @param  PrevMode - mode before (power-down: oscillator and modulator power up first)
+ * @return None
+ */
+static void AD779X_VChipStart(tAD779X_VChip *pChip, uint8_t PrevMode)
+{
+	uint64_t m_period = AD779X_VChipPeriod(pChip);
+	uint64_t m_power_up = (PrevMode == mdsPowerDown) ? (uint64_t)AD779X_POWER_UP_US * 1000 : 0;
+	
+	switch (pChip->ModeReg.MODE)
+	{
+		case mdsIdle:
+		case mdsPowerDown:
+			pChip->NextEvent = 0;
+			break;
+		
+		default:
+			/* first result after power-up and filter settling: 2 * t_adc */
+			pChip->NextEvent = m_period ? pChip->Now + m_power_up + 2 * m_period : 0;
+			break;
+	}
+	
+	pChip->Status |= AD779X_SR_RDY;
+}
+
+/**
+ * @brief  Process conversions completed up to current time
+ * @param  pChip - virtual chip
+ * @return None
+ */
+static void AD779X_VChipUpdate(tAD779X_VChip *pChip)
+{
+	uint64_t m_now = pChip->Now;
+	
+	while (pChip->NextEvent && (pChip->NextEvent <= m_now))
+	{
+		/* signal is sampled at time of conversion result */
+		pChip->Now = pChip->NextEvent;
+		
+		switch (pChip->ModeReg.MODE)
+		{
+			case mdsContinuous:
+				AD779X_VChipConversion(pChip);
+				pChip->NextEvent += AD779X_VChipPeriod(pChip);
+				break;
+			
+			/* after single conversion chip goes to power-down */
+			case mdsSingle:
+				AD779X_VChipConversion(pChip);
+				pChip->ModeReg.MODE = AD779X_MODE_AFTER_ONESHOT(mdsSingle);
+				pChip->NextEvent = 0;
+				break;
+			
+			/* after calibration chip goes to idle */
+			default:
+				AD779X_VChipCalibration(pChip, pChip->ModeReg.MODE);
+				pChip->ModeReg.MODE = AD779X_MODE_AFTER_ONESHOT(pChip->ModeReg.MODE);
+				pChip->NextEvent = 0;
+				break;
+		}
+	}
+	
+	pChip->Now = m_now;
+}
+
+/**
+ * @brief  Move virtual time forward
+ * @param  pChip - virtual chip
+ * @param  Ns - time, ns
+ * @return None
+ */
+void AD779X_VChipAdvance(tAD779X_VChip *pChip, uint64_t Ns)
+{
+	pChip->Now += Ns;
+	
+	AD779X_VChipUpdate(pChip);
+}
+
+/**
+ * @brief  Get time of virtual chip (device GetTimeUs callback)
+ * @param  pChip - virtual chip
+ * @return Time, us
+ */
+uint32_t AD779X_VChipTimeUs(tAD779X_VChip *pChip)
+{
+	return (uint32_t)(pChip->Now / 1000);
+}
+
+/**
+ * @brief  Sleep: advance time of virtual chip (device DelayUs callback)
+ * @param  pChip - virtual chip
+ * @param  Us - time, us
+ * @return None
+ */
+void AD779X_VChipDelayUs(tAD779X_VChip *pChip, uint32_t Us)
+{
+	AD779X_VChipAdvance(pChip, (uint64_t)Us * 1000);
+}
+
+/**
+ * @brief  Reset virtual chip registers (as power-on or 32 ones on DIN)
+ * @param  pChip - virtual chip
+ * @return None
+ */
+void AD779X_VChipReset(tAD779X_VChip *pChip)
+{
+	uint8_t m_bits = AD779X_VChipBits(pChip);
+	uint8_t i;
+	
+	pChip->ModeReg.DATA   = AD779X_RDV_MODE;
+	pChip->ConfigReg.DATA = AD779X_RDV_CONFIG;
+	pChip->IOReg.DATA     = AD779X_RDV_IO;
+	
+	for (i = 0; i < 3; i++)
+	{
+		pChip->OffsetReg[i] = (m_bits == 24) ? AD779X_OFFSET_RESET_24 : AD779X_OFFSET_RESET_16;
+		pChip->FScaleReg[i] = (m_bits == 24) ? AD779X_FULLSCALE_RESET_24 : AD779X_FULLSCALE_RESET_16;
+	}
+	
+	pChip->DataReg   = 0;
+	pChip->Status    = AD779X_SR_RDY | ((pChip->Model == ad7793) ? AD779X_SR_PID : 0);
+	
+	pChip->Continuous = 0;
+	pChip->DataSize   = 0;
+	pChip->Ones       = 0;
+	
+	AD779X_VChipStart(pChip, pChip->ModeReg.MODE);
+}
+
+/**
+ * @brief  Init virtual chip: registers in reset state, no signals
+ * @param  pChip - virtual chip
+ * @param  Model - ad7792 or ad7793
+ * @return None
+ */
+void AD779X_VChipInit(tAD779X_VChip *pChip, tAD779X_Model Model)
+{
+	memset(pChip, 0, sizeof(*pChip));
+	
+	pChip->Model   = Model;
+	pChip->VRefExt = 2.5;
+	pChip->VAvdd   = 3.3;
+	pChip->SclkHz  = 1000000;
+	pChip->PollNs  = 1000;
+	pChip->Seed    = 0x12345678;
+	
+	/* temperature sensor: 0.81 mV/K, 25 C */
+	pChip->Signals[chsTempSensor].Dc = 0.00081 * 298.15;
+	
+	AD779X_VChipReset(pChip);
+	
+	/* AVDD monitor */
+	pChip->Signals[chsAVMonitor].Dc = pChip->VAvdd;
+}
+
+/**
+ * @brief  Change cs line
+ * @param  pChip - virtual chip
+ * @param  State - cssEnable or cssDisable
+ * @return None
+ */
+void AD779X_VChipSelect(tAD779X_VChip *pChip, unsigned char State)
+{
+	pChip->Stats.CSToggles++;
+	pChip->Selected = (State == cssEnable);
+	
+	/* new frame starts with command (serial interface is framed by cs) */
+	if (pChip->Selected && !pChip->Continuous)
+		pChip->DataSize = 0;
+	
+	AD779X_VChipUpdate(pChip);
+}
+
+/**
+ * @brief  Load register value for read
+ * @param  pChip - virtual chip
+ * @param  Reg - register address
+ * @return None
+ */
+static void AD779X_VChipLoad(tAD779X_VChip *pChip, uint8_t Reg)
+{
+	uint32_t m_value;
+	uint8_t i;
+	
+	switch (Reg)
+	{
+		case AD779X_REG_STATUS: m_value = pChip->Status; break;
+		case AD779X_REG_MODE:   m_value = pChip->ModeReg.DATA; break;
+		case AD779X_REG_CONFIG: m_value = pChip->ConfigReg.DATA; break;
+		case AD779X_REG_DATA:   m_value = pChip->DataReg; break;
+		case AD779X_REG_ID:     m_value = (pChip->Model == ad7793) ? AD779X_VCHIP_ID_AD7793 : AD779X_VCHIP_ID_AD7792; break;
+		case AD779X_REG_IO:     m_value = pChip->IOReg.DATA; break;
+		case AD779X_REG_OFFSET: m_value = pChip->OffsetReg[AD779X_VChipCalPair(pChip->ConfigReg.CHSEL)]; break;
+		default:                m_value = pChip->FScaleReg[AD779X_VChipCalPair(pChip->ConfigReg.CHSEL)]; break;
+	}
+	
+	pChip->Cmd      = AD779X_COMM_RMODE | Reg;
+	pChip->DataSize = AD779X_VChipRegSize(pChip, Reg);
+	pChip->DataPos  = 0;
+	
+	for (i = 0; i < pChip->DataSize; i++)
+		pChip->Data[i] = m_value >> (8 * (pChip->DataSize - 1 - i));
+}
+
+/**
+ * @brief  Store written register value
+ * @param  pChip - virtual chip
+ * @return None
+ */
+static void AD779X_VChipStore(tAD779X_VChip *pChip)
+{
+	uint32_t m_value = 0;
+	uint8_t i, m_mode;
+	
+	for (i = 0; i < pChip->DataSize; i++)
+		m_value = (m_value << 8) | pChip->Data[i];
+	
+	switch (pChip->Cmd & AD779X_COMM_CMACK & ~AD779X_COMM_CREED)
+	{
+		case AD779X_WRR_MODE:
+			m_mode = pChip->ModeReg.MODE;
+			pChip->ModeReg.DATA = m_value & AD779X_MODE_COM;
+			AD779X_VChipStart(pChip, m_mode);
+			break;
+		
+		case AD779X_WRR_CONFIG:
+			pChip->ConfigReg.DATA = m_value & AD779X_CONFIG_COM;
+			
+			/* filter is reset by config change */
+			if (pChip->ModeReg.MODE == mdsContinuous)
+				AD779X_VChipStart(pChip, pChip->ModeReg.MODE);
+			break;
+		
+		case AD779X_WRR_IO:
+			pChip->IOReg.DATA = m_value & AD779X_IO_COM;
+			break;
+		
+		case AD779X_WRR_OFFSET:
+			pChip->OffsetReg[AD779X_VChipCalPair(pChip->ConfigReg.CHSEL)] = m_value;
+			break;
+		
+		case AD779X_WRR_FSCLAE:
+			/* FULL-SCALE register is written only in Idle or Power-down mode */
+			if ((pChip->ModeReg.MODE == mdsIdle) || (pChip->ModeReg.MODE == mdsPowerDown))
+				pChip->FScaleReg[AD779X_VChipCalPair(pChip->ConfigReg.CHSEL)] = m_value;
+			break;
+	}
+}
+
+/**
+ * @brief  Exchange one byte (full-duplex)
+ * @param  pChip - virtual chip
+ * @param  Data - byte on DIN
+ * @return Byte on DOUT
+ */
+uint8_t AD779X_VChipExchange(tAD779X_VChip *pChip, uint8_t Data)
+{
+	uint8_t m_out = 0xFF;
+	uint8_t m_reg;
+	
+	pChip->Stats.Bytes++;
+	AD779X_VChipAdvance(pChip, 8000000000ULL / pChip->SclkHz);
+	
+	if (!pChip->Selected)
+		return m_out;
+	
+	/* 32 ones on DIN: reset */
+	pChip->Ones = (Data == 0xFF) ? pChip->Ones + 1 : 0;
+	if (pChip->Ones >= 4)
+	{
+		AD779X_VChipReset(pChip);
+		return m_out;
+	}
+	
+	/* continuous read: data is clocked out on RDY without command */
+	if (pChip->Continuous && !pChip->DataSize && !(pChip->Status & AD779X_SR_RDY))
+	{
+		AD779X_VChipLoad(pChip, AD779X_REG_DATA);
+		
+		/* 0x58 on DIN exits continuous read, data is read as usual */
+		if (Data == AD779X_RDR_DATA)
+		{
+			pChip->Continuous = 0;
+			return 0x00;
+		}
+	}
+	
+	if (pChip->DataSize)
+	{
+		/* data phase */
+		if (pChip->Cmd & AD779X_COMM_RMODE)
+			m_out = pChip->Data[pChip->DataPos];
+		else
+			pChip->Data[pChip->DataPos] = Data;
+		
+		if (++pChip->DataPos >= pChip->DataSize)
+		{
+			if (pChip->Cmd & AD779X_COMM_RMODE)
+			{
+				/* data register is read: RDY -> 1 */
+				if ((pChip->Cmd & AD779X_COMM_CMACK & ~AD779X_COMM_CREED) == AD779X_RDR_DATA)
+					pChip->Status |= AD779X_SR_RDY;
+			}
+			else
+			{
+				AD779X_VChipStore(pChip);
+			}
+			
+			pChip->DataSize = 0;
+		}
+		
+		return m_out;
+	}
+	
+	/* in continuous read mode only 0x58 is accepted */
+	if (pChip->Continuous)
+		return m_out;
+	
+	/* communications register: WEN must be 0 */
+	if (Data & 0x80)
+		return m_out;
+	
+	m_reg = Data & (7 << 3);
+	
+	if (Data & AD779X_COMM_RMODE)
+	{
+		if ((m_reg == AD779X_REG_DATA) && (Data & AD779X_COMM_CREED))
+			pChip->Continuous = 1;
+		else
+			AD779X_VChipLoad(pChip, m_reg);
+	}
+	else if ((m_reg != AD779X_REG_COMM) && (m_reg != AD779X_REG_DATA) && (m_reg != AD779X_REG_ID))
+	{
+		pChip->Cmd      = Data & AD779X_COMM_CMACK;
+		pChip->DataSize = AD779X_VChipRegSize(pChip, m_reg);
+		pChip->DataPos  = 0;
+	}
+	
+	return m_out;
+}
+
+/**
+ * @brief  Exchange block of bytes (full-duplex)
+ * @param  pChip - virtual chip
+ * @param  pTxData - bytes on DIN
+ * @param  pRxData - bytes on DOUT
+ * @param  Size - size of block
+ * @return None
+ */
+void AD779X_VChipBlock(tAD779X_VChip *pChip, const uint8_t *pTxData, uint8_t *pRxData, size_t Size)
+{
+	size_t i;
+	
+	pChip->Stats.Blocks++;
+	
+	for (i = 0; i < Size; i++)
+		pRxData[i] = AD779X_VChipExchange(pChip, pTxData[i]);
+}
+
+/**
+ * @brief  Get state of DOUT/RDY line
+ * @param  pChip - virtual chip
+ * @return rdsFree - data ready, rdsBusy - not ready or cs line inactive
+ */
+unsigned char AD779X_VChipRDY(tAD779X_VChip *pChip)
+{
+	pChip->Stats.RDYPolls++;
+	AD779X_VChipAdvance(pChip, pChip->PollNs);
+	
+	if (!pChip->Selected)
+		return rdsBusy;
+	
+	return (pChip->Status & AD779X_SR_RDY) ? rdsBusy : rdsFree;
+}
+
+/* Callbacks of slot n: device callbacks have no context, so each slot has own functions */
+#define AD779X_VCHIP_SLOT(n) \
+static void AD779X_VChipCS##n(unsigned char State) \
+{ gVChipSlots[n]->Stats.Callbacks++; AD779X_VChipSelect(gVChipSlots[n], State); } \
+static void AD779X_VChipTx##n(unsigned char Data) \
+{ gVChipSlots[n]->Stats.Callbacks++; AD779X_VChipExchange(gVChipSlots[n], Data); } \
+static unsigned char AD779X_VChipRx##n(void) \
+{ gVChipSlots[n]->Stats.Callbacks++; return AD779X_VChipExchange(gVChipSlots[n], 0x00); } \
+static unsigned char AD779X_VChipRDY##n(void) \
+{ gVChipSlots[n]->Stats.Callbacks++; return AD779X_VChipRDY(gVChipSlots[n]); } \
+static void AD779X_VChipBlock##n(const uint8_t *pTxData, uint8_t *pRxData, size_t Size) \
+{ gVChipSlots[n]->Stats.Callbacks++; AD779X_VChipBlock(gVChipSlots[n], pTxData, pRxData, Size); } \
+static uint32_t AD779X_VChipTimeUs##n(void) \
+{ return AD779X_VChipTimeUs(gVChipSlots[n]); } \
+static void AD779X_VChipDelayUs##n(uint32_t Us) \
+{ AD779X_VChipDelayUs(gVChipSlots[n], Us); }
+
+AD779X_VCHIP_SLOT(0)  AD779X_VCHIP_SLOT(1)  AD779X_VCHIP_SLOT(2)  AD779X_VCHIP_SLOT(3)
+AD779X_VCHIP_SLOT(4)  AD779X_VCHIP_SLOT(5)  AD779X_VCHIP_SLOT(6)  AD779X_VCHIP_SLOT(7)
+AD779X_VCHIP_SLOT(8)  AD779X_VCHIP_SLOT(9)  AD779X_VCHIP_SLOT(10) AD779X_VCHIP_SLOT(11)
+AD779X_VCHIP_SLOT(12) AD779X_VCHIP_SLOT(13) AD779X_VCHIP_SLOT(14) AD779X_VCHIP_SLOT(15)
+
+#define AD779X_VCHIP_CALLBACKS(n) \
+	{AD779X_VChipCS##n, AD779X_VChipTx##n, AD779X_VChipRx##n, AD779X_VChipRDY##n, AD779X_VChipBlock##n, \
+	 AD779X_VChipTimeUs##n, AD779X_VChipDelayUs##n}
+
+/* Callbacks of slots */
+static const struct
+{
+	tAD779X_CSControl CSControl;
+	tAD779X_TxByte TxByte;
+	tAD779X_RxByte RxByte;
+	tAD779X_RDYState RDYState;
+	tAD779X_TxRxBlock TxRxBlock;
+	tAD779X_GetTimeUs GetTimeUs;
+	tAD779X_DelayUs DelayUs;
+} gVChipCallbacks[16] =
+{
+	AD779X_VCHIP_CALLBACKS(0),  AD779X_VCHIP_CALLBACKS(1),  AD779X_VCHIP_CALLBACKS(2),  AD779X_VCHIP_CALLBACKS(3),
+	AD779X_VCHIP_CALLBACKS(4),  AD779X_VCHIP_CALLBACKS(5),  AD779X_VCHIP_CALLBACKS(6),  AD779X_VCHIP_CALLBACKS(7),
+	AD779X_VCHIP_CALLBACKS(8),  AD779X_VCHIP_CALLBACKS(9),  AD779X_VCHIP_CALLBACKS(10), AD779X_VCHIP_CALLBACKS(11),
+	AD779X_VCHIP_CALLBACKS(12), AD779X_VCHIP_CALLBACKS(13), AD779X_VCHIP_CALLBACKS(14), AD779X_VCHIP_CALLBACKS(15)
+};
+
+/**
+ * @brief  Attach virtual chip to device: set device callbacks
+ * @param  pChip - virtual chip
+ * @param  pDevice - device
+ * @param  UseBlock - set TxRxBlock callback too
+ * @return Number of slot or 0xFF, if no free slot
+ */
+uint8_t AD779X_VChipAttach(tAD779X_VChip *pChip, tAD779X_Device *pDevice, uint8_t UseBlock)
+{
+	uint8_t i;
+	
+	for (i = 0; (i < AD779X_VCHIP_SLOTS) && (i < 16); i++)
+	{
+		if (gVChipSlots[i] == 0)
+		{
+			gVChipSlots[i] = pChip;
+			
+			pDevice->CSControl = gVChipCallbacks[i].CSControl;
+			pDevice->TxByte    = gVChipCallbacks[i].TxByte;
+			pDevice->RxByte    = gVChipCallbacks[i].RxByte;
+			pDevice->RDYState  = gVChipCallbacks[i].RDYState;
+			pDevice->TxRxBlock = UseBlock ? gVChipCallbacks[i].TxRxBlock : 0;
+			pDevice->GetTimeUs = gVChipCallbacks[i].GetTimeUs;
+			pDevice->DelayUs   = gVChipCallbacks[i].DelayUs;
+			
+			return i;
+		}
+	}
+	
+	return 0xFF;
+}
+
+/**
+ * @brief  Free slots of virtual chip
+ * @param  pChip - virtual chip
+ * @return None
+ */
+void AD779X_VChipDetach(tAD779X_VChip *pChip)
+{
+	uint8_t i;
+	
+	for (i = 0; i < AD779X_VCHIP_SLOTS; i++)
+	{
+		if (gVChipSlots[i] == pChip)
+			gVChipSlots[i] = 0;
+	}
+}
@@ -0,0 +1,104 @@
+/**
+  ******************************************************************************
+  * @file    ad779x_vchip.h
+  * @author  Khusainov Timur
+  * @version 0.0.0.1
+  * @date    16.10.2026
+  * @brief   Virtual AD7792/AD7793: software model of ADC for host (PC) side
+  ******************************************************************************
+  * @attention
+  * <h2><center>&copy; COPYRIGHT 2011 timypik@gmail.com </center></h2>
+  ******************************************************************************
+  */
+
+#ifndef AD779X_VCHIP_H
+#define AD779X_VCHIP_H
+
+#include "ad779x.h"
+
+/**
+ * @brief Count of virtual chips, that can be attached to devices at same time
+ */
+#ifndef AD779X_VCHIP_SLOTS
+#define AD779X_VCHIP_SLOTS 16
+#endif
+
+/**
+ * @brief Internal reference voltage, V
+ */
+#define AD779X_VCHIP_VREF_INT 1.17
+
+/**
+ * @brief Synthetic signal on channel input: Dc + Amplitude*sin(2*pi*Frequency*t) + noise
+ */
+typedef struct
+{
+	double Dc;        /*!< DC level, V */
+	double Amplitude; /*!< Sine amplitude, V */
+	double Frequency; /*!< Sine frequency, Hz */
+	double Noise;     /*!< Uniform noise peak value, V */
+} tAD779X_VChipSignal;
+
+/**
+ * @brief Virtual chip statistics
+ */
+typedef struct
+{
+	unsigned long Callbacks;   /*!< count of callback calls */
+	unsigned long CSToggles;   /*!< count of cs line changes */
+	unsigned long Bytes;       /*!< count of bytes on SPI bus */
+	unsigned long Blocks;      /*!< count of block transfers */
+	unsigned long RDYPolls;    /*!< count of RDY line reads */
+	unsigned long Conversions; /*!< count of completed conversions */
+} tAD779X_VChipStats;
+
+/**
+ * @brief Virtual chip state
+ */
+typedef struct
+{
+	tAD779X_Model Model;                /*!< ad7792 or ad7793 */
+	double VRefExt;                     /*!< External reference REFIN(+) - REFIN(-), V */
+	double VAvdd;                       /*!< AVDD, V (AV monitor channel) */
+	double OffsetError;                 /*!< Offset error of modulator, V (referred to input at gain 1) */
+	double GainError;                   /*!< Gain error of modulator, part of full scale */
+	tAD779X_VChipSignal Signals[8];     /*!< Signal of each channel (tAD779X_ChSelect) */
+	
+	tAD779X_ModeRegister ModeReg;       /*!< MODE register */
+	tAD779X_ConfigRegister ConfigReg;   /*!< CONFIG register */
+	tAD779X_IORegister IOReg;           /*!< IO register */
+	uint32_t OffsetReg[3];              /*!< OFFSET registers (of calibration pairs) */
+	uint32_t FScaleReg[3];              /*!< FULL-SCALE registers (of calibration pairs) */
+	uint32_t DataReg;                   /*!< DATA register */
+	uint8_t  Status;                    /*!< STATUS register */
+	
+	uint8_t  Selected;                  /*!< cs line is active */
+	uint8_t  Continuous;                /*!< continuous read mode */
+	uint8_t  Cmd;                       /*!< command of current data phase */
+	uint8_t  DataSize;                  /*!< size of current data phase, 0 - wait command */
+	uint8_t  DataPos;                   /*!< position in current data phase */
+	uint8_t  Data[4];                   /*!< data of current phase */
+	uint8_t  Ones;                      /*!< count of sequential 0xFF bytes: 4 - reset */
+	
+	uint64_t Now;                       /*!< Virtual time, ns */
+	uint64_t NextEvent;                 /*!< Time of next conversion result, ns (0 - none) */
+	unsigned long SclkHz;               /*!< SPI clock, each byte moves virtual time */
+	unsigned long PollNs;               /*!< Virtual time of one RDY line read, ns */
+	uint32_t Seed;                      /*!< Noise generator state */
+	
+	tAD779X_VChipStats Stats;           /*!< Statistics */
+} tAD779X_VChip;
+
+void AD779X_VChipInit(tAD779X_VChip *pChip, tAD779X_Model Model);
+void AD779X_VChipReset(tAD779X_VChip *pChip);
+void AD779X_VChipSelect(tAD779X_VChip *pChip, unsigned char State);
+uint8_t AD779X_VChipExchange(tAD779X_VChip *pChip, uint8_t Data);
+void AD779X_VChipBlock(tAD779X_VChip *pChip, const uint8_t *pTxData, uint8_t *pRxData, size_t Size);
+unsigned char AD779X_VChipRDY(tAD779X_VChip *pChip);
+void AD779X_VChipAdvance(tAD779X_VChip *pChip, uint64_t Ns);
+uint32_t AD779X_VChipTimeUs(tAD779X_VChip *pChip);
+void AD779X_VChipDelayUs(tAD779X_VChip *pChip, uint32_t Us);
+uint8_t AD779X_VChipAttach(tAD779X_VChip *pChip, tAD779X_Device *pDevice, uint8_t UseBlock);
+void AD779X_VChipDetach(tAD779X_VChip *pChip);
+
+#endif
@@ -0,0 +1,236 @@
+/**
+  ******************************************************************************
+  * @file    ad779x_vchip_test.c
+  * @author  Khusainov Timur
+  * @version 0.0.0.1
+  * @date    16.10.2026
+  * @brief   AD7792/AD7793 driver: regression test of driver against virtual chip
+  ******************************************************************************
+  * @attention
+  * <h2><center>&copy; COPYRIGHT 2011 timypik@gmail.com </center></h2>
+  ******************************************************************************
+  *
+  * Build for each variant of driver, e.g.:
+  *   cc -O2 -I../ad779x_single ad779x_vchip_test.c ad779x_vchip.c ../ad779x_single/ad779x.c -lm -o ad779x_vchip_test_single
+  *   cc -O2 -I../ad779x_multiple ad779x_vchip_test.c ad779x_vchip.c ../ad779x_multiple/ad779x.c -lm -o ad779x_vchip_test_multiple
+  *
+  * Register images of driver must be same as registers of chip after each
+  * operation: init, single conversion (chip goes to power-down), calibration
+  * (chip goes to idle), single shots, calibration restore, exit of continuous
+  * read (chip is reset if RDY does not come) and reset. Time of first result
+  * from power-down has power-up time. Exit code is count of failed checks.
+  */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "ad779x_vchip.h"
+
+#if defined(AD779X_VARIANT_SINGLE)
+tAD779X_Device ADCDevice;
+#define AD779X_TEST_VARIANT "single"
+#define DEV
+#define DEV_
+#define pTestDevice (&ADCDevice)
+#else
+static tAD779X_Device gTestDevice;
+#define AD779X_TEST_VARIANT "multiple"
+#define DEV  &gTestDevice
+#define DEV_ &gTestDevice,
+#define pTestDevice (&gTestDevice)
+#endif
+
+/* Virtual chip under test */
+static tAD779X_VChip gChip;
+
+/* Count of failed checks */
+static unsigned int gFails;
+
+#define AD779X_TEST_CHECK(Cond) TestCheck((Cond), #Cond, __LINE__)
+
+/**
+ * @brief  Count and print failed check
+ * @param  Cond - result of check
+ * @param  pText - text of check
+ * @param  Line - line of check
+ * @return None
+ */
+static void TestCheck(int Cond, const char *pText, int Line)
+{
+	if (Cond)
+		return;
+	
+	gFails++;
+	printf("  FAIL line %d: %s\n", Line, pText);
+}
+
+/**
+ * @brief  Check register images of driver against registers of chip
+ * @param  Line - line of check
+ * @return None
+ */
+static void TestSynced(int Line)
+{
+	TestCheck(pTestDevice->ModeReg.DATA == gChip.ModeReg.DATA, "MODE image == chip MODE", Line);
+	TestCheck(pTestDevice->ConfigReg.DATA == gChip.ConfigReg.DATA, "CONFIG image == chip CONFIG", Line);
+	TestCheck(pTestDevice->IOReg.DATA == gChip.IOReg.DATA, "IO image == chip IO", Line);
+}
+
+#define AD779X_TEST_SYNCED() TestSynced(__LINE__)
+
+/**
+ * @brief  Start single conversion from mode and wait for RDY
+ * @param  Mode - mode before conversion
+ * @return Time from start to RDY, us
+ */
+static uint32_t TestSingleTime(tAD779X_ModeSelect Mode)
+{
+	uint32_t m_start;
+	
+	AD779X_SetMode(DEV_ Mode);
+	
+	m_start = AD779X_VChipTimeUs(&gChip);
+	AD779X_SetMode(DEV_ mdsSingle);
+	
+	while (!AD779X_CheckReadyHW(DEV));
+	
+	return AD779X_VChipTimeUs(&gChip) - m_start;
+}
+
+/**
+ * @brief  Run checks on model
+ * @param  Model - model of virtual chip
+ * @param  UseBlock - use TxRxBlock callback
+ * @return None
+ */
+static void TestModel(tAD779X_Model Model, uint8_t UseBlock)
+{
+	const uint32_t m_settle = AD779X_SettlingTimeUs(fs500, cssInt);
+	tAD779X_CalEntry m_cal, m_back;
+	tAD779X_ShotStats m_shot;
+	unsigned long m_sample;
+	unsigned int m_fails = gFails;
+	uint32_t m_time;
+	
+	AD779X_VChipDetach(&gChip);
+	AD779X_VChipInit(&gChip, Model);
+	gChip.Signals[chsAIN1].Dc = 0.5;
+	
+	memset(pTestDevice, 0, sizeof(*pTestDevice));
+	memset(&m_shot, 0, sizeof(m_shot));
+	AD779X_VChipAttach(&gChip, pTestDevice, UseBlock);
+	
+	/* init */
+	AD779X_Reset(DEV);
+	AD779X_Init(DEV);
+	
+	AD779X_TEST_CHECK(pTestDevice->SuState == susActivate);
+	AD779X_TEST_SYNCED();
+	
+	AD779X_SetGain(DEV_ gain1);
+	AD779X_SetReference(DEV_ refInt);
+	AD779X_SetChannel(DEV_ chsAIN1);
+	AD779X_SetUpdateRate(DEV_ fs500);
+	AD779X_TEST_SYNCED();
+	
+	/* single conversion: chip goes to power-down */
+	AD779X_SetMode(DEV_ mdsSingle);
+	AD779X_TEST_CHECK(AD779X_WaitReady(DEV_ 100000));
+	m_sample = AD779X_ReadDataSample24(DEV);
+	
+	AD779X_TEST_CHECK(m_sample > 0x800000UL);
+	AD779X_TEST_CHECK(gChip.ModeReg.MODE == mdsPowerDown);
+	AD779X_TEST_SYNCED();
+	
+	/* power-up: first result from power-down is later by power-up time */
+	m_time = TestSingleTime(mdsPowerDown);
+	AD779X_TEST_CHECK(m_time >= AD779X_POWER_UP_US + m_settle);
+	
+	m_time = TestSingleTime(mdsIdle);
+	AD779X_TEST_CHECK(m_time >= m_settle);
+	AD779X_TEST_CHECK(m_time < AD779X_POWER_UP_US + m_settle);
+	AD779X_TEST_SYNCED();
+	
+	/* calibration: chip goes to idle */
+	AD779X_StartZSCalibration(DEV);
+	AD779X_TEST_CHECK(AD779X_WaitReady(DEV_ 1000000));
+	AD779X_TEST_CHECK(gChip.ModeReg.MODE == mdsIdle);
+	AD779X_TEST_SYNCED();
+	
+	AD779X_StartFSCalibration(DEV);
+	AD779X_TEST_CHECK(AD779X_WaitReady(DEV_ 1000000));
+	AD779X_TEST_CHECK(gChip.ModeReg.MODE == mdsIdle);
+	AD779X_TEST_SYNCED();
+	
+	/* single shots: policy is mode of chip after shot */
+	AD779X_TEST_CHECK(AD779X_SingleShot(DEV_ chsAIN1, gain1, fs500, sspPowerDown, &m_sample, &m_shot));
+	AD779X_TEST_CHECK(gChip.ModeReg.MODE == mdsPowerDown);
+	AD779X_TEST_SYNCED();
+	
+	AD779X_TEST_CHECK(AD779X_SingleShot(DEV_ chsAIN1, gain1, fs500, sspIdle, &m_sample, &m_shot));
+	AD779X_TEST_CHECK(m_shot.LastUs >= AD779X_POWER_UP_US + m_settle);
+	AD779X_TEST_CHECK(gChip.ModeReg.MODE == mdsIdle);
+	AD779X_TEST_SYNCED();
+	
+	AD779X_TEST_CHECK(AD779X_SingleShot(DEV_ chsAIN1, gain1, fs500, sspIdle, &m_sample, &m_shot));
+	AD779X_TEST_CHECK(m_shot.LastUs < AD779X_POWER_UP_US + m_settle);
+	AD779X_TEST_SYNCED();
+	
+	/* calibration restore in continuous mode: registers of chip, mode goes on */
+	AD779X_SetMode(DEV_ mdsContinuous);
+	AD779X_ReadCalibration(DEV_ &m_cal);
+	
+	m_cal.Offset ^= 0x10;
+	m_cal.FScale ^= 0x20;
+	m_cal.Rate    = fs250;
+	
+	AD779X_WriteCalibration(DEV_ &m_cal);
+	AD779X_ReadCalibration(DEV_ &m_back);
+	
+	AD779X_TEST_CHECK(m_back.Offset == m_cal.Offset);
+	AD779X_TEST_CHECK(m_back.FScale == m_cal.FScale);
+	AD779X_TEST_CHECK(gChip.ModeReg.MODE == mdsContinuous);
+	AD779X_TEST_CHECK(gChip.ModeReg.FS == fs250);
+	AD779X_TEST_SYNCED();
+	
+	/* continuous read: last sample on exit */
+	AD779X_StartContinuousRead(DEV);
+	AD779X_TEST_CHECK(AD779X_ReadContinuousSample24(DEV) != AD779X_SAMPLE_TIMEOUT);
+	AD779X_TEST_CHECK(AD779X_StopContinuousRead(DEV) != AD779X_SAMPLE_TIMEOUT);
+	AD779X_TEST_CHECK(!gChip.Continuous);
+	AD779X_TEST_SYNCED();
+	
+	/* exit of continuous read on idle chip: no RDY, so chip is reset */
+	AD779X_SetMode(DEV_ mdsIdle);
+	AD779X_StartContinuousRead(DEV);
+	AD779X_TEST_CHECK(AD779X_StopContinuousRead(DEV) == AD779X_SAMPLE_TIMEOUT);
+	AD779X_TEST_CHECK(!gChip.Continuous);
+	AD779X_TEST_CHECK(pTestDevice->ReadMode == rdmSingle);
+	AD779X_TEST_SYNCED();
+	
+	/* next write is taken by chip */
+	AD779X_SetGain(DEV_ gain2);
+	AD779X_TEST_CHECK(gChip.ConfigReg.GAIN == gain2);
+	AD779X_TEST_SYNCED();
+	
+	/* reset: images are reset values of chip */
+	AD779X_Reset(DEV);
+	AD779X_TEST_SYNCED();
+	
+	printf("%s, %s: %s\n", (Model == ad7793) ? "AD7793" : "AD7792", UseBlock ? "TxRxBlock" : "TxByte/RxByte",
+		(gFails == m_fails) ? "ok" : "FAIL");
+}
+
+int main(void)
+{
+	printf("virtual chip test, driver variant: %s\n", AD779X_TEST_VARIANT);
+	
+	TestModel(ad7792, 0);
+	TestModel(ad7792, 1);
+	TestModel(ad7793, 0);
+	TestModel(ad7793, 1);
+	
+	printf("%u failed checks\n", gFails);
+	
+	return (gFails != 0);
+}
@@ -31,6 +31,346 @@ const tAD779X_ModeRegister gModeReg =
 	.UNUSED1 = 0         /*!< must be clear */
 };
 
+/* Reset state of CONFIG register */
+const tAD779X_ConfigRegister gConfigReg =
+{
+	.VBIAS   = biasNone,   /*!< bias voltage generator disabled */
+	.BO      = boDisable,  /*!< burnout currents disabled */
+	.UB      = ubBipolar,  /*!< bipolar coding */
+	.BOOST   = boostDisable,
+	.GAIN    = gain128,    /*!< gain 128 */
+	.REFSEL  = refExt,     /*!< external reference */
+	.BUF     = bufEnable,  /*!< buffered mode */
+	.CHSEL   = chsAIN1,    /*!< AIN1(+) - AIN1(-) */
+	.UNUSED0 = 0,          /*!< must be clear */
+	.UNUSED1 = 0           /*!< must be clear */
+};
+
+/**
+ * @brief  Exchange frame with ADC (cs line is not touched)
+ * @param  pDevice - ADC device
+ * @param  pTxData - frame: command/data bytes, then dummy bytes for read
+ * @param  pRxData - received frame (same size as pTxData)
+ * @param  Size - size of frame
+ * @param  TxSize - count of first bytes written to ADC, other bytes are read
+ * @return None
+ */
+static void AD779X_Exchange(tAD779X_Device *pDevice, const uint8_t *pTxData, uint8_t *pRxData, uint8_t Size, uint8_t TxSize)
+{
+	uint8_t i;
+	
+	if (pDevice->TxRxBlock)
+	{
+		/* whole frame by one full-duplex transfer */
+		pDevice->TxRxBlock(pTxData, pRxData, Size);
+	}
+	else
+	{
+		/* fallback: byte by byte */
+		for (i = 0; i < TxSize; i++)
+			pDevice->TxByte(pTxData[i]);
+		
+		for (; i < Size; i++)
+			pRxData[i] = pDevice->RxByte();
+	}
+}
+
+/**
+ * @brief  Exchange frame made of several commands (cs line is not touched)
+ * @param  pDevice - ADC device
+ * @param  pTxData - frame: segments one by one
+ * @param  pRxData - received frame (same size as pTxData)
+ * @param  pSegments - segments: size and count of written bytes of each
+ * @param  Count - count of segments
+ * @return None
+ */
+static void AD779X_ExchangeSegments(tAD779X_Device *pDevice, const uint8_t *pTxData, uint8_t *pRxData, const tAD779X_Segment *pSegments, uint8_t Count)
+{
+	uint8_t i, m_size = 0;
+	
+	if (pDevice->TxRxBlock)
+	{
+		for (i = 0; i < Count; i++)
+			m_size += pSegments[i].Size;
+		
+		/* whole frame by one full-duplex transfer */
+		pDevice->TxRxBlock(pTxData, pRxData, m_size);
+	}
+	else
+	{
+		/* fallback: segment by segment */
+		for (i = 0; i < Count; i++)
+		{
+			AD779X_Exchange(pDevice, &pTxData[m_size], &pRxData[m_size], pSegments[i].Size, pSegments[i].TxSize);
+			m_size += pSegments[i].Size;
+		}
+	}
+}
+
+#if !defined(AD779X_CORE_SHIM)
+/**
+ * @brief  Make one transaction with ADC: active cs, exchange frame, inactive cs
+ * @param  pDevice - ADC device
+ * @param  pTxData - frame: command/data bytes, then dummy bytes for read
+ * @param  pRxData - received frame (same size as pTxData)
+ * @param  Size - size of frame
+ * @param  TxSize - count of first bytes written to ADC, other bytes are read
+ * @return None
+ */
+static void AD779X_Transfer(tAD779X_Device *pDevice, const uint8_t *pTxData, uint8_t *pRxData, uint8_t Size, uint8_t TxSize)
+{
+	AD779X_TRACE_BEGIN(AD779X_TRACE_OP(pTxData[0]), pDevice);
+	
+	/* active cs line */
+	pDevice->CSControl(cssEnable);
+	
+	AD779X_Exchange(pDevice, pTxData, pRxData, Size, TxSize);
+	
+	/* inactive cs line */
+	pDevice->CSControl(cssDisable);
+	
+	AD779X_TRACE_END(AD779X_TRACE_OP(pTxData[0]), pDevice);
+}
+
+#endif
+
+/**
+ * @brief  Make sample value (24-bit range) from data register bytes
+ * @param  pDevice - ADC device
+ * @param  pData - data register bytes, MSB first
+ * @return Data sample value
+ */
+static unsigned long AD779X_MakeSample24(tAD779X_Device *pDevice, const uint8_t *pData)
+{
+	unsigned long m_data_sample = 0;
+
+#if defined(AD779X_FIXED_MODEL)
+	/* model is fixed at build time: device is not read */
+	(void)pDevice;
+#endif
+	
+	switch (AD779X_MODEL(*pDevice))
+	{
+		case ad7792:
+			m_data_sample = (((unsigned long)((pData[0] << 8)| pData[1])) << 8);
+			break;
+		
+		case ad7793:
+			m_data_sample = ((((unsigned long)((pData[0] << 8)| pData[1])) << 8) | pData[2]);
+			break;
+		
+		default:
+			break;
+	}
+	
+	return m_data_sample;
+}
+
+/**
+ * @brief  Count result in telemetry
+ * @param  pDevice - ADC device
+ * @param  Status - STATUS register read with result, 0 - not read
+ * @return None
+ */
+static void AD779X_CountResult(tAD779X_Device *pDevice, uint8_t Status)
+{
+	AD779X_COUNTER_INC(pDevice->Telemetry.Conversions);
+	
+	/* result is clamped: overrange of input */
+	if (Status & AD779X_SR_ERR)
+		AD779X_COUNTER_INC(pDevice->Telemetry.Errors[Status & AD779X_SR_CHC]);
+}
+
+/* Conversion period t_adc for each filter update rate (64 kHz clock), us */
+static const unsigned long gConversionTime[16] =
+{
+	0,      /* fsNone */
+	2000,   /* fs500 */
+	4000,   /* fs250 */
+	8000,   /* fs152 */
+	16000,  /* fs62_5 */
+	20000,  /* fs50 */
+	24000,  /* fs39_2 */
+	30000,  /* fs33_3 */
+	50500,  /* fs19_6_90dB */
+	60000,  /* fs16_7_80dB */
+	60000,  /* fs16_7_65dB */
+	80000,  /* fs12_5_66dB */
+	100000, /* fs10_69dB */
+	120000, /* fs8_33_70dB */
+	160000, /* fs6_25_72dB */
+	240000  /* fs4_17_74dB */
+};
+
+/**
+ * @brief  Get conversion period (time between results in continuous mode)
+ * @param  Rate - filter update rate
+ * @param  ClkSource - clock source (external clock - AD779X_EXT_CLK_HZ)
+ * @return Conversion period, us
+ */
+unsigned long AD779X_ConversionTimeUs(tAD779X_FilterSelect Rate, tAD779X_ClkSourceSelect ClkSource)
+{
+	unsigned long m_time = gConversionTime[Rate & 0xF];
+	
+	switch (ClkSource)
+	{
+		case cssExt:
+			return (unsigned long)(((unsigned long long)m_time * AD779X_INT_CLK_HZ) / AD779X_EXT_CLK_HZ);
+		
+		/* external clock is divided by 2 within ADC */
+		case cssExtDiv2:
+			return (unsigned long)(((unsigned long long)m_time * 2 * AD779X_INT_CLK_HZ) / AD779X_EXT_CLK_HZ);
+		
+		default:
+			return m_time;
+	}
+}
+
+/**
+ * @brief  Get settling time: first result after MODE write or CONFIG change
+ *         (channel, gain), single conversion and calibration time
+ * @param  Rate - filter update rate
+ * @param  ClkSource - clock source (external clock - AD779X_EXT_CLK_HZ)
+ * @return Settling time (2 conversion periods), us
+ */
+unsigned long AD779X_SettlingTimeUs(tAD779X_FilterSelect Rate, tAD779X_ClkSourceSelect ClkSource)
+{
+	return 2 * AD779X_ConversionTimeUs(Rate, ClkSource);
+}
+
+/**
+ * @brief  Wait RDY (cs line must be active): time limit is settling time with
+ *         margin, without GetTimeUs - AD779X_RDY_POLLS reads of RDY line
+ * @param  pDevice - ADC device
+ * @return 1 - data ready, 0 - timeout
+ */
+static uint8_t AD779X_WaitRDY(tAD779X_Device *pDevice)
+{
+	uint32_t m_start = 0, m_polls = 0;
+	uint32_t m_timeout = 2 * AD779X_SettlingTimeUs((tAD779X_FilterSelect)pDevice->ModeReg.FS, (tAD779X_ClkSourceSelect)pDevice->ModeReg.CLKS) + AD779X_POWER_UP_US;
+	
+	if (pDevice->GetTimeUs)
+		m_start = pDevice->GetTimeUs();
+	
+	while (pDevice->RDYState() == rdsBusy)
+	{
+		if (pDevice->GetTimeUs ? ((pDevice->GetTimeUs() - m_start) >= m_timeout) : (++m_polls >= AD779X_RDY_POLLS))
+		{
+			AD779X_COUNTER_INC(pDevice->Telemetry.Timeouts);
+			return 0;
+		}
+	}
+	
+	return 1;
+}
+
+/**
+ * @brief  Start deadline of first result: conversion restarts after write
+ *         of MODE or CONFIG register
+ * @param  pDevice - ADC device
+ * @param  Mode - written mode (one-shot modes are not stored in ModeReg)
+ * @param  PrevMode - mode before write (Power-down: oscillator powers up)
+ * @return None
+ */
+static void AD779X_StartDeadline(tAD779X_Device *pDevice, uint8_t Mode, uint8_t PrevMode)
+{
+	if (!pDevice->GetTimeUs)
+		return;
+	
+	if ((Mode == mdsIdle) || (Mode == mdsPowerDown))
+	{
+		pDevice->DeadlineSet = 0;
+		return;
+	}
+	
+	pDevice->Deadline = pDevice->GetTimeUs() + AD779X_SettlingTimeUs((tAD779X_FilterSelect)pDevice->ModeReg.FS, (tAD779X_ClkSourceSelect)pDevice->ModeReg.CLKS);
+	
+	if (PrevMode == mdsPowerDown)
+		pDevice->Deadline += AD779X_POWER_UP_US;
+	
+	pDevice->DeadlineSet = 1;
+}
+
+/**
+ * @brief  Move deadline to next result (continuous mode) or clear it
+ * @param  pDevice - ADC device
+ * @return None
+ */
+static void AD779X_NextDeadline(tAD779X_Device *pDevice)
+{
+	unsigned long m_period;
+	uint32_t m_now;
+	
+	if (!pDevice->DeadlineSet || !pDevice->GetTimeUs || (pDevice->ModeReg.MODE != mdsContinuous))
+	{
+		pDevice->DeadlineSet = 0;
+		return;
+	}
+	
+	m_period = AD779X_ConversionTimeUs((tAD779X_FilterSelect)pDevice->ModeReg.FS, (tAD779X_ClkSourceSelect)pDevice->ModeReg.CLKS);
+	m_now = pDevice->GetTimeUs();
+	
+	/* results come each period from first result, missed results are skipped */
+	pDevice->Deadline += m_period;
+	
+	while ((int32_t)(pDevice->Deadline - m_now) <= 0)
+	{
+		pDevice->Deadline += m_period;
+		AD779X_COUNTER_INC(pDevice->Telemetry.Overruns);
+	}
+}
+
+#if defined(AD779X_CORE_SHIM)
+/**
+ * @brief  Keep state of device after cs window of core function made by
+ *         ad779x_shim.cpp: register images, deadline, read mode (as core
+ *         functions of this file do)
+ * @param  pDevice - ADC device
+ * @param  pTxData - written frame: command, data
+ * @param  Size - size of frame
+ * @return None
+ */
+void AD779X_ShimWindow(tAD779X_Device *pDevice, const uint8_t *pTxData, uint8_t Size)
+{
+	uint8_t m_prev = pDevice->ModeReg.MODE;
+	unsigned long m_value = 0;
+	uint8_t i;
+	
+	/* written value, MSB first */
+	for (i = 1; i < Size; i++)
+		m_value = (m_value << 8) | pTxData[i];
+	
+	switch (pTxData[0])
+	{
+		case AD779X_WRR_MODE:
+			pDevice->ModeReg.DATA = (unsigned short)m_value;
+			AD779X_StartDeadline(pDevice, pDevice->ModeReg.MODE, m_prev);
+			
+			/* one-shot modes return ADC to Power-down/Idle mode by itself */
+			if (AD779X_MODE_IS_ONESHOT(pDevice->ModeReg.MODE))
+				pDevice->ModeReg.MODE = AD779X_MODE_AFTER_ONESHOT(pDevice->ModeReg.MODE);
+		break;
+		
+		case AD779X_WRR_CONFIG:
+			pDevice->ConfigReg.DATA = (unsigned short)m_value;
+			AD779X_StartDeadline(pDevice, pDevice->ModeReg.MODE, pDevice->ModeReg.MODE);
+		break;
+		
+		case AD779X_WRR_IO:
+			pDevice->IOReg.DATA = (unsigned char)m_value;
+		break;
+		
+		case 0xFF:
+			/* reset: registers return to reset values, continuous read mode is left */
+			pDevice->ModeReg.DATA   = AD779X_RDV_MODE;
+			pDevice->ConfigReg.DATA = AD779X_RDV_CONFIG;
+			pDevice->IOReg.DATA     = AD779X_RDV_IO;
+			pDevice->ReadMode       = rdmSingle;
+			pDevice->DeadlineSet    = 0;
+		break;
+	}
+}
+#else
 /**
  * @brief  Init HW and reset ADC
  * @param  None
@@ -47,6 +387,9 @@ void AD779X_Init(tAD779X_Device *pDevice)
 		/* set default settings: continuous conversion, internal clock source, 16.7Hz (65dB) */
 		AD779X_WriteModeRegister(pDevice, gModeReg.DATA);
 		
+		/* set default settings: AIN1, gain 128, bipolar, external reference, buffered */
+		AD779X_WriteConfigRegister(pDevice, gConfigReg.DATA);
+		
 		/* set default settings: excitation currents disabled */
 		AD779X_WriteIORegister(pDevice, gIOReg.DATA);
 		
@@ -67,20 +410,21 @@ void AD779X_Init(tAD779X_Device *pDevice)
  */
 void AD779X_Reset(tAD779X_Device *pDevice)
 {
-	/* active cs line */
-	pDevice->CSControl(cssEnable);
-	
 	/* make 32 clk, while dout -> 1 */
-	pDevice->TxByte(0xFF);
-	pDevice->TxByte(0xFF);
-	pDevice->TxByte(0xFF);
-	pDevice->TxByte(0xFF);
+	const uint8_t m_tx[4] = {0xFF, 0xFF, 0xFF, 0xFF};
+	uint8_t m_rx[4];
+	
+	AD779X_Transfer(pDevice, m_tx, m_rx, 4, 4);
+	
+	/* registers return to reset values, continuous read mode is left */
+	pDevice->ModeReg.DATA   = AD779X_RDV_MODE;
+	pDevice->ConfigReg.DATA = AD779X_RDV_CONFIG;
+	pDevice->IOReg.DATA     = AD779X_RDV_IO;
+	pDevice->ReadMode       = rdmSingle;
+	pDevice->DeadlineSet    = 0;
 	
 	/* wait until ADC will restart */
 	//while(pDevice->RDYState() == rdsBusy);
-	
-	/* inactive cs line */
-	pDevice->CSControl(cssDisable);
 }
 
 /**
@@ -90,18 +434,21 @@ void AD779X_Reset(tAD779X_Device *pDevice)
  */
 void AD779X_WriteModeRegister(tAD779X_Device *pDevice, unsigned short Data)
 {
-	/* active cs line */
-	pDevice->CSControl(cssEnable);
+	/* cmd: write MODE register, data */
+	const uint8_t m_tx[3] = {AD779X_WRR_MODE, Data >> 8, Data & 0x00FF};
+	uint8_t m_rx[3];
+	uint8_t m_prev = pDevice->ModeReg.MODE;
 	
-	/* send cmd: write MODE register */
-	pDevice->TxByte(AD779X_WRR_MODE);
+	AD779X_Transfer(pDevice, m_tx, m_rx, 3, 3);
 	
-	/* write data to register */
-	pDevice->TxByte(Data >> 8);
-	pDevice->TxByte(Data & 0x00FF);
+	/* store value */
+	pDevice->ModeReg.DATA = Data;
 	
-	/* inactive cs line */
-	pDevice->CSControl(cssDisable);
+	AD779X_StartDeadline(pDevice, pDevice->ModeReg.MODE, m_prev);
+	
+	/* one-shot modes return ADC to Power-down/Idle mode by itself */
+	if (AD779X_MODE_IS_ONESHOT(pDevice->ModeReg.MODE))
+		pDevice->ModeReg.MODE = AD779X_MODE_AFTER_ONESHOT(pDevice->ModeReg.MODE);
 }
 
 /**
@@ -111,18 +458,17 @@ void AD779X_WriteModeRegister(tAD779X_Device *pDevice, unsigned short Data)
  */
 void AD779X_WriteConfigRegister(tAD779X_Device *pDevice, unsigned short Data)
 {
-	/* active cs line */
-	pDevice->CSControl(cssEnable);
+	/* cmd: write CONFIG register, data */
+	const uint8_t m_tx[3] = {AD779X_WRR_CONFIG, Data >> 8, Data & 0x00FF};
+	uint8_t m_rx[3];
 	
-	/* send cmd: write CONFIG register */
-	pDevice->TxByte(AD779X_WRR_CONFIG);
+	AD779X_Transfer(pDevice, m_tx, m_rx, 3, 3);
 	
-	/* write data to register */
-	pDevice->TxByte(Data >> 8);
-	pDevice->TxByte(Data & 0x00FF);
+	/* store value */
+	pDevice->ConfigReg.DATA = Data;
 	
-	/* inactive cs line */
-	pDevice->CSControl(cssDisable);
+	/* conversion restarts with new configuration */
+	AD779X_StartDeadline(pDevice, pDevice->ModeReg.MODE, pDevice->ModeReg.MODE);
 }
 
 /**
@@ -132,17 +478,14 @@ void AD779X_WriteConfigRegister(tAD779X_Device *pDevice, unsigned short Data)
  */
 void AD779X_WriteIORegister(tAD779X_Device *pDevice, unsigned char Data)
 {
-	/* active cs line */
-	pDevice->CSControl(cssEnable);
-	
-	/* send cmd: write IO register */
-	pDevice->TxByte(AD779X_WRR_IO);
+	/* cmd: write IO register, data */
+	const uint8_t m_tx[2] = {AD779X_WRR_IO, Data};
+	uint8_t m_rx[2];
 	
-	/* write data to register */
-	pDevice->TxByte(Data);
+	AD779X_Transfer(pDevice, m_tx, m_rx, 2, 2);
 	
-	/* inactive cs line */
-	pDevice->CSControl(cssDisable);
+	/* store value */
+	pDevice->IOReg.DATA = Data;
 }
 
 /**
@@ -152,21 +495,14 @@ void AD779X_WriteIORegister(tAD779X_Device *pDevice, unsigned char Data)
  */
 unsigned short AD779X_HWDetect(tAD779X_Device *pDevice)
 {
-	unsigned short m_adc_model;
-	
-	/* active cs line */
-	pDevice->CSControl(cssEnable);
-	
-	/* send cmd: read ID register */
-	pDevice->TxByte(AD779X_RDR_ID);
+	/* cmd: read ID register */
+	const uint8_t m_tx[2] = {AD779X_RDR_ID, 0};
+	uint8_t m_rx[2];
 	
 	/* get ID */
-	m_adc_model = pDevice->RxByte();
-	
-	/* inactive cs line */
-	pDevice->CSControl(cssDisable);
+	AD779X_Transfer(pDevice, m_tx, m_rx, 2, 1);
 	
-	switch (m_adc_model & 0xF)
+	switch (m_rx[1] & 0xF)
 	{
 		case AD7792_PARTID:
 			pDevice->Model = ad7792;
@@ -180,6 +516,15 @@ unsigned short AD779X_HWDetect(tAD779X_Device *pDevice)
 			pDevice->Model = adNone;
 		break;
 	}
+
+#if defined(AD779X_FIXED_MODEL)
+	/* other model is not supported by this build */
+	if (pDevice->Model != AD779X_FIXED_MODEL)
+		pDevice->Model = adNone;
+#endif
+	
+	if (pDevice->Model == adNone)
+		AD779X_COUNTER_INC(pDevice->Telemetry.DetectFails);
 	
 	return pDevice->Model;
 }
@@ -191,21 +536,14 @@ unsigned short AD779X_HWDetect(tAD779X_Device *pDevice)
  */
 unsigned char AD779X_GetStatus(tAD779X_Device *pDevice)
 {
-	unsigned char m_adc_status;
-	
-	/* active cs line */
-	pDevice->CSControl(cssEnable);
-	
-	/* send cmd: read STATUS register */
-	pDevice->TxByte(AD779X_RDR_STATUS);
+	/* cmd: read STATUS register */
+	const uint8_t m_tx[2] = {AD779X_RDR_STATUS, 0};
+	uint8_t m_rx[2];
 	
 	/* get value */
-	m_adc_status = pDevice->RxByte();
-	
-	/* inactive cs line */
-	pDevice->CSControl(cssDisable);
+	AD779X_Transfer(pDevice, m_tx, m_rx, 2, 1);
 	
-	return m_adc_status;
+	return m_rx[1];
 }
 
 /**
@@ -227,6 +565,8 @@ unsigned char AD779X_CheckReadyHW(tAD779X_Device *pDevice)
 {
 	unsigned char m_rdy_state;
 	
+	AD779X_TRACE_BEGIN(trcPollReady, pDevice);
+	
 	/* active cs line */
 	pDevice->CSControl(cssEnable);
 	
@@ -238,9 +578,52 @@ unsigned char AD779X_CheckReadyHW(tAD779X_Device *pDevice)
 	/* inactive cs line */
 	pDevice->CSControl(cssDisable);
 	
+	AD779X_TRACE_END(trcPollReady, pDevice);
+	
 	return m_rdy_state;
 }
 
+/**
+ * @brief  Write value in MODE register, if it differs from stored value
+ * @param  pDevice - ADC device
+ * @param  Data - need write
+ * @return None
+ */
+static void AD779X_UpdateModeRegister(tAD779X_Device *pDevice, unsigned short Data)
+{
+	tAD779X_ModeRegister m_mode_reg;
+	
+	m_mode_reg.DATA = Data;
+	
+	/* one-shot modes are started by each write */
+	if ((Data != pDevice->ModeReg.DATA) || AD779X_MODE_IS_ONESHOT(m_mode_reg.MODE))
+		AD779X_WriteModeRegister(pDevice, Data);
+}
+
+/**
+ * @brief  Write value in CONFIG register, if it differs from stored value
+ * @param  pDevice - ADC device
+ * @param  Data - need write
+ * @return None
+ */
+static void AD779X_UpdateConfigRegister(tAD779X_Device *pDevice, unsigned short Data)
+{
+	if (Data != pDevice->ConfigReg.DATA)
+		AD779X_WriteConfigRegister(pDevice, Data);
+}
+
+/**
+ * @brief  Write value in IO register, if it differs from stored value
+ * @param  pDevice - ADC device
+ * @param  Data - need write
+ * @return None
+ */
+static void AD779X_UpdateIORegister(tAD779X_Device *pDevice, unsigned char Data)
+{
+	if (Data != pDevice->IOReg.DATA)
+		AD779X_WriteIORegister(pDevice, Data);
+}
+
 /**
  * @brief  Set ADC mode
  * @param  Mode - need set
@@ -248,11 +631,13 @@ unsigned char AD779X_CheckReadyHW(tAD779X_Device *pDevice)
  */
 void AD779X_SetMode(tAD779X_Device *pDevice, tAD779X_ModeSelect Mode)
 {
-	/* change and store needed mode */
-	pDevice->ModeReg.MODE = Mode;      // FIXME: need assembler optimisation
+	tAD779X_ModeRegister m_mode_reg = pDevice->ModeReg;
+	
+	/* change needed mode */
+	m_mode_reg.MODE = Mode;
 	
-	/* write value in MODE register */
-	AD779X_WriteModeRegister(pDevice, pDevice->ModeReg.DATA);
+	/* write value in MODE register, if it is changed */
+	AD779X_UpdateModeRegister(pDevice, m_mode_reg.DATA);
 }
 
 /**
@@ -262,11 +647,13 @@ void AD779X_SetMode(tAD779X_Device *pDevice, tAD779X_ModeSelect Mode)
  */
 void AD779X_SetClkSource(tAD779X_Device *pDevice, tAD779X_ClkSourceSelect ClkSource)
 {
-	/* change and store needed clock source */
-	pDevice->ModeReg.CLKS = ClkSource; // FIXME: need assembler optimisation
+	tAD779X_ModeRegister m_mode_reg = pDevice->ModeReg;
 	
-	/* write value in MODE register */
-	AD779X_WriteModeRegister(pDevice, pDevice->ModeReg.DATA);
+	/* change needed clock source */
+	m_mode_reg.CLKS = ClkSource;
+	
+	/* write value in MODE register, if it is changed */
+	AD779X_UpdateModeRegister(pDevice, m_mode_reg.DATA);
 }
 
 /**
@@ -276,110 +663,333 @@ void AD779X_SetClkSource(tAD779X_Device *pDevice, tAD779X_ClkSourceSelect ClkSou
  */
 void AD779X_SetUpdateRate(tAD779X_Device *pDevice, tAD779X_FilterSelect UpdateRates)
 {
-	/* change and store needed update rates */
-	pDevice->ModeReg.FS = UpdateRates; // FIXME: need assembler optimisation
+	tAD779X_ModeRegister m_mode_reg = pDevice->ModeReg;
+	
+	/* change needed update rates */
+	m_mode_reg.FS = UpdateRates;
 	
-	/* write value in MODE register */
-	AD779X_WriteModeRegister(pDevice, pDevice->ModeReg.DATA);
+	/* write value in MODE register, if it is changed */
+	AD779X_UpdateModeRegister(pDevice, m_mode_reg.DATA);
 }
 
 /**
- * @brief  Set ADC excitation currents value
- * @param  excValue - need sat
+ * @brief  Set ADC channel
+ * @param  pDevice - ADC device
+ * @param  Channel - need set
  * @return None
  */
-void AD779X_SetExCurrentValue(tAD779X_Device *pDevice, tAD779X_IEXCENSelect excValue)
+void AD779X_SetChannel(tAD779X_Device *pDevice, tAD779X_ChSelect Channel)
 {
-	/* change and store needed value */
-	pDevice->IOReg.IEXCEN = excValue;
+	tAD779X_ConfigRegister m_config_reg = pDevice->ConfigReg;
+	
+	/* change needed channel */
+	m_config_reg.CHSEL = Channel;
 	
-	/* write value in IO register */
-	AD779X_WriteIORegister(pDevice, pDevice->IOReg.DATA);
+	/* write value in CONFIG register, if it is changed */
+	AD779X_UpdateConfigRegister(pDevice, m_config_reg.DATA);
 }
 
 /**
- * @brief  Set ADC excitation currents direction
- * @param  excDirection - need sat
+ * @brief  Set ADC gain
+ * @param  pDevice - ADC device
+ * @param  Gain - need set
  * @return None
  */
-void AD779X_SetExCurrentDirection(tAD779X_Device *pDevice, tAD779X_IEXCDIRSelect excDirection)
+void AD779X_SetGain(tAD779X_Device *pDevice, tAD779X_GainSelect Gain)
 {
-	/* change and store needed value */
-	pDevice->IOReg.IEXCDIR = excDirection;
+	tAD779X_ConfigRegister m_config_reg = pDevice->ConfigReg;
+	
+	/* change needed gain */
+	m_config_reg.GAIN = Gain;
 	
-	/* write value in IO register */
-	AD779X_WriteIORegister(pDevice, pDevice->IOReg.DATA);
+	/* write value in CONFIG register, if it is changed */
+	AD779X_UpdateConfigRegister(pDevice, m_config_reg.DATA);
 }
 
 /**
- * @brief  Start ADC Zero-Scale Calibration
- * @param  None
+ * @brief  Set ADC unipolar/bipolar coding
+ * @param  pDevice - ADC device
+ * @param  Polarity - need set
  * @return None
  */
-void AD779X_StartZSCalibration(tAD779X_Device *pDevice)
+void AD779X_SetPolarity(tAD779X_Device *pDevice, tAD779X_BSelect Polarity)
 {
-	AD779X_SetMode(pDevice, mdsIntZeroCal);
+	tAD779X_ConfigRegister m_config_reg = pDevice->ConfigReg;
+	
+	/* change needed coding */
+	m_config_reg.UB = Polarity;
+	
+	/* write value in CONFIG register, if it is changed */
+	AD779X_UpdateConfigRegister(pDevice, m_config_reg.DATA);
 }
 
 /**
- * @brief  Start ADC Full-Scale Calibration
- * @param  None
+ * @brief  Set ADC buffered/unbuffered mode
+ * @param  pDevice - ADC device
+ * @param  Buffer - need set
  * @return None
  */
-void AD779X_StartFSCalibration(tAD779X_Device *pDevice)
+void AD779X_SetBuffer(tAD779X_Device *pDevice, tAD779X_BufSelect Buffer)
 {
-	AD779X_SetMode(pDevice, mdsIntFullCal);
+	tAD779X_ConfigRegister m_config_reg = pDevice->ConfigReg;
+	
+	/* change needed buffer mode */
+	m_config_reg.BUF = Buffer;
+	
+	/* write value in CONFIG register, if it is changed */
+	AD779X_UpdateConfigRegister(pDevice, m_config_reg.DATA);
 }
 
 /**
- * @brief  Read data from ADC (16-bit)
- * @param  None
- * @return Data register value
+ * @brief  Set ADC reference source
+ * @param  pDevice - ADC device
+ * @param  Reference - need set
+ * @return None
  */
-unsigned short AD779X_ReadDataRegister16(tAD779X_Device *pDevice)
+void AD779X_SetReference(tAD779X_Device *pDevice, tAD779X_RefSelect Reference)
 {
-	unsigned char m_data[2];
-	
-	/* active cs line */
-	pDevice->CSControl(cssEnable);
-	
-	/* send cmd: read DATA register */
-	pDevice->TxByte(AD779X_RDR_DATA);
-	
-	/* get value */
-	m_data[1] = pDevice->RxByte();
-	m_data[0] = pDevice->RxByte();
+	tAD779X_ConfigRegister m_config_reg = pDevice->ConfigReg;
 	
-	/* inactive cs line */
-	pDevice->CSControl(cssDisable);
+	/* change needed reference */
+	m_config_reg.REFSEL = Reference;
 	
-	return (m_data[1]<<8)|m_data[0];
+	/* write value in CONFIG register, if it is changed */
+	AD779X_UpdateConfigRegister(pDevice, m_config_reg.DATA);
 }
 
 /**
- * @brief  Read data from ADC (24-bit)
- * @param  None
- * @return Data register value
+ * @brief  Set ADC bias voltage generator
+ * @param  pDevice - ADC device
+ * @param  Bias - need set
+ * @return None
  */
-unsigned long AD779X_ReadDataRegister24(tAD779X_Device *pDevice)
+void AD779X_SetBias(tAD779X_Device *pDevice, tAD779X_VbiasSelect Bias)
 {
-	unsigned char m_data[3];
+	tAD779X_ConfigRegister m_config_reg = pDevice->ConfigReg;
 	
-	/* active cs line */
-	pDevice->CSControl(cssEnable);
-	
-	/* send cmd: read DATA register */
-	pDevice->TxByte(AD779X_RDR_DATA);
-	
-	/* get value */
-	m_data[2] = pDevice->RxByte();
-	m_data[1] = pDevice->RxByte();
-	m_data[0] = pDevice->RxByte();
-	
-	/* inactive cs line */
-	pDevice->CSControl(cssDisable);
+	/* change needed bias voltage */
+	m_config_reg.VBIAS = Bias;
 	
-	return (((unsigned long)((m_data[2]<<8)|m_data[1]))<<8)|m_data[0]; // NOTE: iar compiler hell
+	/* write value in CONFIG register, if it is changed */
+	AD779X_UpdateConfigRegister(pDevice, m_config_reg.DATA);
+}
+
+/**
+ * @brief  Set ADC excitation currents value
+ * @param  excValue - need sat
+ * @return None
+ */
+void AD779X_SetExCurrentValue(tAD779X_Device *pDevice, tAD779X_IEXCENSelect excValue)
+{
+	tAD779X_IORegister m_io_reg = pDevice->IOReg;
+	
+	/* change needed value */
+	m_io_reg.IEXCEN = excValue;
+	
+	/* write value in IO register, if it is changed */
+	AD779X_UpdateIORegister(pDevice, m_io_reg.DATA);
+}
+
+/**
+ * @brief  Set ADC excitation currents direction
+ * @param  excDirection - need sat
+ * @return None
+ */
+void AD779X_SetExCurrentDirection(tAD779X_Device *pDevice, tAD779X_IEXCDIRSelect excDirection)
+{
+	tAD779X_IORegister m_io_reg = pDevice->IOReg;
+	
+	/* change needed value */
+	m_io_reg.IEXCDIR = excDirection;
+	
+	/* write value in IO register, if it is changed */
+	AD779X_UpdateIORegister(pDevice, m_io_reg.DATA);
+}
+
+/**
+ * @brief  Start ADC Zero-Scale Calibration
+ * @param  None
+ * @return None
+ */
+void AD779X_StartZSCalibration(tAD779X_Device *pDevice)
+{
+	AD779X_SetMode(pDevice, mdsIntZeroCal);
+}
+
+/**
+ * @brief  Start ADC Full-Scale Calibration
+ * @param  None
+ * @return None
+ */
+void AD779X_StartFSCalibration(tAD779X_Device *pDevice)
+{
+	AD779X_SetMode(pDevice, mdsIntFullCal);
+}
+
+/**
+ * @brief  Read offset register value (16-bit)
+ * @param  pDevice - ADC device
+ * @return offset register value
+ */
+unsigned short AD779X_ReadOffsetRegister16(tAD779X_Device *pDevice)
+{
+	/* cmd: read register */
+	const uint8_t m_tx[3] = {AD779X_RDR_OFFSET, 0, 0};
+	uint8_t m_rx[3];
+	
+	/* get value */
+	AD779X_Transfer(pDevice, m_tx, m_rx, 3, 1);
+	
+	return (m_rx[1]<<8)|m_rx[2];
+}
+
+/**
+ * @brief  Read offset register value (24-bit)
+ * @param  pDevice - ADC device
+ * @return offset register value
+ */
+unsigned long AD779X_ReadOffsetRegister24(tAD779X_Device *pDevice)
+{
+	/* cmd: read register */
+	const uint8_t m_tx[4] = {AD779X_RDR_OFFSET, 0, 0, 0};
+	uint8_t m_rx[4];
+	
+	/* get value */
+	AD779X_Transfer(pDevice, m_tx, m_rx, 4, 1);
+	
+	return (((unsigned long)((m_rx[1]<<8)|m_rx[2]))<<8)|m_rx[3];
+}
+
+/**
+ * @brief  Read full-scale register value (16-bit)
+ * @param  pDevice - ADC device
+ * @return full-scale register value
+ */
+unsigned short AD779X_ReadFScaleRegister16(tAD779X_Device *pDevice)
+{
+	/* cmd: read register */
+	const uint8_t m_tx[3] = {AD779X_RDR_FSCLAE, 0, 0};
+	uint8_t m_rx[3];
+	
+	/* get value */
+	AD779X_Transfer(pDevice, m_tx, m_rx, 3, 1);
+	
+	return (m_rx[1]<<8)|m_rx[2];
+}
+
+/**
+ * @brief  Read full-scale register value (24-bit)
+ * @param  pDevice - ADC device
+ * @return full-scale register value
+ */
+unsigned long AD779X_ReadFScaleRegister24(tAD779X_Device *pDevice)
+{
+	/* cmd: read register */
+	const uint8_t m_tx[4] = {AD779X_RDR_FSCLAE, 0, 0, 0};
+	uint8_t m_rx[4];
+	
+	/* get value */
+	AD779X_Transfer(pDevice, m_tx, m_rx, 4, 1);
+	
+	return (((unsigned long)((m_rx[1]<<8)|m_rx[2]))<<8)|m_rx[3];
+}
+
+/**
+ * @brief  Write offset register value (16-bit), register of selected channel
+ * @param  pDevice - ADC device
+ * @param  Data - need write
+ * @return None
+ */
+void AD779X_WriteOffsetRegister16(tAD779X_Device *pDevice, unsigned short Data)
+{
+	/* cmd: write register */
+	const uint8_t m_tx[3] = {AD779X_WRR_OFFSET, Data >> 8, Data & 0x00FF};
+	uint8_t m_rx[3];
+	
+	/* set value */
+	AD779X_Transfer(pDevice, m_tx, m_rx, 3, 3);
+}
+
+/**
+ * @brief  Write offset register value (24-bit), register of selected channel
+ * @param  pDevice - ADC device
+ * @param  Data - need write
+ * @return None
+ */
+void AD779X_WriteOffsetRegister24(tAD779X_Device *pDevice, unsigned long Data)
+{
+	/* cmd: write register */
+	const uint8_t m_tx[4] = {AD779X_WRR_OFFSET, (Data >> 16) & 0xFF, (Data >> 8) & 0xFF, Data & 0xFF};
+	uint8_t m_rx[4];
+	
+	/* set value */
+	AD779X_Transfer(pDevice, m_tx, m_rx, 4, 4);
+}
+
+/**
+ * @brief  Write full-scale register value (16-bit), register of selected channel
+ * @param  pDevice - ADC device
+ * @param  Data - need write
+ * @return None
+ */
+void AD779X_WriteFScaleRegister16(tAD779X_Device *pDevice, unsigned short Data)
+{
+	/* cmd: write register */
+	const uint8_t m_tx[3] = {AD779X_WRR_FSCLAE, Data >> 8, Data & 0x00FF};
+	uint8_t m_rx[3];
+	
+	/* set value */
+	AD779X_Transfer(pDevice, m_tx, m_rx, 3, 3);
+}
+
+/**
+ * @brief  Write full-scale register value (24-bit), register of selected channel
+ * @param  pDevice - ADC device
+ * @param  Data - need write
+ * @return None
+ */
+void AD779X_WriteFScaleRegister24(tAD779X_Device *pDevice, unsigned long Data)
+{
+	/* cmd: write register */
+	const uint8_t m_tx[4] = {AD779X_WRR_FSCLAE, (Data >> 16) & 0xFF, (Data >> 8) & 0xFF, Data & 0xFF};
+	uint8_t m_rx[4];
+	
+	/* set value */
+	AD779X_Transfer(pDevice, m_tx, m_rx, 4, 4);
+}
+
+/**
+ * @brief  Read data from ADC (16-bit)
+ * @param  None
+ * @return Data register value
+ */
+unsigned short AD779X_ReadDataRegister16(tAD779X_Device *pDevice)
+{
+	/* cmd: read DATA register */
+	const uint8_t m_tx[3] = {AD779X_RDR_DATA, 0, 0};
+	uint8_t m_rx[3];
+	
+	/* get value */
+	AD779X_Transfer(pDevice, m_tx, m_rx, 3, 1);
+	
+	return (m_rx[1]<<8)|m_rx[2];
+}
+
+/**
+ * @brief  Read data from ADC (24-bit)
+ * @param  None
+ * @return Data register value
+ */
+unsigned long AD779X_ReadDataRegister24(tAD779X_Device *pDevice)
+{
+	/* cmd: read DATA register */
+	const uint8_t m_tx[4] = {AD779X_RDR_DATA, 0, 0, 0};
+	uint8_t m_rx[4];
+	
+	/* get value */
+	AD779X_Transfer(pDevice, m_tx, m_rx, 4, 1);
+	
+	return (((unsigned long)((m_rx[1]<<8)|m_rx[2]))<<8)|m_rx[3]; // NOTE: iar compiler hell
 }
 
 /**
@@ -391,7 +1001,7 @@ unsigned short AD779X_ReadDataSample(tAD779X_Device *pDevice)
 {
 	unsigned short m_data_sample = 0;
 	
-	switch(pDevice->Model)
+	switch (AD779X_MODEL(*pDevice))
 	{
 		case ad7792:
 			m_data_sample = AD779X_ReadDataRegister16(pDevice);
@@ -400,6 +1010,9 @@ unsigned short AD779X_ReadDataSample(tAD779X_Device *pDevice)
 		case ad7793:
 			m_data_sample = AD779X_ReadDataRegister24(pDevice)>>8;
 		break;
+		
+		default:
+		break;
 	}
 	
 	return m_data_sample;
@@ -407,35 +1020,968 @@ unsigned short AD779X_ReadDataSample(tAD779X_Device *pDevice)
 
 uint16_t AD779X_ReadDataSample16(tAD779X_Device *pDevice)
 {
-	uint8_t m_data[3];
+	/* cmd: read DATA register */
+	const uint8_t m_tx[4] = {AD779X_RDR_DATA, 0, 0, 0};
+	uint8_t m_rx[4];
 	uint16_t m_data_sample = 0;
 	
+	/* get value: 24-bit for AD7793, 16-bit for AD7792 */
+	AD779X_Transfer(pDevice, m_tx, m_rx, (AD779X_MODEL(*pDevice) == ad7793) ? 4 : 3, 1);
+	
+	switch (AD779X_MODEL(*pDevice))
+	{
+		case ad7792:
+		case ad7793:
+			m_data_sample = (m_rx[1]<<8)|m_rx[2];
+			break;
+		
+		default:
+			break;
+	}
+	
+	AD779X_CountResult(pDevice, 0);
+	
+	return m_data_sample;
+}
+
+/**
+ * @brief  Read data from ADC (24-bit range)
+ * @param  pDevice - ADC device
+ * @return Data sample value
+ */
+unsigned long AD779X_ReadDataSample24(tAD779X_Device *pDevice)
+{
+	/* cmd: read DATA register */
+	const uint8_t m_tx[4] = {AD779X_RDR_DATA, 0, 0, 0};
+	uint8_t m_rx[4];
+	
+	/* get value: 24-bit for AD7793, 16-bit for AD7792 */
+	AD779X_Transfer(pDevice, m_tx, m_rx, (AD779X_MODEL(*pDevice) == ad7793) ? 4 : 3, 1);
+	
+	AD779X_CountResult(pDevice, 0);
+	
+	return AD779X_MakeSample24(pDevice, &m_rx[1]);
+}
+
+#endif
+
+/**
+ * @brief  Enter continuous read mode (cs line stays active until stop)
+ * @param  pDevice - ADC device
+ * @return None
+ */
+void AD779X_StartContinuousRead(tAD779X_Device *pDevice)
+{
+	/* cmd: read DATA register continuously */
+	const uint8_t m_tx[1] = {AD779X_RDR_CREED};
+	uint8_t m_rx[1];
+	
 	/* active cs line */
 	pDevice->CSControl(cssEnable);
 	
-	/* send cmd: read DATA register */
-	pDevice->TxByte(AD779X_RDR_DATA);
+	AD779X_Exchange(pDevice, m_tx, m_rx, 1, 1);
 	
-	if (pDevice->Model == ad7793)
-		m_data[2] = pDevice->RxByte();
+	/* store read mode */
+	pDevice->ReadMode = rdmContinuous;
+}
+
+/**
+ * @brief  Read one sample in continuous read mode (24-bit range)
+ * @param  pDevice - ADC device
+ * @return Data sample value, AD779X_SAMPLE_TIMEOUT - RDY timeout
+ */
+unsigned long AD779X_ReadContinuousSample24(tAD779X_Device *pDevice)
+{
+	/* din must be low while data is clocked out */
+	const uint8_t m_tx[3] = {0, 0, 0};
+	uint8_t m_rx[3];
 	
-	/* get value */
-	m_data[1] = pDevice->RxByte();
-	m_data[0] = pDevice->RxByte();
+	/* wait RDY on DOUT/RDY line, no data is clocked out on timeout */
+	if (!AD779X_WaitRDY(pDevice))
+		return AD779X_SAMPLE_TIMEOUT;
+	
+	AD779X_TRACE_BEGIN(trcReadData, pDevice);
+	
+	/* get value without command byte */
+	AD779X_Exchange(pDevice, m_tx, m_rx, (AD779X_MODEL(*pDevice) == ad7793) ? 3 : 2, 0);
+	
+	AD779X_TRACE_END(trcReadData, pDevice);
+	
+	AD779X_CountResult(pDevice, 0);
+	
+	return AD779X_MakeSample24(pDevice, m_rx);
+}
+
+/**
+ * @brief  Read samples in continuous read mode (24-bit range)
+ * @param  pDevice - ADC device
+ * @param  pBuffer - buffer for samples (AD779X_SAMPLE_TIMEOUT - RDY timeout)
+ * @param  Count - count of samples need read
+ * @return None
+ */
+void AD779X_ReadContinuous24(tAD779X_Device *pDevice, unsigned long *pBuffer, size_t Count)
+{
+	while (Count--)
+		*pBuffer++ = AD779X_ReadContinuousSample24(pDevice);
+}
+
+/**
+ * @brief  Exit continuous read mode: 0x58 is written while RDY is low,
+ *         then last sample is read and cs line is inactive
+ * @param  pDevice - ADC device
+ * @return Last data sample value (24-bit range), AD779X_SAMPLE_TIMEOUT - RDY timeout:
+ *         0x58 is not taken by ADC, so ADC is reset (registers are reset values)
+ */
+unsigned long AD779X_StopContinuousRead(tAD779X_Device *pDevice)
+{
+	/* cmd: read DATA register (single) */
+	const uint8_t m_tx[4] = {AD779X_RDR_DATA, 0, 0, 0};
+	uint8_t m_rx[4];
+	
+	/* wait RDY on DOUT/RDY line: 0x58 is taken only while RDY is low */
+	if (!AD779X_WaitRDY(pDevice))
+	{
+		/* 32 ones are taken in continuous read mode: exit by reset */
+		AD779X_Reset(pDevice);
+		return AD779X_SAMPLE_TIMEOUT;
+	}
+	
+	AD779X_TRACE_BEGIN(trcReadData, pDevice);
+	
+	AD779X_Exchange(pDevice, m_tx, m_rx, (AD779X_MODEL(*pDevice) == ad7793) ? 4 : 3, 1);
 	
 	/* inactive cs line */
 	pDevice->CSControl(cssDisable);
 	
-	switch (pDevice->Model)
+	AD779X_TRACE_END(trcReadData, pDevice);
+	
+	/* store read mode */
+	pDevice->ReadMode = rdmSingle;
+	
+	AD779X_CountResult(pDevice, 0);
+	
+	return AD779X_MakeSample24(pDevice, &m_rx[1]);
+}
+
+/**
+ * @brief  Init sample ring
+ * @param  pRing - ring
+ * @param  pBuffer - storage for samples
+ * @param  Size - size of storage, rounded down to power of 2
+ * @return Size of ring, 0 - no storage (pBuffer is NULL or Size is 0): all samples are dropped
+ */
+uint16_t AD779X_RingInit(tAD779X_SampleRing *pRing, tAD779X_RingSample *pBuffer, uint16_t Size)
+{
+	/* clear low bits until one bit is left */
+	while (Size & (Size - 1))
+		Size &= Size - 1;
+	
+	if (!pBuffer || !Size)
 	{
-		case ad7792:
-			m_data_sample = (m_data[1]<<8)|m_data[0];
-			break;
+		pBuffer = NULL;
+		Size    = 1;
+	}
+	
+	pRing->pBuffer  = pBuffer;
+	pRing->Mask     = Size - 1;
+	pRing->Head     = 0;
+	pRing->Tail     = 0;
+	pRing->Overruns = 0;
+	
+	return pBuffer ? Size : 0;
+}
+
+/**
+ * @brief  Get count of samples in ring
+ * @param  pRing - ring
+ * @return Count of samples
+ */
+uint16_t AD779X_RingCount(tAD779X_SampleRing *pRing)
+{
+	return (uint16_t)(pRing->Head - pRing->Tail);
+}
+
+/**
+ * @brief  Read samples from ring (consumer side)
+ * @param  pRing - ring
+ * @param  pSamples - buffer for samples
+ * @param  Count - max count of samples need read
+ * @return Count of samples read
+ */
+uint16_t AD779X_RingRead(tAD779X_SampleRing *pRing, tAD779X_RingSample *pSamples, uint16_t Count)
+{
+	uint16_t m_tail = pRing->Tail;
+	uint16_t m_count = (uint16_t)(pRing->Head - m_tail);
+	uint16_t i;
+	
+	if (Count > m_count)
+		Count = m_count;
+	
+	/* read samples after index */
+	AD779X_MEMORY_BARRIER();
+	
+	for (i = 0; i < Count; i++)
+		pSamples[i] = pRing->pBuffer[(uint16_t)(m_tail + i) & pRing->Mask];
+	
+	/* free slots only after samples copied */
+	AD779X_MEMORY_BARRIER();
+	pRing->Tail = m_tail + Count;
+	
+	return Count;
+}
+
+/**
+ * @brief  Push sample to ring (producer side)
+ * @param  pRing - ring
+ * @param  pSample - sample
+ * @return 1 - sample is stored, 0 - ring is full: sample is dropped
+ */
+static uint8_t AD779X_RingWrite(tAD779X_SampleRing *pRing, const tAD779X_RingSample *pSample)
+{
+	uint16_t m_head = pRing->Head;
+	
+	if (!pRing->pBuffer || ((uint16_t)(m_head - pRing->Tail) > pRing->Mask))
+	{
+		/* ring is full or has no storage: drop sample */
+		pRing->Overruns++;
+		return 0;
+	}
+	
+	pRing->pBuffer[m_head & pRing->Mask] = *pSample;
+	
+	/* publish sample only after it is written */
+	AD779X_MEMORY_BARRIER();
+	pRing->Head = m_head + 1;
+	
+	return 1;
+}
+
+/**
+ * @brief  Read STATUS and DATA registers in one cs window
+ *         (continuous read mode: DATA only, channel from CONFIG register)
+ * @param  pDevice - ADC device
+ * @param  pSample - read sample
+ * @return None
+ */
+static void AD779X_ReadStatusData(tAD779X_Device *pDevice, tAD779X_RingSample *pSample)
+{
+	/* cmd: read STATUS register, cmd: read DATA register */
+	const uint8_t m_tx[6] = {AD779X_RDR_STATUS, 0, AD779X_RDR_DATA, 0, 0, 0};
+	uint8_t m_rx[6];
+	tAD779X_Segment m_segments[2] = {{2, 1}, {4, 1}};
+	
+	m_segments[1].Size = (AD779X_MODEL(*pDevice) == ad7793) ? 4 : 3;
+	
+	if (pDevice->ReadMode == rdmContinuous)
+	{
+		/* cs line is active already, data is clocked out without command */
+		AD779X_Exchange(pDevice, &m_tx[3], &m_rx[3], m_segments[1].Size - 1, 0);
+		
+		/* no STATUS register in continuous read mode: channel from CONFIG register */
+		m_rx[1] = pDevice->ConfigReg.CHSEL;
+	}
+	else
+	{
+		AD779X_TRACE_BEGIN(trcReadData, pDevice);
+		
+		/* active cs line */
+		pDevice->CSControl(cssEnable);
+		
+		AD779X_ExchangeSegments(pDevice, m_tx, m_rx, m_segments, 2);
+		
+		/* inactive cs line */
+		pDevice->CSControl(cssDisable);
+		
+		AD779X_TRACE_END(trcReadData, pDevice);
+	}
+	
+	pSample->Code    = AD779X_MakeSample24(pDevice, &m_rx[3]);
+	pSample->Status  = m_rx[1];
+	pSample->Channel = m_rx[1] & AD779X_SR_CHC;
+	
+	AD779X_CountResult(pDevice, m_rx[1]);
+}
+
+/**
+ * @brief  Data ready handler, call from RDY interrupt: read STATUS and DATA
+ *         registers in one cs window and push sample to attached ring
+ * @param  pDevice - ADC device
+ * @return None
+ */
+void AD779X_OnDataReady(tAD779X_Device *pDevice)
+{
+	tAD779X_RingSample m_sample;
+	
+	AD779X_ReadStatusData(pDevice, &m_sample);
+	
+	if (pDevice->pRing && !AD779X_RingWrite(pDevice->pRing, &m_sample))
+		AD779X_COUNTER_INC(pDevice->Telemetry.Overruns);
+}
+
+/**
+ * @brief  Read sample record: STATUS and DATA registers in one cs window,
+ *         time of read and number of read (continuous read mode: DATA only,
+ *         STATUS is made from CONFIG register, AD779X_RECORD_SYNTH_STATUS)
+ * @param  pDevice - ADC device
+ * @param  pRecord - sample record
+ * @return None
+ */
+void AD779X_ReadSampleRecord(tAD779X_Device *pDevice, tAD779X_SampleRecord *pRecord)
+{
+	tAD779X_RingSample m_sample;
+	
+	/* continuous read mode: no STATUS register read */
+	pRecord->Flags = (pDevice->ReadMode == rdmContinuous) ? AD779X_RECORD_SYNTH_STATUS : 0;
+	
+	/* time before cs window: nearest to RDY, if called on data ready */
+	if (pDevice->GetTimeUs)
+	{
+		pRecord->Timestamp = pDevice->GetTimeUs();
+		pRecord->Flags |= AD779X_RECORD_TIMESTAMP;
+	}
+	else
+	{
+		pRecord->Timestamp = 0;
+	}
+	
+	AD779X_ReadStatusData(pDevice, &m_sample);
+	
+	pRecord->Code     = m_sample.Code;
+	pRecord->Status   = m_sample.Status;
+	pRecord->Channel  = m_sample.Channel;
+	pRecord->Sequence = pDevice->Sequence++;
+}
+
+/**
+ * @brief  Put write command of 16-bit register in frame
+ * @param  pFrame - frame
+ * @param  Cmd - write command
+ * @param  Data - register value
+ * @return Size of segment
+ */
+static uint8_t AD779X_FrameWrite16(uint8_t *pFrame, uint8_t Cmd, unsigned short Data)
+{
+	pFrame[0] = Cmd;
+	pFrame[1] = Data >> 8;
+	pFrame[2] = Data & 0x00FF;
+	
+	return 3;
+}
+
+/**
+ * @brief  Put config and mode writes for scan step in frame
+ * @param  pDevice - ADC device
+ * @param  pStep - scan step
+ * @param  pFrame - frame
+ * @param  pSegments - segments of frame
+ * @param  pCount - count of segments (in/out)
+ * @return Size of written part of frame
+ */
+static uint8_t AD779X_SeqFrameStep(tAD779X_Device *pDevice, const tAD779X_ScanStep *pStep, uint8_t *pFrame, tAD779X_Segment *pSegments, uint8_t *pCount)
+{
+	tAD779X_ConfigRegister m_config_reg = pDevice->ConfigReg;
+	tAD779X_ModeRegister m_mode_reg = pDevice->ModeReg;
+	uint8_t m_size = 0;
+	
+	m_config_reg.CHSEL = pStep->Channel;
+	m_config_reg.GAIN  = pStep->Gain;
+	
+	m_mode_reg.MODE = mdsContinuous;
+	m_mode_reg.FS   = pStep->Rate;
+	
+	/* write CONFIG register, if it is changed: conversion restarts */
+	if (m_config_reg.DATA != pDevice->ConfigReg.DATA)
+	{
+		m_size += AD779X_FrameWrite16(&pFrame[m_size], AD779X_WRR_CONFIG, m_config_reg.DATA);
+		pSegments[(*pCount)].Size = 3;
+		pSegments[(*pCount)++].TxSize = 3;
+		pDevice->ConfigReg = m_config_reg;
+	}
+	
+	/* write MODE register, if it is changed */
+	if (m_mode_reg.DATA != pDevice->ModeReg.DATA)
+	{
+		m_size += AD779X_FrameWrite16(&pFrame[m_size], AD779X_WRR_MODE, m_mode_reg.DATA);
+		pSegments[(*pCount)].Size = 3;
+		pSegments[(*pCount)++].TxSize = 3;
+		pDevice->ModeReg = m_mode_reg;
+	}
+	
+	return m_size;
+}
+
+/**
+ * @brief  Start scan sequencer: set first step and continuous conversion
+ * @param  pDevice - ADC device
+ * @param  pSeq - sequencer
+ * @param  pSteps - table of steps (must be valid while sequencer works)
+ * @param  Count - count of steps
+ * @return 1 - started, 0 - no steps (pSteps is NULL or Count is 0), sequencer is stopped
+ */
+uint8_t AD779X_SeqStart(tAD779X_Device *pDevice, tAD779X_Sequencer *pSeq, const tAD779X_ScanStep *pSteps, uint8_t Count)
+{
+	uint8_t m_tx[6], m_rx[6];
+	tAD779X_Segment m_segments[2];
+	uint8_t m_count = 0, m_prev = pDevice->ModeReg.MODE;
+	
+	pSeq->Step = 0;
+	
+	if (!pSteps || !Count)
+	{
+		pSeq->pSteps = NULL;
+		pSeq->Count  = 0;
+		return 0;
+	}
+	
+	pSeq->pSteps = pSteps;
+	pSeq->Count  = Count;
+	
+	AD779X_SeqFrameStep(pDevice, &pSteps[0], m_tx, m_segments, &m_count);
+	
+	/* config and mode writes in one cs window */
+	if (m_count)
+	{
+		AD779X_TRACE_BEGIN(trcFrame, pDevice);
+		
+		/* active cs line */
+		pDevice->CSControl(cssEnable);
+		
+		AD779X_ExchangeSegments(pDevice, m_tx, m_rx, m_segments, m_count);
+		
+		/* inactive cs line */
+		pDevice->CSControl(cssDisable);
+		
+		AD779X_TRACE_END(trcFrame, pDevice);
+		
+		AD779X_StartDeadline(pDevice, mdsContinuous, m_prev);
+	}
+	
+	return 1;
+}
+
+/**
+ * @brief  Service scan sequencer on completed conversion: read data and
+ *         set next step in the same cs window
+ * @param  pDevice - ADC device
+ * @param  pSeq - sequencer
+ * @param  pStep - number of step of read sample
+ * @return Data sample value (24-bit range)
+ */
+unsigned long AD779X_SeqService(tAD779X_Device *pDevice, tAD779X_Sequencer *pSeq, uint8_t *pStep)
+{
+	uint8_t m_tx[10] = {AD779X_RDR_DATA, 0, 0, 0};
+	uint8_t m_rx[10];
+	tAD779X_Segment m_segments[3];
+	uint8_t m_size = (AD779X_MODEL(*pDevice) == ad7793) ? 4 : 3;
+	uint8_t m_count = 1;
+	
+	/* sequencer is not started: data read only */
+	if (!pSeq->pSteps)
+	{
+		*pStep = 0;
+		return AD779X_ReadDataSample24(pDevice);
+	}
+	
+	/* completed step */
+	*pStep = pSeq->Step;
+	
+	/* next step */
+	if (++pSeq->Step >= pSeq->Count)
+		pSeq->Step = 0;
+	
+	/* cmd: read DATA register */
+	m_segments[0].Size = m_size;
+	m_segments[0].TxSize = 1;
+	
+	/* cmd: write CONFIG and MODE registers of next step */
+	AD779X_SeqFrameStep(pDevice, &pSeq->pSteps[pSeq->Step], &m_tx[m_size], m_segments, &m_count);
+	
+	AD779X_TRACE_BEGIN(trcFrame, pDevice);
+	
+	/* active cs line */
+	pDevice->CSControl(cssEnable);
+	
+	AD779X_ExchangeSegments(pDevice, m_tx, m_rx, m_segments, m_count);
+	
+	/* inactive cs line */
+	pDevice->CSControl(cssDisable);
+	
+	AD779X_TRACE_END(trcFrame, pDevice);
+	
+	/* next step is set: conversion restarts */
+	if (m_count > 1)
+		AD779X_StartDeadline(pDevice, mdsContinuous, mdsContinuous);
+	
+	AD779X_CountResult(pDevice, 0);
+	
+	return AD779X_MakeSample24(pDevice, &m_rx[1]);
+}
+
+/**
+ * @brief  Init transaction: no commands
+ * @param  pTrans - transaction
+ * @return None
+ */
+void AD779X_TransInit(tAD779X_Transaction *pTrans)
+{
+	pTrans->Count = 0;
+	pTrans->Size  = 0;
+}
+
+/**
+ * @brief  Queue command with data in transaction
+ * @param  pTrans - transaction
+ * @param  Size - size of segment
+ * @param  TxSize - count of written bytes of segment
+ * @return Number of command or AD779X_TRANS_FULL
+ */
+static uint8_t AD779X_TransQueue(tAD779X_Transaction *pTrans, uint8_t Size, uint8_t TxSize)
+{
+	if ((pTrans->Count >= AD779X_TRANS_OPS) || (pTrans->Size + Size > AD779X_TRANS_SIZE))
+		return AD779X_TRANS_FULL;
+	
+	pTrans->Segments[pTrans->Count].Size   = Size;
+	pTrans->Segments[pTrans->Count].TxSize = TxSize;
+	pTrans->Size += Size;
+	
+	return pTrans->Count++;
+}
+
+/**
+ * @brief  Queue register write in transaction
+ * @param  pTrans - transaction
+ * @param  Cmd - write command (AD779X_WRR_xxx)
+ * @param  Data - register value
+ * @param  Size - size of register, bytes (1..3)
+ * @return Number of command or AD779X_TRANS_FULL
+ */
+uint8_t AD779X_TransWrite(tAD779X_Transaction *pTrans, uint8_t Cmd, unsigned long Data, uint8_t Size)
+{
+	uint8_t *m_frame = &pTrans->Tx[pTrans->Size];
+	uint8_t m_op = AD779X_TransQueue(pTrans, Size + 1, Size + 1);
+	
+	if (m_op != AD779X_TRANS_FULL)
+	{
+		/* cmd, then data MSB first */
+		m_frame[0] = Cmd;
+		
+		while (Size)
+		{
+			m_frame[Size--] = Data & 0xFF;
+			Data >>= 8;
+		}
+	}
+	
+	return m_op;
+}
+
+/**
+ * @brief  Queue register read in transaction
+ * @param  pTrans - transaction
+ * @param  Cmd - read command (AD779X_RDR_xxx)
+ * @param  Size - size of register, bytes (1..3)
+ * @return Number of command or AD779X_TRANS_FULL
+ */
+uint8_t AD779X_TransRead(tAD779X_Transaction *pTrans, uint8_t Cmd, uint8_t Size)
+{
+	uint8_t *m_frame = &pTrans->Tx[pTrans->Size];
+	uint8_t m_op = AD779X_TransQueue(pTrans, Size + 1, 1);
+	
+	if (m_op != AD779X_TRANS_FULL)
+	{
+		/* cmd, then dummy bytes */
+		m_frame[0] = Cmd;
+		
+		while (Size)
+			m_frame[Size--] = 0;
+	}
+	
+	return m_op;
+}
+
+/**
+ * @brief  Queue MODE register write in transaction
+ * @param  pTrans - transaction
+ * @param  Data - need write
+ * @return Number of command or AD779X_TRANS_FULL
+ */
+uint8_t AD779X_TransWriteMode(tAD779X_Transaction *pTrans, unsigned short Data)
+{
+	return AD779X_TransWrite(pTrans, AD779X_WRR_MODE, Data, 2);
+}
+
+/**
+ * @brief  Queue CONFIG register write in transaction
+ * @param  pTrans - transaction
+ * @param  Data - need write
+ * @return Number of command or AD779X_TRANS_FULL
+ */
+uint8_t AD779X_TransWriteConfig(tAD779X_Transaction *pTrans, unsigned short Data)
+{
+	return AD779X_TransWrite(pTrans, AD779X_WRR_CONFIG, Data, 2);
+}
+
+/**
+ * @brief  Queue IO register write in transaction
+ * @param  pTrans - transaction
+ * @param  Data - need write
+ * @return Number of command or AD779X_TRANS_FULL
+ */
+uint8_t AD779X_TransWriteIO(tAD779X_Transaction *pTrans, unsigned char Data)
+{
+	return AD779X_TransWrite(pTrans, AD779X_WRR_IO, Data, 1);
+}
+
+/**
+ * @brief  Get value of queued command (read data after execute)
+ * @param  pTrans - transaction
+ * @param  Op - number of command
+ * @return Register value
+ */
+unsigned long AD779X_TransResult(tAD779X_Transaction *pTrans, uint8_t Op)
+{
+	const uint8_t *m_frame = (pTrans->Segments[Op].TxSize == 1) ? pTrans->Rx : pTrans->Tx;
+	unsigned long m_value = 0;
+	uint8_t i, m_offset = 0;
+	
+	for (i = 0; i < Op; i++)
+		m_offset += pTrans->Segments[i].Size;
+	
+	/* skip cmd, data MSB first */
+	for (i = 1; i < pTrans->Segments[Op].Size; i++)
+		m_value = (m_value << 8) | m_frame[m_offset + i];
+	
+	return m_value;
+}
+
+/**
+ * @brief  Execute transaction: all commands in one cs window
+ * @param  pDevice - ADC device
+ * @param  pTrans - transaction
+ * @return None
+ */
+void AD779X_TransExecute(tAD779X_Device *pDevice, tAD779X_Transaction *pTrans)
+{
+	uint8_t i, m_offset = 0;
+	uint8_t m_restart = 0, m_mode = pDevice->ModeReg.MODE, m_prev = pDevice->ModeReg.MODE;
+	
+	if (!pTrans->Count)
+		return;
+	
+	AD779X_TRACE_BEGIN(trcFrame, pDevice);
+	
+	/* active cs line */
+	pDevice->CSControl(cssEnable);
+	
+	AD779X_ExchangeSegments(pDevice, pTrans->Tx, pTrans->Rx, pTrans->Segments, pTrans->Count);
+	
+	/* inactive cs line */
+	pDevice->CSControl(cssDisable);
+	
+	AD779X_TRACE_END(trcFrame, pDevice);
+	
+	/* store written values of MODE, CONFIG and IO registers */
+	for (i = 0; i < pTrans->Count; i++)
+	{
+		switch (pTrans->Tx[m_offset])
+		{
+			case AD779X_WRR_MODE:
+				pDevice->ModeReg.DATA = AD779X_TransResult(pTrans, i);
+				m_mode = pDevice->ModeReg.MODE;
+				m_restart = 1;
+				if (AD779X_MODE_IS_ONESHOT(pDevice->ModeReg.MODE))
+					pDevice->ModeReg.MODE = AD779X_MODE_AFTER_ONESHOT(pDevice->ModeReg.MODE);
+				break;
 			
-		case ad7793:
-			m_data_sample = (m_data[2]<<8)|m_data[1];
-			break;
+			case AD779X_WRR_CONFIG:
+				pDevice->ConfigReg.DATA = AD779X_TransResult(pTrans, i);
+				m_restart = 1;
+				break;
+			
+			case AD779X_WRR_IO:
+				pDevice->IOReg.DATA = AD779X_TransResult(pTrans, i);
+				break;
+		}
+		
+		m_offset += pTrans->Segments[i].Size;
 	}
 	
-	return m_data_sample;
+	/* conversion restarts after MODE or CONFIG write */
+	if (m_restart)
+		AD779X_StartDeadline(pDevice, m_mode, m_prev);
+}
+
+/**
+ * @brief  Set CONFIG, MODE and IO registers in one cs window,
+ *         registers with unchanged value are not written
+ * @param  pDevice - ADC device
+ * @param  Config - CONFIG register value
+ * @param  Mode - MODE register value
+ * @param  IO - IO register value
+ * @return None
+ */
+void AD779X_SetConfiguration(tAD779X_Device *pDevice, unsigned short Config, unsigned short Mode, unsigned char IO)
+{
+	tAD779X_Transaction m_trans;
+	tAD779X_ModeRegister m_mode_reg;
+	
+	m_mode_reg.DATA = Mode;
+	
+	AD779X_TransInit(&m_trans);
+	
+	if (IO != pDevice->IOReg.DATA)
+		AD779X_TransWriteIO(&m_trans, IO);
+	
+	if (Config != pDevice->ConfigReg.DATA)
+		AD779X_TransWriteConfig(&m_trans, Config);
+	
+	/* MODE register is last: conversion starts with new configuration */
+	if ((Mode != pDevice->ModeReg.DATA) || AD779X_MODE_IS_ONESHOT(m_mode_reg.MODE))
+		AD779X_TransWriteMode(&m_trans, Mode);
+	
+	AD779X_TransExecute(pDevice, &m_trans);
+}
+
+/**
+ * @brief  Restore calibration coefficients in one cs window: stop conversion
+ *         (FULL-SCALE register is written only in Idle/Power-down mode), select
+ *         update rate, channel and gain of entry, write OFFSET and FULL-SCALE
+ *         registers, restore previous mode
+ * @param  pDevice - ADC device
+ * @param  pEntry - calibration coefficients
+ * @return None
+ */
+void AD779X_WriteCalibration(tAD779X_Device *pDevice, const tAD779X_CalEntry *pEntry)
+{
+	const uint8_t m_size = (AD779X_MODEL(*pDevice) == ad7793) ? 3 : 2;
+	tAD779X_ConfigRegister m_config_reg = pDevice->ConfigReg;
+	tAD779X_ModeRegister m_mode_reg = pDevice->ModeReg;
+	tAD779X_ModeRegister m_stop_reg;
+	tAD779X_Transaction m_trans;
+	
+	m_config_reg.CHSEL = pEntry->Channel;
+	m_config_reg.GAIN  = pEntry->Gain;
+	
+	if (pEntry->Rate != fsNone)
+		m_mode_reg.FS = pEntry->Rate;
+	
+	/* Power-down mode is kept, other modes are stopped by Idle mode */
+	m_stop_reg = m_mode_reg;
+	
+	if (m_stop_reg.MODE != mdsPowerDown)
+		m_stop_reg.MODE = mdsIdle;
+	
+	AD779X_TransInit(&m_trans);
+	
+	if (m_stop_reg.DATA != pDevice->ModeReg.DATA)
+		AD779X_TransWriteMode(&m_trans, m_stop_reg.DATA);
+	
+	/* coefficient registers of selected channel are accessed */
+	if (m_config_reg.DATA != pDevice->ConfigReg.DATA)
+		AD779X_TransWriteConfig(&m_trans, m_config_reg.DATA);
+	
+	AD779X_TransWrite(&m_trans, AD779X_WRR_OFFSET, pEntry->Offset, m_size);
+	AD779X_TransWrite(&m_trans, AD779X_WRR_FSCLAE, pEntry->FScale, m_size);
+	
+	/* previous mode: conversion restarts with restored coefficients */
+	if (m_mode_reg.DATA != m_stop_reg.DATA)
+		AD779X_TransWriteMode(&m_trans, m_mode_reg.DATA);
+	
+	AD779X_TransExecute(pDevice, &m_trans);
 }
+
+/**
+ * @brief  Read calibration coefficients of selected channel, gain and rate
+ *         (after AD779X_StartZSCalibration and AD779X_StartFSCalibration)
+ * @param  pDevice - ADC device
+ * @param  pEntry - calibration coefficients
+ * @return None
+ */
+void AD779X_ReadCalibration(tAD779X_Device *pDevice, tAD779X_CalEntry *pEntry)
+{
+	const uint8_t m_size = (AD779X_MODEL(*pDevice) == ad7793) ? 3 : 2;
+	tAD779X_Transaction m_trans;
+	uint8_t m_offset, m_fscale;
+	
+	AD779X_TransInit(&m_trans);
+	m_offset = AD779X_TransRead(&m_trans, AD779X_RDR_OFFSET, m_size);
+	m_fscale = AD779X_TransRead(&m_trans, AD779X_RDR_FSCLAE, m_size);
+	AD779X_TransExecute(pDevice, &m_trans);
+	
+	pEntry->Channel = pDevice->ConfigReg.CHSEL;
+	pEntry->Gain = pDevice->ConfigReg.GAIN;
+	pEntry->Rate = pDevice->ModeReg.FS;
+	pEntry->Reserved = 0;
+	pEntry->Offset = AD779X_TransResult(&m_trans, m_offset);
+	pEntry->FScale = AD779X_TransResult(&m_trans, m_fscale);
+}
+
+/**
+ * @brief  Wait for result: sleep until predicted deadline (GetTimeUs, DelayUs),
+ *         then check RDY line; without GetTimeUs - TimeoutUs checks of RDY line
+ * @param  pDevice - ADC device
+ * @param  TimeoutUs - max time of waiting, us
+ * @return 1 - data ready, 0 - timeout
+ */
+unsigned char AD779X_WaitReady(tAD779X_Device *pDevice, uint32_t TimeoutUs)
+{
+	uint32_t m_start, m_polls = 0;
+	int32_t m_remain;
+	
+	if (pDevice->GetTimeUs)
+	{
+		m_start = pDevice->GetTimeUs();
+		
+		/* sleep until expected end of conversion, no SPI traffic */
+		if (pDevice->DeadlineSet && pDevice->DelayUs)
+		{
+			m_remain = (int32_t)(pDevice->Deadline - m_start);
+			
+			if (m_remain > 0)
+				pDevice->DelayUs(((uint32_t)m_remain < TimeoutUs) ? (uint32_t)m_remain : TimeoutUs);
+		}
+		
+		while (!AD779X_CheckReadyHW(pDevice))
+		{
+			if ((pDevice->GetTimeUs() - m_start) >= TimeoutUs)
+			{
+				AD779X_COUNTER_INC(pDevice->Telemetry.Timeouts);
+				return 0;
+			}
+			
+			/* conversion is late: poll RDY with interval, not each SPI window */
+			if (pDevice->DelayUs)
+				pDevice->DelayUs(AD779X_READY_POLL_US);
+		}
+	}
+	else
+	{
+		while (!AD779X_CheckReadyHW(pDevice))
+		{
+			if (m_polls++ >= TimeoutUs)
+			{
+				AD779X_COUNTER_INC(pDevice->Telemetry.Timeouts);
+				return 0;
+			}
+			
+			if (pDevice->DelayUs)
+				pDevice->DelayUs(1);
+		}
+	}
+	
+	AD779X_NextDeadline(pDevice);
+	
+	return 1;
+}
+
+/**
+ * @brief  Single conversion: set channel, gain and rate with trigger in one cs window,
+ *         wait result (AD779X_WaitReady), read it and set Idle/Power-down in one cs window
+ * @param  pDevice - ADC device
+ * @param  Channel - channel
+ * @param  Gain - gain
+ * @param  Rate - filter update rate
+ * @param  Policy - state of ADC after shot
+ * @param  pSample - sample value (24-bit range)
+ * @param  pStats - statistics, may be NULL
+ * @return 1 - sample is read, 0 - timeout
+ */
+unsigned char AD779X_SingleShot(tAD779X_Device *pDevice, tAD779X_ChSelect Channel, tAD779X_GainSelect Gain, tAD779X_FilterSelect Rate, tAD779X_ShotPolicy Policy, unsigned long *pSample, tAD779X_ShotStats *pStats)
+{
+	const uint8_t m_size = (AD779X_MODEL(*pDevice) == ad7793) ? 3 : 2;
+	tAD779X_ConfigRegister m_config_reg = pDevice->ConfigReg;
+	tAD779X_ModeRegister m_mode_reg = pDevice->ModeReg;
+	tAD779X_Transaction m_trans;
+	uint32_t m_start = 0, m_end;
+	unsigned long m_expected;
+	uint8_t m_ready;
+	
+	m_config_reg.CHSEL = Channel;
+	m_config_reg.GAIN  = Gain;
+	
+	m_mode_reg.MODE = mdsSingle;
+	m_mode_reg.FS   = Rate;
+	
+	/* single conversion takes settling time, after Power-down oscillator powers up first */
+	m_expected = AD779X_SettlingTimeUs(Rate, (tAD779X_ClkSourceSelect)m_mode_reg.CLKS);
+	
+	if (pDevice->ModeReg.MODE == mdsPowerDown)
+		m_expected += AD779X_POWER_UP_US;
+	
+	if (pDevice->GetTimeUs)
+		m_start = pDevice->GetTimeUs();
+	
+	/* config and trigger in one cs window, MODE is last: conversion starts */
+	AD779X_TransInit(&m_trans);
+	
+	if (m_config_reg.DATA != pDevice->ConfigReg.DATA)
+		AD779X_TransWriteConfig(&m_trans, m_config_reg.DATA);
+	
+	AD779X_TransWriteMode(&m_trans, m_mode_reg.DATA);
+	AD779X_TransExecute(pDevice, &m_trans);
+	
+	/* timeout with margin */
+	m_ready = AD779X_WaitReady(pDevice, 2 * m_expected);
+	
+	/* read result and set mode in one cs window: ADC is in Power-down after
+	   conversion, Idle must be written; write also stops conversion on timeout */
+	AD779X_TransInit(&m_trans);
+	
+	if (m_ready)
+		AD779X_TransRead(&m_trans, AD779X_RDR_DATA, m_size);
+	
+	m_mode_reg.MODE = (Policy == sspPowerDown) ? mdsPowerDown : mdsIdle;
+	AD779X_TransWriteMode(&m_trans, m_mode_reg.DATA);
+	
+	AD779X_TransExecute(pDevice, &m_trans);
+	
+	if (m_ready)
+	{
+		*pSample = AD779X_MakeSample24(pDevice, &m_trans.Rx[1]);
+		AD779X_CountResult(pDevice, 0);
+	}
+	
+	if (pStats)
+	{
+		pStats->Shots++;
+		
+		if (!m_ready)
+			pStats->Timeouts++;
+		
+		if (pDevice->GetTimeUs)
+		{
+			m_end = pDevice->GetTimeUs();
+			
+			pStats->LastUs = m_end - m_start;
+			pStats->ActiveUs += pStats->LastUs;
+			pStats->ElapsedUs += (pStats->Shots > 1) ? m_end - pStats->EndUs : pStats->LastUs;
+			pStats->EndUs = m_end;
+			
+			if (pStats->ElapsedUs)
+				pStats->DutyPermille = (uint16_t)((pStats->ActiveUs * 1000) / pStats->ElapsedUs);
+		}
+	}
+	
+	return m_ready;
+}
+
+/**
+ * @brief  Get snapshot of telemetry counters (may be called while counters
+ *         are updated by interrupt or other thread)
+ * @param  pDevice - ADC device
+ * @param  pSnapshot - counters
+ * @return None
+ */
+void AD779X_GetTelemetry(tAD779X_Device *pDevice, tAD779X_Telemetry *pSnapshot)
+{
+	uint8_t i;
+	
+	pSnapshot->Conversions = AD779X_COUNTER_GET(pDevice->Telemetry.Conversions);
+	
+	for (i = 0; i < 8; i++)
+		pSnapshot->Errors[i] = AD779X_COUNTER_GET(pDevice->Telemetry.Errors[i]);
+	
+	pSnapshot->Timeouts    = AD779X_COUNTER_GET(pDevice->Telemetry.Timeouts);
+	pSnapshot->Overruns    = AD779X_COUNTER_GET(pDevice->Telemetry.Overruns);
+	pSnapshot->DetectFails = AD779X_COUNTER_GET(pDevice->Telemetry.DetectFails);
+}
\ No newline at end of file
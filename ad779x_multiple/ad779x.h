@@ -15,6 +15,12 @@
 #define AD779X_H
 
 #include <stdint.h>
+#include <stddef.h>
+
+/**
+ * @brief Driver variant: any count of devices, tAD779X_Device passed to each function
+ */
+#define AD779X_VARIANT_MULTIPLE
 
 /**
  * @brief Register address description
@@ -52,7 +58,7 @@
 #define AD779X_WRR_MODE   ((AD779X_REG_MODE   | AD779X_COMM_WMODE) & AD779X_COMM_CMACK)
 #define AD779X_WRR_CONFIG ((AD779X_REG_CONFIG | AD779X_COMM_WMODE) & AD779X_COMM_CMACK)
 #define AD779X_WRR_OFFSET ((AD779X_REG_OFFSET | AD779X_COMM_WMODE) & AD779X_COMM_CMACK)
-#define AD779X_WRR_FSCLAE ((AD779X_REG_FSCLAE | AD779X_COMM_WMODE) & AD779X_COMM_CMACK)
+#define AD779X_WRR_FSCLAE ((AD779X_REG_FSCALE | AD779X_COMM_WMODE) & AD779X_COMM_CMACK)
 
 /**
  * @brief Read operations with registers
@@ -64,7 +70,8 @@
 #define AD779X_RDR_DATA   ((AD779X_REG_DATA   | AD779X_COMM_RMODE) & AD779X_COMM_CMACK)
 #define AD779X_RDR_CONFIG ((AD779X_REG_CONFIG | AD779X_COMM_RMODE) & AD779X_COMM_CMACK)
 #define AD779X_RDR_OFFSET ((AD779X_REG_OFFSET | AD779X_COMM_RMODE) & AD779X_COMM_CMACK)
-#define AD779X_RDR_FSCLAE ((AD779X_REG_FSCLAE | AD779X_COMM_RMODE) & AD779X_COMM_CMACK)
+#define AD779X_RDR_FSCLAE ((AD779X_REG_FSCALE | AD779X_COMM_RMODE) & AD779X_COMM_CMACK)
+#define AD779X_RDR_CREED  ((AD779X_REG_DATA   | AD779X_COMM_RMODE | AD779X_COMM_CREED) & AD779X_COMM_CMACK)
 
 /**
  * @brief ADC type's ID
@@ -103,6 +110,17 @@ typedef enum
 	mdsSysFullCal  /*!< System Full-Scale Calibration */
 } tAD779X_ModeSelect;
 
+/**
+ * @brief One-shot modes: ADC leaves mode by itself when operation is complete
+ */
+#define AD779X_MODE_IS_ONESHOT(mode) (((mode) == mdsSingle) || ((mode) >= mdsIntZeroCal))
+
+/**
+ * @brief Mode after one-shot operation: Power-down after single conversion,
+ *        Idle after calibration
+ */
+#define AD779X_MODE_AFTER_ONESHOT(mode) (((mode) == mdsSingle) ? mdsPowerDown : mdsIdle)
+
 /**
  * @brief Clock source select value
  */
@@ -322,6 +340,18 @@ typedef union
 	unsigned char  u8[4]; /*!< 4x8 bit */
 } tAD779X_DataSample;
 
+/**
+ * @brief Power-On/Reset offset register value
+ */
+#define AD779X_OFFSET_RESET_24 (0x800000)
+#define AD779X_OFFSET_RESET_16 (0x8000)
+
+/**
+ * @brief Power-On/Reset full-scale register value
+ */
+#define AD779X_FULLSCALE_RESET_24 (0x500000)
+#define AD779X_FULLSCALE_RESET_16 (0x5000)
+
 /**
  * @brief Model of AD779X
  */
@@ -332,6 +362,17 @@ typedef enum
 	ad7793
 } tAD779X_Model;
 
+/**
+ * @brief Model used by read path. Define AD779X_FIXED_MODEL as ad7792 or ad7793,
+ *        if all boards have one model: model checks are resolved at compile time.
+ *        Without it model is detected at runtime by AD779X_HWDetect
+ */
+#if defined(AD779X_FIXED_MODEL)
+#define AD779X_MODEL(Device) (AD779X_FIXED_MODEL)
+#else
+#define AD779X_MODEL(Device) ((Device).Model)
+#endif
+
 /**
  * @brief AD779X startup status
  */
@@ -354,21 +395,293 @@ typedef enum
 	rdsBusy
 } tAD779X_RDState;
 
+/**
+ * @brief Data register read mode
+ */
+typedef enum
+{
+	rdmSingle,    /*!< every data read starts with command byte (default) */
+	rdmContinuous /*!< continuous read: data is clocked out on each RDY, cs line held active */
+} tAD779X_ReadMode;
+
+/**
+ * @brief Memory barrier between ring data and ring index access
+ */
+#ifndef AD779X_MEMORY_BARRIER
+#if defined(__GNUC__)
+#define AD779X_MEMORY_BARRIER() __sync_synchronize()
+#else
+#define AD779X_MEMORY_BARRIER()
+#endif
+#endif
+
+/**
+ * @brief Telemetry counter update/read: relaxed atomic (no ordering, only
+ *        no torn values), if 32-bit int is lock-free; else plain access (no
+ *        atomic builtins, or they are library calls: Cortex-M0, AVR)
+ */
+#ifndef AD779X_COUNTER_INC
+#if defined(__GNUC__) && defined(__GCC_ATOMIC_INT_LOCK_FREE) && (__GCC_ATOMIC_INT_LOCK_FREE == 2) && (__SIZEOF_INT__ >= 4)
+#define AD779X_COUNTER_ADD(Counter, Value) __atomic_fetch_add(&(Counter), (Value), __ATOMIC_RELAXED)
+#define AD779X_COUNTER_GET(Counter) __atomic_load_n(&(Counter), __ATOMIC_RELAXED)
+#else
+#define AD779X_COUNTER_ADD(Counter, Value) ((Counter) += (Value))
+#define AD779X_COUNTER_GET(Counter) (Counter)
+#endif
+#define AD779X_COUNTER_INC(Counter) AD779X_COUNTER_ADD(Counter, 1)
+#endif
+
+/**
+ * @brief Traced operation: cs window of one command is named by register and
+ *        direction of command (AD779X_TRACE_OP), cs window of several commands
+ *        is trcFrame
+ */
+typedef enum
+{
+	trcReadStatus  = 0x00, /*!< read STATUS register */
+	trcReadData    = 0x03, /*!< read DATA register (with STATUS in AD779X_OnDataReady, AD779X_ReadSampleRecord) */
+	trcDetect      = 0x04, /*!< read ID register */
+	trcReadOffset  = 0x06, /*!< read OFFSET register */
+	trcReadFScale  = 0x07, /*!< read FULL-SCALE register */
+	trcWriteMode   = 0x09, /*!< write MODE register */
+	trcWriteConfig = 0x0A, /*!< write CONFIG register */
+	trcWriteIO     = 0x0D, /*!< write IO register */
+	trcWriteOffset = 0x0E, /*!< write OFFSET register */
+	trcWriteFScale = 0x0F, /*!< write FULL-SCALE register */
+	trcReset       = 0x10, /*!< reset: 32 ones */
+	trcPollReady   = 0x11, /*!< check of RDY line */
+	trcFrame       = 0x12, /*!< several commands: sequencer, transaction */
+	trcCount       = 0x13
+} tAD779X_TraceOp;
+
+#define AD779X_TRACE_OP(Cmd) ((tAD779X_TraceOp)(((Cmd) == 0xFF) ? trcReset : \
+	((((Cmd) & AD779X_COMM_RMODE) ? 0x00 : 0x08) | (((Cmd) >> 3) & 0x07))))
+
+/**
+ * @brief Hooks around each cs window: AD779X_TRACE_BEGIN(Op, pDevice) before
+ *        active cs line, AD779X_TRACE_END(Op, pDevice) after inactive cs line.
+ *        Hooks may be defined by build flags; AD779X_TRACE selects histograms
+ *        of ad779x_utils/ad779x_trace.c; by default hooks are empty.
+ */
+#if defined(AD779X_TRACE)
+#include "ad779x_trace.h"
+#define AD779X_TRACE_BEGIN(Op, pDevice) uint32_t m_trace_start = AD779X_TRACE_CYCLES()
+#define AD779X_TRACE_END(Op, pDevice) AD779X_TraceRecord((Op), AD779X_TRACE_CYCLES() - m_trace_start)
+#endif
+
+#ifndef AD779X_TRACE_BEGIN
+#define AD779X_TRACE_BEGIN(Op, pDevice)
+#define AD779X_TRACE_END(Op, pDevice)
+#endif
+
+/**
+ * @brief Sample pushed to ring by data ready interrupt
+ */
+typedef struct
+{
+	uint32_t Code;    /*!< Data sample value (24-bit range) */
+	uint8_t  Status;  /*!< STATUS register value (continuous read mode: channel from CONFIG register) */
+	uint8_t  Channel; /*!< Converted channel (AD779X_SR_CHC) */
+} tAD779X_RingSample;
+
+/**
+ * @brief Sample record: data with STATUS register, time and number of read
+ *        (Sequence: two reads of one conversion get two numbers, a conversion
+ *        without read gets none, so gaps are not missed conversions)
+ */
+typedef struct
+{
+	uint32_t Code;      /*!< Data sample value (24-bit range) */
+	uint32_t Timestamp; /*!< Time of read (GetTimeUs), us; valid with AD779X_RECORD_TIMESTAMP */
+	uint32_t Sequence;  /*!< Number of AD779X_ReadSampleRecord call of device (counts reads, not conversions) */
+	uint8_t  Status;    /*!< STATUS register value (AD779X_SR_ERR, AD779X_SR_CHC); see AD779X_RECORD_SYNTH_STATUS */
+	uint8_t  Channel;   /*!< Converted channel (AD779X_SR_CHC) */
+	uint8_t  Flags;     /*!< AD779X_RECORD_xxx */
+} tAD779X_SampleRecord;
+
+/**
+ * @brief Flags of sample record
+ */
+#define AD779X_RECORD_SYNTH_STATUS 0x01  /*!< continuous read mode: STATUS is not read, channel is from CONFIG register, other bits are 0 */
+#define AD779X_RECORD_TIMESTAMP    0x02  /*!< Timestamp is set (device has GetTimeUs), any value is valid time, 0 too */
+
+/**
+ * @brief Telemetry counters of device
+ */
+typedef struct
+{
+	uint32_t Conversions; /*!< Results read from DATA register */
+	uint32_t Errors[8];   /*!< Results with AD779X_SR_ERR (clamped), per channel; counted where STATUS is read with DATA */
+	uint32_t Timeouts;    /*!< AD779X_WaitReady without result */
+	uint32_t Overruns;    /*!< Lost results: ring is full, results skipped between AD779X_WaitReady calls */
+	uint32_t DetectFails; /*!< AD779X_HWDetect without supported model */
+} tAD779X_Telemetry;
+
+/**
+ * @brief Lock-free single-producer (ISR) / single-consumer sample ring
+ */
+typedef struct
+{
+	tAD779X_RingSample *pBuffer; /*!< storage for (Mask + 1) samples */
+	uint16_t Mask;               /*!< size of ring - 1, size is power of 2 (Size of RingInit rounded down) */
+	volatile uint16_t Head;      /*!< write index, changed by producer only */
+	volatile uint16_t Tail;      /*!< read index, changed by consumer only */
+	volatile uint16_t Overruns;  /*!< count of samples dropped: ring is full */
+} tAD779X_SampleRing;
+
+/**
+ * @brief Scan sequencer step
+ */
+typedef struct
+{
+	tAD779X_ChSelect     Channel; /*!< Channel Select */
+	tAD779X_GainSelect   Gain;    /*!< Gain Select */
+	tAD779X_FilterSelect Rate;    /*!< Filter Update Rate Select */
+} tAD779X_ScanStep;
+
+/**
+ * @brief Round-robin scan sequencer
+ */
+typedef struct
+{
+	const tAD779X_ScanStep *pSteps; /*!< table of steps */
+	uint8_t Count;                  /*!< count of steps */
+	uint8_t Step;                   /*!< step being converted now */
+} tAD779X_Sequencer;
+
+/**
+ * @brief Frame segment: one command with data
+ */
+typedef struct
+{
+	uint8_t Size;   /*!< size of segment */
+	uint8_t TxSize; /*!< count of first bytes written to ADC, other bytes are read */
+} tAD779X_Segment;
+
+/**
+ * @brief Transaction limits: size of frame and count of commands
+ */
+#ifndef AD779X_TRANS_SIZE
+#define AD779X_TRANS_SIZE 32
+#endif
+#ifndef AD779X_TRANS_OPS
+#define AD779X_TRANS_OPS 8
+#endif
+
+/**
+ * @brief Command can not be queued: transaction is full
+ */
+#define AD779X_TRANS_FULL 0xFF
+
+/**
+ * @brief State of ADC after single shot
+ */
+typedef enum
+{
+	sspIdle      = 0, /*!< Idle: fast next shot, oscillator is running */
+	sspPowerDown = 1  /*!< Power-down: min current, next shot is longer by AD779X_POWER_UP_US */
+} tAD779X_ShotPolicy;
+
+/**
+ * @brief Statistics of single shots (zero before first shot), times need GetTimeUs
+ */
+typedef struct
+{
+	uint32_t Shots;        /*!< Count of shots */
+	uint32_t Timeouts;     /*!< Shots without result */
+	uint32_t LastUs;       /*!< Time of last shot: trigger to power-down/idle, us */
+	uint32_t EndUs;        /*!< End time of last shot, us */
+	uint64_t ActiveUs;     /*!< Sum of shot times, us */
+	uint64_t ElapsedUs;    /*!< Time from start of first shot to end of last shot, us */
+	uint16_t DutyPermille; /*!< Duty cycle: ActiveUs / ElapsedUs, 1/1000 */
+} tAD779X_ShotStats;
+
+/**
+ * @brief Clock frequency: internal and external (cssExt, cssExtDiv2), Hz
+ */
+#define AD779X_INT_CLK_HZ 64000UL
+#ifndef AD779X_EXT_CLK_HZ
+#define AD779X_EXT_CLK_HZ 64000UL
+#endif
+
+/**
+ * @brief Power-up time of internal oscillator after Power-down mode: first
+ *        conversion after Power-down ends later by this time, us
+ */
+#define AD779X_POWER_UP_US 1000UL
+
+/**
+ * @brief Interval of RDY polls after expected end of conversion, us
+ */
+#ifndef AD779X_READY_POLL_US
+#define AD779X_READY_POLL_US 100
+#endif
+
+/**
+ * @brief Max reads of RDY line in continuous read mode without GetTimeUs
+ */
+#ifndef AD779X_RDY_POLLS
+#define AD779X_RDY_POLLS 10000000UL
+#endif
+
+/**
+ * @brief Sample value of continuous read on RDY timeout (out of 24-bit range)
+ */
+#define AD779X_SAMPLE_TIMEOUT 0xFFFFFFFFUL
+
+/**
+ * @brief Calibration coefficients of channel for gain and update rate
+ */
+typedef struct
+{
+	uint8_t  Channel;  /*!< tAD779X_ChSelect */
+	uint8_t  Gain;     /*!< tAD779X_GainSelect */
+	uint8_t  Rate;     /*!< tAD779X_FilterSelect */
+	uint8_t  Reserved;
+	uint32_t Offset;   /*!< OFFSET register value */
+	uint32_t FScale;   /*!< FULL-SCALE register value */
+} tAD779X_CalEntry;
+
+/**
+ * @brief Several register reads/writes executed in one cs window
+ */
+typedef struct
+{
+	uint8_t Tx[AD779X_TRANS_SIZE];                /*!< frame for send */
+	uint8_t Rx[AD779X_TRANS_SIZE];                /*!< received frame */
+	tAD779X_Segment Segments[AD779X_TRANS_OPS];   /*!< one segment per command */
+	uint8_t Count;                                /*!< count of commands */
+	uint8_t Size;                                 /*!< size of frame */
+} tAD779X_Transaction;
+
 typedef void (* tAD779X_TxByte)(unsigned char Data);
 typedef unsigned char (* tAD779X_RxByte)(void);
 typedef void (* tAD779X_CSControl)(unsigned char State);
 typedef unsigned char (* tAD779X_RDYState)(void);
+typedef void (* tAD779X_TxRxBlock)(const uint8_t *pTxData, uint8_t *pRxData, size_t Size);
+typedef uint32_t (* tAD779X_GetTimeUs)(void);
+typedef void (* tAD779X_DelayUs)(uint32_t Us);
 
 typedef struct
 {
 	tAD779X_Model Model;
 	tAD779X_StartUpState SuState;
+	tAD779X_ReadMode ReadMode;
 	tAD779X_ModeRegister ModeReg;
+	tAD779X_ConfigRegister ConfigReg;
 	tAD779X_IORegister IOReg;
 	tAD779X_CSControl CSControl;
 	tAD779X_RDYState RDYState;
 	tAD779X_TxByte TxByte;
 	tAD779X_RxByte RxByte;
+	tAD779X_TxRxBlock TxRxBlock; /*!< optional full-duplex block transfer, if NULL - TxByte/RxByte used */
+	tAD779X_SampleRing *pRing;   /*!< ring for AD779X_OnDataReady, may be NULL */
+	tAD779X_GetTimeUs GetTimeUs; /*!< optional free-running time, us; if NULL - no deadlines */
+	tAD779X_DelayUs DelayUs;     /*!< optional sleep, us */
+	uint32_t Deadline;           /*!< expected time of next result, us */
+	uint8_t DeadlineSet;         /*!< Deadline is valid */
+	uint32_t Sequence;           /*!< number of next sample record (free-running) */
+	tAD779X_Telemetry Telemetry; /*!< telemetry counters, see AD779X_GetTelemetry */
 } tAD779X_Device;
 
 void AD779X_Init(tAD779X_Device *pDevice);
@@ -383,13 +696,60 @@ unsigned char AD779X_CheckReadyHW(tAD779X_Device *pDevice);
 void AD779X_SetMode(tAD779X_Device *pDevice, tAD779X_ModeSelect Mode);
 void AD779X_SetClkSource(tAD779X_Device *pDevice, tAD779X_ClkSourceSelect ClkSource);
 void AD779X_SetUpdateRate(tAD779X_Device *pDevice, tAD779X_FilterSelect UpdateRates);
+void AD779X_SetChannel(tAD779X_Device *pDevice, tAD779X_ChSelect Channel);
+void AD779X_SetGain(tAD779X_Device *pDevice, tAD779X_GainSelect Gain);
+void AD779X_SetPolarity(tAD779X_Device *pDevice, tAD779X_BSelect Polarity);
+void AD779X_SetBuffer(tAD779X_Device *pDevice, tAD779X_BufSelect Buffer);
+void AD779X_SetReference(tAD779X_Device *pDevice, tAD779X_RefSelect Reference);
+void AD779X_SetBias(tAD779X_Device *pDevice, tAD779X_VbiasSelect Bias);
 void AD779X_SetExCurrentValue(tAD779X_Device *pDevice, tAD779X_IEXCENSelect excValue);
 void AD779X_SetExCurrentDirection(tAD779X_Device *pDevice, tAD779X_IEXCDIRSelect excDirection);
 void AD779X_StartZSCalibration(tAD779X_Device *pDevice);
 void AD779X_StartFSCalibration(tAD779X_Device *pDevice);
+unsigned short AD779X_ReadOffsetRegister16(tAD779X_Device *pDevice);
+unsigned long AD779X_ReadOffsetRegister24(tAD779X_Device *pDevice);
+unsigned short AD779X_ReadFScaleRegister16(tAD779X_Device *pDevice);
+unsigned long AD779X_ReadFScaleRegister24(tAD779X_Device *pDevice);
+void AD779X_WriteOffsetRegister16(tAD779X_Device *pDevice, unsigned short Data);
+void AD779X_WriteOffsetRegister24(tAD779X_Device *pDevice, unsigned long Data);
+void AD779X_WriteFScaleRegister16(tAD779X_Device *pDevice, unsigned short Data);
+void AD779X_WriteFScaleRegister24(tAD779X_Device *pDevice, unsigned long Data);
 unsigned short AD779X_ReadDataRegister16(tAD779X_Device *pDevice);
 unsigned long AD779X_ReadDataRegister24(tAD779X_Device *pDevice);
 unsigned short AD779X_ReadDataSample(tAD779X_Device *pDevice);
 uint16_t AD779X_ReadDataSample16(tAD779X_Device *pDevice);
-
+unsigned long AD779X_ReadDataSample24(tAD779X_Device *pDevice);
+void AD779X_StartContinuousRead(tAD779X_Device *pDevice);
+unsigned long AD779X_ReadContinuousSample24(tAD779X_Device *pDevice);
+void AD779X_ReadContinuous24(tAD779X_Device *pDevice, unsigned long *pBuffer, size_t Count);
+unsigned long AD779X_StopContinuousRead(tAD779X_Device *pDevice);
+uint16_t AD779X_RingInit(tAD779X_SampleRing *pRing, tAD779X_RingSample *pBuffer, uint16_t Size);
+uint16_t AD779X_RingCount(tAD779X_SampleRing *pRing);
+uint16_t AD779X_RingRead(tAD779X_SampleRing *pRing, tAD779X_RingSample *pSamples, uint16_t Count);
+void AD779X_OnDataReady(tAD779X_Device *pDevice);
+void AD779X_ReadSampleRecord(tAD779X_Device *pDevice, tAD779X_SampleRecord *pRecord);
+uint8_t AD779X_SeqStart(tAD779X_Device *pDevice, tAD779X_Sequencer *pSeq, const tAD779X_ScanStep *pSteps, uint8_t Count);
+unsigned long AD779X_SeqService(tAD779X_Device *pDevice, tAD779X_Sequencer *pSeq, uint8_t *pStep);
+void AD779X_TransInit(tAD779X_Transaction *pTrans);
+uint8_t AD779X_TransWrite(tAD779X_Transaction *pTrans, uint8_t Cmd, unsigned long Data, uint8_t Size);
+uint8_t AD779X_TransRead(tAD779X_Transaction *pTrans, uint8_t Cmd, uint8_t Size);
+uint8_t AD779X_TransWriteMode(tAD779X_Transaction *pTrans, unsigned short Data);
+uint8_t AD779X_TransWriteConfig(tAD779X_Transaction *pTrans, unsigned short Data);
+uint8_t AD779X_TransWriteIO(tAD779X_Transaction *pTrans, unsigned char Data);
+void AD779X_TransExecute(tAD779X_Device *pDevice, tAD779X_Transaction *pTrans);
+unsigned long AD779X_TransResult(tAD779X_Transaction *pTrans, uint8_t Op);
+void AD779X_SetConfiguration(tAD779X_Device *pDevice, unsigned short Config, unsigned short Mode, unsigned char IO);
+void AD779X_WriteCalibration(tAD779X_Device *pDevice, const tAD779X_CalEntry *pEntry);
+void AD779X_ReadCalibration(tAD779X_Device *pDevice, tAD779X_CalEntry *pEntry);
+unsigned long AD779X_ConversionTimeUs(tAD779X_FilterSelect Rate, tAD779X_ClkSourceSelect ClkSource);
+unsigned long AD779X_SettlingTimeUs(tAD779X_FilterSelect Rate, tAD779X_ClkSourceSelect ClkSource);
+unsigned char AD779X_WaitReady(tAD779X_Device *pDevice, uint32_t TimeoutUs);
+unsigned char AD779X_SingleShot(tAD779X_Device *pDevice, tAD779X_ChSelect Channel, tAD779X_GainSelect Gain, tAD779X_FilterSelect Rate, tAD779X_ShotPolicy Policy, unsigned long *pSample, tAD779X_ShotStats *pStats);
+void AD779X_GetTelemetry(tAD779X_Device *pDevice, tAD779X_Telemetry *pSnapshot);
+
+#if defined(AD779X_CORE_SHIM)
+/* core functions are made by ad779x_shim.cpp, it reports each cs window */
+void AD779X_ShimWindow(tAD779X_Device *pDevice, const uint8_t *pTxData, uint8_t Size);
 #endif
+
+#endif
\ No newline at end of file
@@ -0,0 +1,256 @@
+/**
+  ******************************************************************************
+  * @file    ad779x_bus.c
+  * @author  Khusainov Timur
+  * @version 0.0.0.1
+  * @date    16.10.2026
+  * @brief   AD7792/AD7793 devices on shared SPI bus: conversion scheduler
+  ******************************************************************************
+  * @attention
+  * <h2><center>&copy; COPYRIGHT 2011 timypik@gmail.com </center></h2>
+  ******************************************************************************
+  */
+
+#include "ad779x_bus.h"
+
+/**
+ * @brief  Init bus
+ * @param  pBus - bus
+ * @param  pDevices - devices on bus (must be initialized by AD779X_Init)
+ * @param  Count - count of devices (more than AD779X_BUS_MAX - first AD779X_BUS_MAX are used)
+ * @return None
+ */
+void AD779X_BusInit(tAD779X_Bus *pBus, tAD779X_Device *pDevices, uint8_t Count)
+{
+	pBus->pDevices = pDevices;
+	pBus->pSeqs    = 0;
+	pBus->Count    = (Count > AD779X_BUS_MAX) ? AD779X_BUS_MAX : Count;
+	pBus->Next     = 0;
+}
+
+/**
+ * @brief  Start continuous conversion on all devices, one after another:
+ *         conversions of all devices run at the same time
+ * @param  pBus - bus
+ * @return None
+ */
+void AD779X_BusStart(tAD779X_Bus *pBus)
+{
+	uint8_t i;
+	
+	for (i = 0; i < pBus->Count; i++)
+	{
+		if (pBus->pDevices[i].SuState != susActivate)
+			continue;
+		
+		/* no sequencer or empty step table: plain continuous conversion */
+		if (!pBus->pSeqs || !AD779X_SeqStart(&pBus->pDevices[i], &pBus->pSeqs[i], pBus->pSeqs[i].pSteps, pBus->pSeqs[i].Count))
+			AD779X_SetMode(&pBus->pDevices[i], mdsContinuous);
+	}
+	
+	pBus->Next = 0;
+}
+
+/**
+ * @brief  Time limit of RDY on bus: longest settling time of active devices
+ *         with margin (as AD779X_WaitRDY of driver)
+ * @param  pBus - bus
+ * @param  pGetTimeUs - time of bus: GetTimeUs of first active device with it,
+ *         NULL - no device has it, AD779X_RDY_POLLS poll rounds are limit
+ * @return Time limit, us; 0 - no active device on bus
+ */
+static uint32_t AD779X_BusTimeoutUs(tAD779X_Bus *pBus, tAD779X_GetTimeUs *pGetTimeUs)
+{
+	tAD779X_Device *m_device;
+	uint32_t m_timeout, m_max = 0;
+	uint8_t i;
+	
+	*pGetTimeUs = 0;
+	
+	for (i = 0; i < pBus->Count; i++)
+	{
+		m_device = &pBus->pDevices[i];
+		
+		if (m_device->SuState != susActivate)
+			continue;
+		
+		m_timeout = 2 * AD779X_SettlingTimeUs((tAD779X_FilterSelect)m_device->ModeReg.FS, (tAD779X_ClkSourceSelect)m_device->ModeReg.CLKS) + AD779X_POWER_UP_US;
+		
+		if (m_timeout > m_max)
+			m_max = m_timeout;
+		
+		if (!*pGetTimeUs)
+			*pGetTimeUs = m_device->GetTimeUs;
+	}
+	
+	return m_max;
+}
+
+/**
+ * @brief  Read sample of first ready device; devices are checked
+ *         round-robin, so each ready device is served in turn
+ * @param  pBus - bus
+ * @param  pSample - sample value (24-bit range)
+ * @param  pStep - step of scan sequencer, may be NULL
+ * @return Number of served device or AD779X_BUS_NONE
+ */
+uint8_t AD779X_BusPoll(tAD779X_Bus *pBus, unsigned long *pSample, uint8_t *pStep)
+{
+	tAD779X_Device *m_device;
+	uint8_t i, m_index = pBus->Next;
+	uint8_t m_step = 0;
+	
+	for (i = 0; i < pBus->Count; i++)
+	{
+		m_device = &pBus->pDevices[m_index];
+		
+		if ((m_device->SuState == susActivate) && AD779X_CheckReadyHW(m_device))
+		{
+			/* read sample, with sequencer - set next step in same cs window */
+			if (pBus->pSeqs && pBus->pSeqs[m_index].pSteps)
+				*pSample = AD779X_SeqService(m_device, &pBus->pSeqs[m_index], &m_step);
+			else
+				*pSample = AD779X_ReadDataSample24(m_device);
+			
+			if (pStep)
+				*pStep = m_step;
+			
+			/* next poll starts after served device */
+			pBus->Next = (m_index + 1 < pBus->Count) ? m_index + 1 : 0;
+			
+			return m_index;
+		}
+		
+		if (++m_index >= pBus->Count)
+			m_index = 0;
+	}
+	
+	return AD779X_BUS_NONE;
+}
+
+/**
+ * @brief  Wait until any device is ready and read its sample: time limit is
+ *         longest settling time of active devices with margin, without
+ *         GetTimeUs - AD779X_RDY_POLLS poll rounds
+ * @param  pBus - bus
+ * @param  pSample - sample value (24-bit range)
+ * @param  pStep - step of scan sequencer, may be NULL
+ * @return Number of served device, AD779X_BUS_NONE - no active device on bus or timeout
+ */
+uint8_t AD779X_BusWait(tAD779X_Bus *pBus, unsigned long *pSample, uint8_t *pStep)
+{
+	tAD779X_GetTimeUs m_get_time;
+	uint32_t m_start = 0, m_polls = 0;
+	uint32_t m_timeout = AD779X_BusTimeoutUs(pBus, &m_get_time);
+	uint8_t m_index;
+	
+	/* no active device: no RDY will fall */
+	if (!m_timeout)
+		return AD779X_BUS_NONE;
+	
+	if (m_get_time)
+		m_start = m_get_time();
+	
+	while ((m_index = AD779X_BusPoll(pBus, pSample, pStep)) == AD779X_BUS_NONE)
+	{
+		/* devices are not converting (Idle, Power-down) or lost */
+		if (m_get_time ? ((m_get_time() - m_start) >= m_timeout) : (++m_polls >= AD779X_RDY_POLLS))
+			break;
+	}
+	
+	return m_index;
+}
+
+/**
+ * @brief  Start calibration on all pending devices, wait for RDY of each:
+ *         time limit is longest settling time with margin, without
+ *         GetTimeUs - AD779X_RDY_POLLS poll rounds; devices are set to Idle on timeout
+ * @param  pBus - bus
+ * @param  pResults - results of devices (pending - bcsOk)
+ * @param  Mode - calibration mode
+ * @return None
+ */
+static void AD779X_BusCalibrationStep(tAD779X_Bus *pBus, tAD779X_BusCalResult *pResults, tAD779X_ModeSelect Mode)
+{
+	uint8_t m_pending[(AD779X_BUS_MAX + 7) / 8] = {0};
+	tAD779X_ModeRegister m_mode;
+	tAD779X_GetTimeUs m_get_time;
+	uint32_t m_start = 0, m_polls = 0;
+	uint32_t m_timeout = AD779X_BusTimeoutUs(pBus, &m_get_time);
+	uint8_t i, m_count = 0;
+	
+	/* start back to back: calibrations of all devices run at the same time */
+	for (i = 0; i < pBus->Count; i++)
+	{
+		if (pResults[i].Status != bcsOk)
+			continue;
+		
+		AD779X_SetMode(&pBus->pDevices[i], Mode);
+		m_pending[i >> 3] |= 1 << (i & 7);
+		m_count++;
+	}
+	
+	if (m_get_time)
+		m_start = m_get_time();
+	
+	/* collect completions as RDY of each device falls */
+	while (m_count)
+	{
+		for (i = 0; i < pBus->Count; i++)
+		{
+			if ((m_pending[i >> 3] & (1 << (i & 7))) && AD779X_CheckReadyHW(&pBus->pDevices[i]))
+			{
+				m_pending[i >> 3] &= ~(1 << (i & 7));
+				m_count--;
+			}
+		}
+		
+		if (m_get_time ? ((m_get_time() - m_start) >= m_timeout) : (++m_polls >= AD779X_RDY_POLLS))
+			break;
+	}
+	
+	/* calibration is not completed: write Idle (image of one-shot mode is Idle already) */
+	for (i = 0; i < pBus->Count; i++)
+	{
+		if (m_pending[i >> 3] & (1 << (i & 7)))
+		{
+			m_mode = pBus->pDevices[i].ModeReg;
+			m_mode.MODE = mdsIdle;
+			AD779X_WriteModeRegister(&pBus->pDevices[i], m_mode.DATA);
+			
+			pResults[i].Status = bcsTimeout;
+		}
+	}
+}
+
+/**
+ * @brief  Internal zero-scale and full-scale calibration of all devices
+ *         at the same time (channel, gain and rate of each device are selected before)
+ * @param  pBus - bus
+ * @param  pResults - result of each device
+ * @return Count of calibrated devices
+ */
+uint8_t AD779X_BusCalibrate(tAD779X_Bus *pBus, tAD779X_BusCalResult *pResults)
+{
+	uint8_t i, m_count = 0;
+	
+	for (i = 0; i < pBus->Count; i++)
+		pResults[i].Status = (pBus->pDevices[i].SuState == susActivate) ? bcsOk : bcsNoHW;
+	
+	AD779X_BusCalibrationStep(pBus, pResults, mdsIntZeroCal);
+	AD779X_BusCalibrationStep(pBus, pResults, mdsIntFullCal);
+	
+	/* read back coefficients */
+	for (i = 0; i < pBus->Count; i++)
+	{
+		if (pResults[i].Status != bcsOk)
+			continue;
+		
+		AD779X_ReadCalibration(&pBus->pDevices[i], &pResults[i].Cal);
+		m_count++;
+	}
+	
+	pBus->Next = 0;
+	
+	return m_count;
+}
\ No newline at end of file
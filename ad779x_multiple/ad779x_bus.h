@@ -0,0 +1,62 @@
+/**
+  ******************************************************************************
+  * @file    ad779x_bus.h
+  * @author  Khusainov Timur
+  * @version 0.0.0.1
+  * @date    16.10.2026
+  * @brief   AD7792/AD7793 devices on shared SPI bus: conversion scheduler
+  ******************************************************************************
+  * @attention
+  * <h2><center>&copy; COPYRIGHT 2011 timypik@gmail.com </center></h2>
+  ******************************************************************************
+  */
+
+#ifndef AD779X_BUS_H
+#define AD779X_BUS_H
+
+#include "ad779x.h"
+
+/**
+ * @brief No device was served
+ */
+#define AD779X_BUS_NONE 0xFF
+
+/**
+ * @brief Max count of devices on bus: numbers of devices differ from AD779X_BUS_NONE
+ */
+#define AD779X_BUS_MAX 254
+
+/**
+ * @brief Devices on one SPI bus
+ */
+typedef struct
+{
+	tAD779X_Device *pDevices;  /*!< devices on bus */
+	tAD779X_Sequencer *pSeqs;  /*!< scan sequencer of each device, may be NULL */
+	uint8_t Count;             /*!< count of devices (max AD779X_BUS_MAX) */
+	uint8_t Next;              /*!< device checked first on next poll */
+} tAD779X_Bus;
+
+/**
+ * @brief Result of group calibration of device
+ */
+typedef enum
+{
+	bcsOk      = 0, /*!< Calibrated, coefficients are read back */
+	bcsNoHW    = 1, /*!< Device is not active (not detected on init) */
+	bcsTimeout = 2  /*!< Calibration was not completed in time limit, device is set to Idle */
+} tAD779X_BusCalStatus;
+
+typedef struct
+{
+	tAD779X_CalEntry Cal;        /*!< Coefficients of selected channel, gain, rate */
+	tAD779X_BusCalStatus Status; /*!< Result */
+} tAD779X_BusCalResult;
+
+void AD779X_BusInit(tAD779X_Bus *pBus, tAD779X_Device *pDevices, uint8_t Count);
+void AD779X_BusStart(tAD779X_Bus *pBus);
+uint8_t AD779X_BusPoll(tAD779X_Bus *pBus, unsigned long *pSample, uint8_t *pStep);
+uint8_t AD779X_BusWait(tAD779X_Bus *pBus, unsigned long *pSample, uint8_t *pStep);
+uint8_t AD779X_BusCalibrate(tAD779X_Bus *pBus, tAD779X_BusCalResult *pResults);
+
+#endif
@@ -31,6 +31,348 @@ const tAD779X_ModeRegister gModeReg =
 	.UNUSED1 = 0         /*!< must be clear */
 };
 
+/* Reset state of CONFIG register */
+const tAD779X_ConfigRegister gConfigReg =
+{
+	.VBIAS   = biasNone,   /*!< bias voltage generator disabled */
+	.BO      = boDisable,  /*!< burnout currents disabled */
+	.UB      = ubBipolar,  /*!< bipolar coding */
+	.BOOST   = boostDisable,
+	.GAIN    = gain128,    /*!< gain 128 */
+	.REFSEL  = refExt,     /*!< external reference */
+	.BUF     = bufEnable,  /*!< buffered mode */
+	.CHSEL   = chsAIN1,    /*!< AIN1(+) - AIN1(-) */
+	.UNUSED0 = 0,          /*!< must be clear */
+	.UNUSED1 = 0           /*!< must be clear */
+};
+
+/**
+ * @brief  Exchange frame with ADC (cs line is not touched)
+ * @param  pTxData - frame: command/data bytes, then dummy bytes for read
+ * @param  pRxData - received frame (same size as pTxData)
+ * @param  Size - size of frame
+ * @param  TxSize - count of first bytes written to ADC, other bytes are read
+ * @return None
+ */
+static void AD779X_Exchange(const uint8_t *pTxData, uint8_t *pRxData, uint8_t Size, uint8_t TxSize)
+{
+	uint8_t i;
+	
+	if (ADCDevice.TxRxBlock)
+	{
+		/* whole frame by one full-duplex transfer */
+		ADCDevice.TxRxBlock(pTxData, pRxData, Size);
+	}
+	else
+	{
+		/* fallback: byte by byte */
+		for (i = 0; i < TxSize; i++)
+			ADCDevice.TxByte(pTxData[i]);
+		
+		for (; i < Size; i++)
+			pRxData[i] = ADCDevice.RxByte();
+	}
+}
+
+/**
+ * @brief  Exchange frame made of several commands (cs line is not touched)
+ * @param  pTxData - frame: segments one by one
+ * @param  pRxData - received frame (same size as pTxData)
+ * @param  pSegments - segments: size and count of written bytes of each
+ * @param  Count - count of segments
+ * @return None
+ */
+static void AD779X_ExchangeSegments(const uint8_t *pTxData, uint8_t *pRxData, const tAD779X_Segment *pSegments, uint8_t Count)
+{
+	uint8_t i, m_size = 0;
+	
+	if (ADCDevice.TxRxBlock)
+	{
+		for (i = 0; i < Count; i++)
+			m_size += pSegments[i].Size;
+		
+		/* whole frame by one full-duplex transfer */
+		ADCDevice.TxRxBlock(pTxData, pRxData, m_size);
+	}
+	else
+	{
+		/* fallback: segment by segment */
+		for (i = 0; i < Count; i++)
+		{
+			AD779X_Exchange(&pTxData[m_size], &pRxData[m_size], pSegments[i].Size, pSegments[i].TxSize);
+			m_size += pSegments[i].Size;
+		}
+	}
+}
+
+#if !defined(AD779X_CORE_SHIM)
+/**
+ * @brief  Make one transaction with ADC: active cs, exchange frame, inactive cs
+ * @param  pTxData - frame: command/data bytes, then dummy bytes for read
+ * @param  pRxData - received frame (same size as pTxData)
+ * @param  Size - size of frame
+ * @param  TxSize - count of first bytes written to ADC, other bytes are read
+ * @return None
+ */
+static void AD779X_Transfer(const uint8_t *pTxData, uint8_t *pRxData, uint8_t Size, uint8_t TxSize)
+{
+	AD779X_TRACE_BEGIN(AD779X_TRACE_OP(pTxData[0]), &ADCDevice);
+	
+	/* active cs line */
+	ADCDevice.CSControl(cssEnable);
+	
+	AD779X_Exchange(pTxData, pRxData, Size, TxSize);
+	
+	/* inactive cs line */
+	ADCDevice.CSControl(cssDisable);
+	
+	AD779X_TRACE_END(AD779X_TRACE_OP(pTxData[0]), &ADCDevice);
+}
+
+#endif
+
+/**
+ * @brief  Make sample value (24-bit range) from data register bytes
+ * @param  pData - data register bytes, MSB first
+ * @return Data sample value
+ */
+static unsigned long AD779X_MakeSample24(const uint8_t *pData)
+{
+	unsigned long m_data_sample = 0;
+	
+	switch (AD779X_MODEL(ADCDevice))
+	{
+		case ad7792:
+			m_data_sample = (((unsigned long)((pData[0] << 8)| pData[1])) << 8);
+			break;
+		
+		case ad7793:
+			m_data_sample = ((((unsigned long)((pData[0] << 8)| pData[1])) << 8) | pData[2]);
+			break;
+		
+		default:
+			break;
+	}
+	
+	return m_data_sample;
+}
+
+/**
+ * @brief  Count result in telemetry
+ * @param  Status - STATUS register read with result, 0 - not read
+ * @return None
+ */
+static void AD779X_CountResult(uint8_t Status)
+{
+	AD779X_COUNTER_INC(ADCDevice.Telemetry.Conversions);
+	
+	/* result is clamped: overrange of input */
+	if (Status & AD779X_SR_ERR)
+		AD779X_COUNTER_INC(ADCDevice.Telemetry.Errors[Status & AD779X_SR_CHC]);
+}
+
+/* Conversion period t_adc for each filter update rate (64 kHz clock), us */
+static const unsigned long gConversionTime[16] =
+{
+	0,      /* fsNone */
+	2000,   /* fs500 */
+	4000,   /* fs250 */
+	8000,   /* fs152 */
+	16000,  /* fs62_5 */
+	20000,  /* fs50 */
+	24000,  /* fs39_2 */
+	30000,  /* fs33_3 */
+	50500,  /* fs19_6_90dB */
+	60000,  /* fs16_7_80dB */
+	60000,  /* fs16_7_65dB */
+	80000,  /* fs12_5_66dB */
+	100000, /* fs10_69dB */
+	120000, /* fs8_33_70dB */
+	160000, /* fs6_25_72dB */
+	240000  /* fs4_17_74dB */
+};
+
+/**
+ * @brief  Get conversion period (time between results in continuous mode)
+ * @param  Rate - filter update rate
+ * @param  ClkSource - clock source (external clock - AD779X_EXT_CLK_HZ)
+ * @return Conversion period, us
+ */
+unsigned long AD779X_ConversionTimeUs(tAD779X_FilterSelect Rate, tAD779X_ClkSourceSelect ClkSource)
+{
+	unsigned long m_time = gConversionTime[Rate & 0xF];
+	
+	switch (ClkSource)
+	{
+		case cssExt:
+			return (unsigned long)(((unsigned long long)m_time * AD779X_INT_CLK_HZ) / AD779X_EXT_CLK_HZ);
+		
+		/* external clock is divided by 2 within ADC */
+		case cssExtDiv2:
+			return (unsigned long)(((unsigned long long)m_time * 2 * AD779X_INT_CLK_HZ) / AD779X_EXT_CLK_HZ);
+		
+		default:
+			return m_time;
+	}
+}
+
+/**
+ * @brief  Get settling time: first result after MODE write or CONFIG change
+ *         (channel, gain), single conversion and calibration time
+ * @param  Rate - filter update rate
+ * @param  ClkSource - clock source (external clock - AD779X_EXT_CLK_HZ)
+ * @return Settling time (2 conversion periods), us
+ */
+unsigned long AD779X_SettlingTimeUs(tAD779X_FilterSelect Rate, tAD779X_ClkSourceSelect ClkSource)
+{
+	return 2 * AD779X_ConversionTimeUs(Rate, ClkSource);
+}
+
+/**
+ * @brief  Wait RDY (cs line must be active): time limit is settling time with
+ *         margin, without GetTimeUs - AD779X_RDY_POLLS reads of RDY line
+ * @param  None
+ * @return 1 - data ready, 0 - timeout
+ */
+static uint8_t AD779X_WaitRDY()
+{
+	uint32_t m_start = 0, m_polls = 0;
+	uint32_t m_timeout = 2 * AD779X_SettlingTimeUs((tAD779X_FilterSelect)ADCDevice.ModeReg.FS, (tAD779X_ClkSourceSelect)ADCDevice.ModeReg.CLKS) + AD779X_POWER_UP_US;
+	
+	if (ADCDevice.GetTimeUs)
+		m_start = ADCDevice.GetTimeUs();
+	
+	while (ADCDevice.RDYState() == rdsBusy)
+	{
+		if (ADCDevice.GetTimeUs ? ((ADCDevice.GetTimeUs() - m_start) >= m_timeout) : (++m_polls >= AD779X_RDY_POLLS))
+		{
+			AD779X_COUNTER_INC(ADCDevice.Telemetry.Timeouts);
+			return 0;
+		}
+	}
+	
+	return 1;
+}
+
+/**
+ * @brief  Start deadline of first result: conversion restarts after write
+ *         of MODE or CONFIG register
+ * @param  Mode - written mode (one-shot modes are not stored in ModeReg)
+ * @param  PrevMode - mode before write (Power-down: oscillator powers up)
+ * @return None
+ */
+static void AD779X_StartDeadline(uint8_t Mode, uint8_t PrevMode)
+{
+	if (!ADCDevice.GetTimeUs)
+		return;
+	
+	if ((Mode == mdsIdle) || (Mode == mdsPowerDown))
+	{
+		ADCDevice.DeadlineSet = 0;
+		return;
+	}
+	
+	ADCDevice.Deadline = ADCDevice.GetTimeUs() + AD779X_SettlingTimeUs((tAD779X_FilterSelect)ADCDevice.ModeReg.FS, (tAD779X_ClkSourceSelect)ADCDevice.ModeReg.CLKS);
+	
+	if (PrevMode == mdsPowerDown)
+		ADCDevice.Deadline += AD779X_POWER_UP_US;
+	
+	ADCDevice.DeadlineSet = 1;
+}
+
+/**
+ * @brief  Move deadline to next result (continuous mode) or clear it
+ * @param  None
+ * @return None
+ */
+static void AD779X_NextDeadline()
+{
+	unsigned long m_period;
+	uint32_t m_now;
+	
+	if (!ADCDevice.DeadlineSet || !ADCDevice.GetTimeUs || (ADCDevice.ModeReg.MODE != mdsContinuous))
+	{
+		ADCDevice.DeadlineSet = 0;
+		return;
+	}
+	
+	m_period = AD779X_ConversionTimeUs((tAD779X_FilterSelect)ADCDevice.ModeReg.FS, (tAD779X_ClkSourceSelect)ADCDevice.ModeReg.CLKS);
+	m_now = ADCDevice.GetTimeUs();
+	
+	/* results come each period from first result, missed results are skipped */
+	ADCDevice.Deadline += m_period;
+	
+	while ((int32_t)(ADCDevice.Deadline - m_now) <= 0)
+	{
+		ADCDevice.Deadline += m_period;
+		AD779X_COUNTER_INC(ADCDevice.Telemetry.Overruns);
+	}
+}
+
+#if defined(AD779X_CORE_SHIM)
+/**
+ * @brief  Keep state of device after cs window of core function made by
+ *         ad779x_shim.cpp: register images, deadline, read mode (as core
+ *         functions of this file do)
+ * @param  pTxData - written frame: command, data
+ * @param  Size - size of frame
+ * @return None
+ */
+void AD779X_ShimWindow(const uint8_t *pTxData, uint8_t Size)
+{
+	uint8_t m_prev = ADCDevice.ModeReg.MODE;
+	unsigned long m_value = 0;
+	uint8_t i;
+	
+	/* written value, MSB first */
+	for (i = 1; i < Size; i++)
+		m_value = (m_value << 8) | pTxData[i];
+	
+	switch (pTxData[0])
+	{
+		case AD779X_WRR_MODE:
+			ADCDevice.ModeReg.DATA = (unsigned short)m_value;
+			AD779X_StartDeadline(ADCDevice.ModeReg.MODE, m_prev);
+			
+			/* one-shot modes return ADC to Power-down/Idle mode by itself */
+			if (AD779X_MODE_IS_ONESHOT(ADCDevice.ModeReg.MODE))
+				ADCDevice.ModeReg.MODE = AD779X_MODE_AFTER_ONESHOT(ADCDevice.ModeReg.MODE);
+		break;
+		
+		case AD779X_WRR_CONFIG:
+			ADCDevice.ConfigReg.DATA = (unsigned short)m_value;
+			AD779X_StartDeadline(ADCDevice.ModeReg.MODE, ADCDevice.ModeReg.MODE);
+		break;
+		
+		case AD779X_WRR_IO:
+			ADCDevice.IOReg.DATA = (unsigned char)m_value;
+		break;
+		
+		case AD779X_WRR_OFFSET:
+			if (Size == 3)
+				ADCDevice.OfReg.u16 = (unsigned short)m_value;
+			else
+				ADCDevice.OfReg.u32 = m_value;
+		break;
+		
+		case AD779X_WRR_FSCLAE:
+			if (Size == 3)
+				ADCDevice.FsReg.u16 = (unsigned short)m_value;
+			else
+				ADCDevice.FsReg.u32 = m_value;
+		break;
+		
+		case 0xFF:
+			/* reset: registers return to reset values, continuous read mode is left */
+			ADCDevice.ModeReg.DATA   = AD779X_RDV_MODE;
+			ADCDevice.ConfigReg.DATA = AD779X_RDV_CONFIG;
+			ADCDevice.IOReg.DATA     = AD779X_RDV_IO;
+			ADCDevice.ReadMode       = rdmSingle;
+			ADCDevice.DeadlineSet    = 0;
+		break;
+	}
+}
+#else
 /**
  * @brief  Init HW and reset ADC
  * @param  None
@@ -44,10 +386,13 @@ void AD779X_Init()
 		/* set default settings: continuous conversion, internal clock source, 16.7Hz (65dB) */
 		AD779X_WriteModeRegister(gModeReg.DATA);
 		
+		/* set default settings: AIN1, gain 128, bipolar, external reference, buffered */
+		AD779X_WriteConfigRegister(gConfigReg.DATA);
+		
 		/* set default settings: excitation currents disabled */
 		AD779X_WriteIORegister(gIOReg.DATA);
 		
-		switch (ADCDevice.Model)
+		switch (AD779X_MODEL(ADCDevice))
 		{
 			case ad7792:
 			{
@@ -62,6 +407,9 @@ void AD779X_Init()
 				ADCDevice.FsReg.u32 = AD779X_FULLSCALE_RESET_24;
 			}
 			break;
+			
+			default:
+				break;
 		}
 		
 		/* store startup state */
@@ -81,17 +429,18 @@ void AD779X_Init()
  */
 void AD779X_Reset()
 {
-	/* active cs line */
-	ADCDevice.CSControl(cssEnable);
-	
 	/* make 32 clk, while dout -> 1 */
-	ADCDevice.TxByte(0xFF);
-	ADCDevice.TxByte(0xFF);
-	ADCDevice.TxByte(0xFF);
-	ADCDevice.TxByte(0xFF);
+	const uint8_t m_tx[4] = {0xFF, 0xFF, 0xFF, 0xFF};
+	uint8_t m_rx[4];
 	
-	/* inactive cs line */
-	ADCDevice.CSControl(cssDisable);
+	AD779X_Transfer(m_tx, m_rx, 4, 4);
+	
+	/* registers return to reset values, continuous read mode is left */
+	ADCDevice.ModeReg.DATA   = AD779X_RDV_MODE;
+	ADCDevice.ConfigReg.DATA = AD779X_RDV_CONFIG;
+	ADCDevice.IOReg.DATA     = AD779X_RDV_IO;
+	ADCDevice.ReadMode       = rdmSingle;
+	ADCDevice.DeadlineSet    = 0;
 }
 
 /**
@@ -101,18 +450,21 @@ void AD779X_Reset()
  */
 void AD779X_WriteModeRegister(unsigned short Data)
 {
-	/* active cs line */
-	ADCDevice.CSControl(cssEnable);
+	/* cmd: write MODE register, data */
+	const uint8_t m_tx[3] = {AD779X_WRR_MODE, Data >> 8, Data & 0x00FF};
+	uint8_t m_rx[3];
+	uint8_t m_prev = ADCDevice.ModeReg.MODE;
 	
-	/* send cmd: write MODE register */
-	ADCDevice.TxByte(AD779X_WRR_MODE);
+	AD779X_Transfer(m_tx, m_rx, 3, 3);
 	
-	/* write data to register */
-	ADCDevice.TxByte(Data >> 8);
-	ADCDevice.TxByte(Data & 0x00FF);
+	/* store value */
+	ADCDevice.ModeReg.DATA = Data;
 	
-	/* inactive cs line */
-	ADCDevice.CSControl(cssDisable);
+	AD779X_StartDeadline(ADCDevice.ModeReg.MODE, m_prev);
+	
+	/* one-shot modes return ADC to Power-down/Idle mode by itself */
+	if (AD779X_MODE_IS_ONESHOT(ADCDevice.ModeReg.MODE))
+		ADCDevice.ModeReg.MODE = AD779X_MODE_AFTER_ONESHOT(ADCDevice.ModeReg.MODE);
 }
 
 /**
@@ -122,18 +474,17 @@ void AD779X_WriteModeRegister(unsigned short Data)
  */
 void AD779X_WriteConfigRegister(unsigned short Data)
 {
-	/* active cs line */
-	ADCDevice.CSControl(cssEnable);
+	/* cmd: write CONFIG register, data */
+	const uint8_t m_tx[3] = {AD779X_WRR_CONFIG, Data >> 8, Data & 0x00FF};
+	uint8_t m_rx[3];
 	
-	/* send cmd: write CONFIG register */
-	ADCDevice.TxByte(AD779X_WRR_CONFIG);
+	AD779X_Transfer(m_tx, m_rx, 3, 3);
 	
-	/* write data to register */
-	ADCDevice.TxByte(Data >> 8);
-	ADCDevice.TxByte(Data & 0x00FF);
+	/* store value */
+	ADCDevice.ConfigReg.DATA = Data;
 	
-	/* inactive cs line */
-	ADCDevice.CSControl(cssDisable);
+	/* conversion restarts with new configuration */
+	AD779X_StartDeadline(ADCDevice.ModeReg.MODE, ADCDevice.ModeReg.MODE);
 }
 
 /**
@@ -143,17 +494,14 @@ void AD779X_WriteConfigRegister(unsigned short Data)
  */
 void AD779X_WriteIORegister(unsigned char Data)
 {
-	/* active cs line */
-	ADCDevice.CSControl(cssEnable);
+	/* cmd: write IO register, data */
+	const uint8_t m_tx[2] = {AD779X_WRR_IO, Data};
+	uint8_t m_rx[2];
 	
-	/* send cmd: write IO register */
-	ADCDevice.TxByte(AD779X_WRR_IO);
+	AD779X_Transfer(m_tx, m_rx, 2, 2);
 	
-	/* write data to register */
-	ADCDevice.TxByte(Data);
-	
-	/* inactive cs line */
-	ADCDevice.CSControl(cssDisable);
+	/* store value */
+	ADCDevice.IOReg.DATA = Data;
 }
 
 /**
@@ -163,27 +511,29 @@ void AD779X_WriteIORegister(unsigned char Data)
  */
 unsigned short AD779X_HWDetect()
 {
-	unsigned short m_adc_model;
-	
-	/* active cs line */
-	ADCDevice.CSControl(cssEnable);
-	
-	/* send cmd: read ID register */
-	ADCDevice.TxByte(AD779X_RDR_ID);
+	/* cmd: read ID register */
+	const uint8_t m_tx[2] = {AD779X_RDR_ID, 0};
+	uint8_t m_rx[2];
 	
 	/* get ID */
-	m_adc_model = ADCDevice.RxByte();
-	
-	/* inactive cs line */
-	ADCDevice.CSControl(cssDisable);
+	AD779X_Transfer(m_tx, m_rx, 2, 1);
 	
-	switch (m_adc_model & 0xF)
+	switch (m_rx[1] & 0xF)
 	{
 		case AD7792_PARTID: ADCDevice.Model = ad7792; break;
 		case AD7793_PARTID: ADCDevice.Model = ad7793; break;
 		
 		default: ADCDevice.Model = adNone; break;
 	}
+
+#if defined(AD779X_FIXED_MODEL)
+	/* other model is not supported by this build */
+	if (ADCDevice.Model != AD779X_FIXED_MODEL)
+		ADCDevice.Model = adNone;
+#endif
+	
+	if (ADCDevice.Model == adNone)
+		AD779X_COUNTER_INC(ADCDevice.Telemetry.DetectFails);
 	
 	return ADCDevice.Model;
 }
@@ -195,21 +545,14 @@ unsigned short AD779X_HWDetect()
  */
 unsigned char AD779X_GetStatus()
 {
-	unsigned char m_adc_status;
-	
-	/* active cs line */
-	ADCDevice.CSControl(cssEnable);
-	
-	/* send cmd: read STATUS register */
-	ADCDevice.TxByte(AD779X_RDR_STATUS);
+	/* cmd: read STATUS register */
+	const uint8_t m_tx[2] = {AD779X_RDR_STATUS, 0};
+	uint8_t m_rx[2];
 	
 	/* get value */
-	m_adc_status = ADCDevice.RxByte();
+	AD779X_Transfer(m_tx, m_rx, 2, 1);
 	
-	/* inactive cs line */
-	ADCDevice.CSControl(cssDisable);
-	
-	return m_adc_status;
+	return m_rx[1];
 }
 
 /**
@@ -231,6 +574,8 @@ unsigned char AD779X_CheckReadyHW()
 {
 	unsigned char m_rdy_state;
 	
+	AD779X_TRACE_BEGIN(trcPollReady, &ADCDevice);
+	
 	/* active cs line */
 	ADCDevice.CSControl(cssEnable);
 	
@@ -242,9 +587,49 @@ unsigned char AD779X_CheckReadyHW()
 	/* inactive cs line */
 	ADCDevice.CSControl(cssDisable);
 	
+	AD779X_TRACE_END(trcPollReady, &ADCDevice);
+	
 	return m_rdy_state;
 }
 
+/**
+ * @brief  Write value in MODE register, if it differs from stored value
+ * @param  Data - need write
+ * @return None
+ */
+static void AD779X_UpdateModeRegister(unsigned short Data)
+{
+	tAD779X_ModeRegister m_mode_reg;
+	
+	m_mode_reg.DATA = Data;
+	
+	/* one-shot modes are started by each write */
+	if ((Data != ADCDevice.ModeReg.DATA) || AD779X_MODE_IS_ONESHOT(m_mode_reg.MODE))
+		AD779X_WriteModeRegister(Data);
+}
+
+/**
+ * @brief  Write value in CONFIG register, if it differs from stored value
+ * @param  Data - need write
+ * @return None
+ */
+static void AD779X_UpdateConfigRegister(unsigned short Data)
+{
+	if (Data != ADCDevice.ConfigReg.DATA)
+		AD779X_WriteConfigRegister(Data);
+}
+
+/**
+ * @brief  Write value in IO register, if it differs from stored value
+ * @param  Data - need write
+ * @return None
+ */
+static void AD779X_UpdateIORegister(unsigned char Data)
+{
+	if (Data != ADCDevice.IOReg.DATA)
+		AD779X_WriteIORegister(Data);
+}
+
 /**
  * @brief  Set ADC mode
  * @param  Mode - need set
@@ -252,11 +637,13 @@ unsigned char AD779X_CheckReadyHW()
  */
 void AD779X_SetMode(tAD779X_ModeSelect Mode)
 {
-	/* change and store needed mode */
-	ADCDevice.ModeReg.MODE = Mode;      // FIXME: need assembler optimisation
+	tAD779X_ModeRegister m_mode_reg = ADCDevice.ModeReg;
 	
-	/* write value in MODE register */
-	AD779X_WriteModeRegister(ADCDevice.ModeReg.DATA);
+	/* change needed mode */
+	m_mode_reg.MODE = Mode;
+	
+	/* write value in MODE register, if it is changed */
+	AD779X_UpdateModeRegister(m_mode_reg.DATA);
 }
 
 /**
@@ -266,11 +653,13 @@ void AD779X_SetMode(tAD779X_ModeSelect Mode)
  */
 void AD779X_SetClkSource(tAD779X_ClkSourceSelect ClkSource)
 {
-	/* change and store needed clock source */
-	ADCDevice.ModeReg.CLKS = ClkSource; // FIXME: need assembler optimisation
+	tAD779X_ModeRegister m_mode_reg = ADCDevice.ModeReg;
+	
+	/* change needed clock source */
+	m_mode_reg.CLKS = ClkSource;
 	
-	/* write value in MODE register */
-	AD779X_WriteModeRegister(ADCDevice.ModeReg.DATA);
+	/* write value in MODE register, if it is changed */
+	AD779X_UpdateModeRegister(m_mode_reg.DATA);
 }
 
 /**
@@ -280,125 +669,178 @@ void AD779X_SetClkSource(tAD779X_ClkSourceSelect ClkSource)
  */
 void AD779X_SetUpdateRate(tAD779X_FilterSelect UpdateRates)
 {
-	/* change and store needed update rates */
-	ADCDevice.ModeReg.FS = UpdateRates; // FIXME: need assembler optimisation
+	tAD779X_ModeRegister m_mode_reg = ADCDevice.ModeReg;
 	
-	/* write value in MODE register */
-	AD779X_WriteModeRegister(ADCDevice.ModeReg.DATA);
+	/* change needed update rates */
+	m_mode_reg.FS = UpdateRates;
+	
+	/* write value in MODE register, if it is changed */
+	AD779X_UpdateModeRegister(m_mode_reg.DATA);
 }
 
 /**
- * @brief  Set ADC excitation currents value
- * @param  excValue - need sat
+ * @brief  Set ADC channel
+ * @param  Channel - need set
  * @return None
  */
-void AD779X_SetExCurrentValue(tAD779X_IEXCENSelect excValue)
+void AD779X_SetChannel(tAD779X_ChSelect Channel)
 {
-	/* change and store needed value */
-	ADCDevice.IOReg.IEXCEN = excValue;
+	tAD779X_ConfigRegister m_config_reg = ADCDevice.ConfigReg;
 	
-	/* write value in IO register */
-	AD779X_WriteIORegister(ADCDevice.IOReg.DATA);
+	/* change needed channel */
+	m_config_reg.CHSEL = Channel;
+	
+	/* write value in CONFIG register, if it is changed */
+	AD779X_UpdateConfigRegister(m_config_reg.DATA);
 }
 
 /**
- * @brief  Set ADC excitation currents direction
- * @param  excDirection - need sat
+ * @brief  Set ADC gain
+ * @param  Gain - need set
  * @return None
  */
-void AD779X_SetExCurrentDirection(tAD779X_IEXCDIRSelect excDirection)
+void AD779X_SetGain(tAD779X_GainSelect Gain)
 {
-	/* change and store needed value */
-	ADCDevice.IOReg.IEXCDIR = excDirection;
+	tAD779X_ConfigRegister m_config_reg = ADCDevice.ConfigReg;
 	
-	/* write value in IO register */
-	AD779X_WriteIORegister(ADCDevice.IOReg.DATA);
+	/* change needed gain */
+	m_config_reg.GAIN = Gain;
+	
+	/* write value in CONFIG register, if it is changed */
+	AD779X_UpdateConfigRegister(m_config_reg.DATA);
 }
 
 /**
- * @brief  Set ADC excitation current
- * @param  excValue - need sat
+ * @brief  Set ADC unipolar/bipolar coding
+ * @param  Polarity - need set
  * @return None
  */
-void AD779X_SetExCurrent(tAD779X_IEXCENSelect excValue, tAD779X_IEXCDIRSelect excDirection)
+void AD779X_SetPolarity(tAD779X_BSelect Polarity)
 {
-	/* change and store needed value */
-	ADCDevice.IOReg.IEXCEN = excValue;
-	ADCDevice.IOReg.IEXCDIR = excDirection;
+	tAD779X_ConfigRegister m_config_reg = ADCDevice.ConfigReg;
 	
-	/* write value in IO register */
-	AD779X_WriteIORegister(ADCDevice.IOReg.DATA);
+	/* change needed coding */
+	m_config_reg.UB = Polarity;
+	
+	/* write value in CONFIG register, if it is changed */
+	AD779X_UpdateConfigRegister(m_config_reg.DATA);
 }
 
 /**
- * @brief  Start ADC Zero-Scale Calibration
- * @param  None
+ * @brief  Set ADC buffered/unbuffered mode
+ * @param  Buffer - need set
  * @return None
  */
-void AD779X_StartZSCalibration()
+void AD779X_SetBuffer(tAD779X_BufSelect Buffer)
 {
-	AD779X_SetMode(mdsIntZeroCal);
+	tAD779X_ConfigRegister m_config_reg = ADCDevice.ConfigReg;
+	
+	/* change needed buffer mode */
+	m_config_reg.BUF = Buffer;
+	
+	/* write value in CONFIG register, if it is changed */
+	AD779X_UpdateConfigRegister(m_config_reg.DATA);
 }
 
 /**
- * @brief  Start ADC Full-Scale Calibration
- * @param  None
+ * @brief  Set ADC reference source
+ * @param  Reference - need set
  * @return None
  */
-void AD779X_StartFSCalibration()
+void AD779X_SetReference(tAD779X_RefSelect Reference)
 {
-	AD779X_SetMode(mdsIntFullCal);
+	tAD779X_ConfigRegister m_config_reg = ADCDevice.ConfigReg;
+	
+	/* change needed reference */
+	m_config_reg.REFSEL = Reference;
+	
+	/* write value in CONFIG register, if it is changed */
+	AD779X_UpdateConfigRegister(m_config_reg.DATA);
 }
 
 /**
- * @brief  Read offset register value (16-bit)
- * @param  None
- * @return offset register value
+ * @brief  Set ADC bias voltage generator
+ * @param  Bias - need set
+ * @return None
  */
-unsigned short AD779X_ReadOffsetRegister16()
+void AD779X_SetBias(tAD779X_VbiasSelect Bias)
 {
-	unsigned char m_data[2];
+	tAD779X_ConfigRegister m_config_reg = ADCDevice.ConfigReg;
 	
-	/* active cs line */
-	ADCDevice.CSControl(cssEnable);
-	
-	/* send cmd: read DATA register */
-	ADCDevice.TxByte(AD779X_RDR_OFFSET);
-	
-	/* get value */
-	m_data[1] = ADCDevice.RxByte();
-	m_data[0] = ADCDevice.RxByte();
-	
-	/* inactive cs line */
-	ADCDevice.CSControl(cssDisable);
+	/* change needed bias voltage */
+	m_config_reg.VBIAS = Bias;
 	
-	return (m_data[1]<<8)|m_data[0];
+	/* write value in CONFIG register, if it is changed */
+	AD779X_UpdateConfigRegister(m_config_reg.DATA);
 }
 
 /**
- * @brief  Read offset register value (24-bit)
- * @param  None
- * @return offset register value
+ * @brief  Set ADC excitation currents value
+ * @param  excValue - need sat
+ * @return None
  */
-unsigned long AD779X_ReadOffsetRegister24()
+void AD779X_SetExCurrentValue(tAD779X_IEXCENSelect excValue)
 {
-	unsigned char m_data[3];
+	tAD779X_IORegister m_io_reg = ADCDevice.IOReg;
 	
-	/* active cs line */
-	ADCDevice.CSControl(cssEnable);
+	/* change needed value */
+	m_io_reg.IEXCEN = excValue;
 	
-	/* send cmd: read DATA register */
-	ADCDevice.TxByte(AD779X_RDR_OFFSET);
+	/* write value in IO register, if it is changed */
+	AD779X_UpdateIORegister(m_io_reg.DATA);
+}
+
+/**
+ * @brief  Set ADC excitation currents direction
+ * @param  excDirection - need sat
+ * @return None
+ */
+void AD779X_SetExCurrentDirection(tAD779X_IEXCDIRSelect excDirection)
+{
+	tAD779X_IORegister m_io_reg = ADCDevice.IOReg;
 	
-	/* get value */
-	m_data[2] = ADCDevice.RxByte();
-	m_data[1] = ADCDevice.RxByte();
-	m_data[0] = ADCDevice.RxByte();
+	/* change needed value */
+	m_io_reg.IEXCDIR = excDirection;
 	
-	/* inactive cs line */
-	ADCDevice.CSControl(cssDisable);
+	/* write value in IO register, if it is changed */
+	AD779X_UpdateIORegister(m_io_reg.DATA);
+}
+
+/**
+ * @brief  Set ADC excitation current
+ * @param  excValue - need sat
+ * @return None
+ */
+void AD779X_SetExCurrent(tAD779X_IEXCENSelect excValue, tAD779X_IEXCDIRSelect excDirection)
+{
+	tAD779X_IORegister m_io_reg = ADCDevice.IOReg;
+	
+	/* change needed value */
+	m_io_reg.IEXCEN = excValue;
+	m_io_reg.IEXCDIR = excDirection;
 	
-	return (((unsigned long)((m_data[2]<<8)|m_data[1]))<<8)|m_data[0]; // NOTE: iar compiler hell
+	/* write value in IO register, if it is changed */
+	AD779X_UpdateIORegister(m_io_reg.DATA);
+}
+
+/**
+ * @brief  Start ADC Zero-Scale Calibration
+ * @param  None
+ * @return None
+ */
+void AD779X_StartZSCalibration()
+{
+	AD779X_SetMode(mdsIntZeroCal);
+}
+
+/**
+ * @brief  Start ADC Full-Scale Calibration
+ * @param  None
+ * @return None
+ */
+void AD779X_StartFSCalibration()
+{
+	AD779X_SetMode(mdsIntFullCal);
 }
 
 /**
@@ -406,24 +848,50 @@ unsigned long AD779X_ReadOffsetRegister24()
  * @param  None
  * @return offset register value
  */
-unsigned short AD779X_ReadFScaleRegister16()
+unsigned short AD779X_ReadOffsetRegister16()
 {
-	unsigned char m_data[2];
+	/* cmd: read register */
+	const uint8_t m_tx[3] = {AD779X_RDR_OFFSET, 0, 0};
+	uint8_t m_rx[3];
 	
-	/* active cs line */
-	ADCDevice.CSControl(cssEnable);
+	/* get value */
+	AD779X_Transfer(m_tx, m_rx, 3, 1);
 	
-	/* send cmd: read DATA register */
-	ADCDevice.TxByte(AD779X_RDR_FSCLAE);
+	return (m_rx[1]<<8)|m_rx[2];
+}
+
+/**
+ * @brief  Read offset register value (24-bit)
+ * @param  None
+ * @return offset register value
+ */
+unsigned long AD779X_ReadOffsetRegister24()
+{
+	/* cmd: read register */
+	const uint8_t m_tx[4] = {AD779X_RDR_OFFSET, 0, 0, 0};
+	uint8_t m_rx[4];
 	
 	/* get value */
-	m_data[1] = ADCDevice.RxByte();
-	m_data[0] = ADCDevice.RxByte();
+	AD779X_Transfer(m_tx, m_rx, 4, 1);
 	
-	/* inactive cs line */
-	ADCDevice.CSControl(cssDisable);
+	return (((unsigned long)((m_rx[1]<<8)|m_rx[2]))<<8)|m_rx[3]; // NOTE: iar compiler hell
+}
+
+/**
+ * @brief  Read offset register value (16-bit)
+ * @param  None
+ * @return offset register value
+ */
+unsigned short AD779X_ReadFScaleRegister16()
+{
+	/* cmd: read register */
+	const uint8_t m_tx[3] = {AD779X_RDR_FSCLAE, 0, 0};
+	uint8_t m_rx[3];
+	
+	/* get value */
+	AD779X_Transfer(m_tx, m_rx, 3, 1);
 	
-	return (m_data[1]<<8)|m_data[0];
+	return (m_rx[1]<<8)|m_rx[2];
 }
 
 /**
@@ -433,23 +901,86 @@ unsigned short AD779X_ReadFScaleRegister16()
  */
 unsigned long AD779X_ReadFScaleRegister24()
 {
-	unsigned char m_data[3];
+	/* cmd: read register */
+	const uint8_t m_tx[4] = {AD779X_RDR_FSCLAE, 0, 0, 0};
+	uint8_t m_rx[4];
 	
-	/* active cs line */
-	ADCDevice.CSControl(cssEnable);
+	/* get value */
+	AD779X_Transfer(m_tx, m_rx, 4, 1);
+	
+	return (((unsigned long)((m_rx[1]<<8)|m_rx[2]))<<8)|m_rx[3]; // NOTE: iar compiler hell
+}
+
+/**
+ * @brief  Write offset register value (16-bit), register of selected channel
+ * @param  Data - need write
+ * @return None
+ */
+void AD779X_WriteOffsetRegister16(unsigned short Data)
+{
+	/* cmd: write register */
+	const uint8_t m_tx[3] = {AD779X_WRR_OFFSET, Data >> 8, Data & 0x00FF};
+	uint8_t m_rx[3];
 	
-	/* send cmd: read DATA register */
-	ADCDevice.TxByte(AD779X_RDR_FSCLAE);
+	/* set value */
+	AD779X_Transfer(m_tx, m_rx, 3, 3);
 	
-	/* get value */
-	m_data[2] = ADCDevice.RxByte();
-	m_data[1] = ADCDevice.RxByte();
-	m_data[0] = ADCDevice.RxByte();
+	/* store value */
+	ADCDevice.OfReg.u16 = Data;
+}
+
+/**
+ * @brief  Write offset register value (24-bit), register of selected channel
+ * @param  Data - need write
+ * @return None
+ */
+void AD779X_WriteOffsetRegister24(unsigned long Data)
+{
+	/* cmd: write register */
+	const uint8_t m_tx[4] = {AD779X_WRR_OFFSET, (Data >> 16) & 0xFF, (Data >> 8) & 0xFF, Data & 0xFF};
+	uint8_t m_rx[4];
 	
-	/* inactive cs line */
-	ADCDevice.CSControl(cssDisable);
+	/* set value */
+	AD779X_Transfer(m_tx, m_rx, 4, 4);
 	
-	return (((unsigned long)((m_data[2]<<8)|m_data[1]))<<8)|m_data[0]; // NOTE: iar compiler hell
+	/* store value */
+	ADCDevice.OfReg.u32 = Data;
+}
+
+/**
+ * @brief  Write full-scale register value (16-bit), register of selected channel
+ * @param  Data - need write
+ * @return None
+ */
+void AD779X_WriteFScaleRegister16(unsigned short Data)
+{
+	/* cmd: write register */
+	const uint8_t m_tx[3] = {AD779X_WRR_FSCLAE, Data >> 8, Data & 0x00FF};
+	uint8_t m_rx[3];
+	
+	/* set value */
+	AD779X_Transfer(m_tx, m_rx, 3, 3);
+	
+	/* store value */
+	ADCDevice.FsReg.u16 = Data;
+}
+
+/**
+ * @brief  Write full-scale register value (24-bit), register of selected channel
+ * @param  Data - need write
+ * @return None
+ */
+void AD779X_WriteFScaleRegister24(unsigned long Data)
+{
+	/* cmd: write register */
+	const uint8_t m_tx[4] = {AD779X_WRR_FSCLAE, (Data >> 16) & 0xFF, (Data >> 8) & 0xFF, Data & 0xFF};
+	uint8_t m_rx[4];
+	
+	/* set value */
+	AD779X_Transfer(m_tx, m_rx, 4, 4);
+	
+	/* store value */
+	ADCDevice.FsReg.u32 = Data;
 }
 
 /**
@@ -459,22 +990,14 @@ unsigned long AD779X_ReadFScaleRegister24()
  */
 unsigned short AD779X_ReadDataRegister16()
 {
-	unsigned char m_data[2];
-	
-	/* active cs line */
-	ADCDevice.CSControl(cssEnable);
-	
-	/* send cmd: read DATA register */
-	ADCDevice.TxByte(AD779X_RDR_DATA);
+	/* cmd: read register */
+	const uint8_t m_tx[3] = {AD779X_RDR_DATA, 0, 0};
+	uint8_t m_rx[3];
 	
 	/* get value */
-	m_data[1] = ADCDevice.RxByte();
-	m_data[0] = ADCDevice.RxByte();
-	
-	/* inactive cs line */
-	ADCDevice.CSControl(cssDisable);
+	AD779X_Transfer(m_tx, m_rx, 3, 1);
 	
-	return (m_data[1]<<8)|m_data[0];
+	return (m_rx[1]<<8)|m_rx[2];
 }
 
 /**
@@ -484,23 +1007,14 @@ unsigned short AD779X_ReadDataRegister16()
  */
 unsigned long AD779X_ReadDataRegister24()
 {
-	unsigned char m_data[3];
-	
-	/* active cs line */
-	ADCDevice.CSControl(cssEnable);
-	
-	/* send cmd: read DATA register */
-	ADCDevice.TxByte(AD779X_RDR_DATA);
+	/* cmd: read register */
+	const uint8_t m_tx[4] = {AD779X_RDR_DATA, 0, 0, 0};
+	uint8_t m_rx[4];
 	
 	/* get value */
-	m_data[2] = ADCDevice.RxByte();
-	m_data[1] = ADCDevice.RxByte();
-	m_data[0] = ADCDevice.RxByte();
-	
-	/* inactive cs line */
-	ADCDevice.CSControl(cssDisable);
+	AD779X_Transfer(m_tx, m_rx, 4, 1);
 	
-	return (((unsigned long)((m_data[2]<<8)|m_data[1]))<<8)|m_data[0]; // NOTE: iar compiler hell
+	return (((unsigned long)((m_rx[1]<<8)|m_rx[2]))<<8)|m_rx[3]; // NOTE: iar compiler hell
 }
 
 /**
@@ -510,70 +1024,966 @@ unsigned long AD779X_ReadDataRegister24()
  */
 unsigned short AD779X_ReadDataSample16()
 {
-	unsigned char m_data[3];
+	/* cmd: read DATA register */
+	const uint8_t m_tx[4] = {AD779X_RDR_DATA, 0, 0, 0};
+	uint8_t m_rx[4];
 	unsigned short m_data_sample = 0;
 	
+	/* get value: 24-bit for AD7793, 16-bit for AD7792 */
+	AD779X_Transfer(m_tx, m_rx, (AD779X_MODEL(ADCDevice) == ad7793) ? 4 : 3, 1);
+	
+	switch (AD779X_MODEL(ADCDevice))
+	{
+		case ad7792:
+		case ad7793: m_data_sample = ((m_rx[1] << 8)| m_rx[2]); break;
+		
+		default: break;
+	}
+	
+	AD779X_CountResult(0);
+	
+	return m_data_sample;
+}
+
+/**
+ * @brief  Read data from ADC (24-bit range)
+ * @param  None
+ * @return Data sample value
+ */
+unsigned long AD779X_ReadDataSample24()
+{
+	/* cmd: read DATA register */
+	const uint8_t m_tx[4] = {AD779X_RDR_DATA, 0, 0, 0};
+	uint8_t m_rx[4];
+	
+	/* get value: 24-bit for AD7793, 16-bit for AD7792 */
+	AD779X_Transfer(m_tx, m_rx, (AD779X_MODEL(ADCDevice) == ad7793) ? 4 : 3, 1);
+	
+	AD779X_CountResult(0);
+	
+	return AD779X_MakeSample24(&m_rx[1]);
+}
+
+#endif
+
+/**
+ * @brief  Enter continuous read mode (cs line stays active until stop)
+ * @param  None
+ * @return None
+ */
+void AD779X_StartContinuousRead()
+{
+	/* cmd: read DATA register continuously */
+	const uint8_t m_tx[1] = {AD779X_RDR_CREED};
+	uint8_t m_rx[1];
+	
 	/* active cs line */
 	ADCDevice.CSControl(cssEnable);
 	
-	/* send cmd: read DATA register */
-	ADCDevice.TxByte(AD779X_RDR_DATA);
+	AD779X_Exchange(m_tx, m_rx, 1, 1);
 	
-	if (ADCDevice.Model == ad7793)
-		m_data[2] = ADCDevice.RxByte();
+	/* store read mode */
+	ADCDevice.ReadMode = rdmContinuous;
+}
+
+/**
+ * @brief  Read one sample in continuous read mode (24-bit range)
+ * @param  None
+ * @return Data sample value, AD779X_SAMPLE_TIMEOUT - RDY timeout
+ */
+unsigned long AD779X_ReadContinuousSample24()
+{
+	/* din must be low while data is clocked out */
+	const uint8_t m_tx[3] = {0, 0, 0};
+	uint8_t m_rx[3];
 	
-	/* get value */
-	m_data[1] = ADCDevice.RxByte();
-	m_data[0] = ADCDevice.RxByte();
+	/* wait RDY on DOUT/RDY line, no data is clocked out on timeout */
+	if (!AD779X_WaitRDY())
+		return AD779X_SAMPLE_TIMEOUT;
+	
+	AD779X_TRACE_BEGIN(trcReadData, &ADCDevice);
+	
+	/* get value without command byte */
+	AD779X_Exchange(m_tx, m_rx, (AD779X_MODEL(ADCDevice) == ad7793) ? 3 : 2, 0);
+	
+	AD779X_TRACE_END(trcReadData, &ADCDevice);
+	
+	AD779X_CountResult(0);
+	
+	return AD779X_MakeSample24(m_rx);
+}
+
+/**
+ * @brief  Read samples in continuous read mode (24-bit range)
+ * @param  pBuffer - buffer for samples (AD779X_SAMPLE_TIMEOUT - RDY timeout)
+ * @param  Count - count of samples need read
+ * @return None
+ */
+void AD779X_ReadContinuous24(unsigned long *pBuffer, size_t Count)
+{
+	while (Count--)
+		*pBuffer++ = AD779X_ReadContinuousSample24();
+}
+
+/**
+ * @brief  Exit continuous read mode: 0x58 is written while RDY is low,
+ *         then last sample is read and cs line is inactive
+ * @param  None
+ * @return Last data sample value (24-bit range), AD779X_SAMPLE_TIMEOUT - RDY timeout:
+ *         0x58 is not taken by ADC, so ADC is reset (registers are reset values)
+ */
+unsigned long AD779X_StopContinuousRead()
+{
+	/* cmd: read DATA register (single) */
+	const uint8_t m_tx[4] = {AD779X_RDR_DATA, 0, 0, 0};
+	uint8_t m_rx[4];
+	
+	/* wait RDY on DOUT/RDY line: 0x58 is taken only while RDY is low */
+	if (!AD779X_WaitRDY())
+	{
+		/* 32 ones are taken in continuous read mode: exit by reset */
+		AD779X_Reset();
+		return AD779X_SAMPLE_TIMEOUT;
+	}
+	
+	AD779X_TRACE_BEGIN(trcReadData, &ADCDevice);
+	
+	AD779X_Exchange(m_tx, m_rx, (AD779X_MODEL(ADCDevice) == ad7793) ? 4 : 3, 1);
 	
 	/* inactive cs line */
 	ADCDevice.CSControl(cssDisable);
 	
-	switch (ADCDevice.Model)
+	AD779X_TRACE_END(trcReadData, &ADCDevice);
+	
+	/* store read mode */
+	ADCDevice.ReadMode = rdmSingle;
+	
+	AD779X_CountResult(0);
+	
+	return AD779X_MakeSample24(&m_rx[1]);
+}
+
+/**
+ * @brief  Init sample ring
+ * @param  pRing - ring
+ * @param  pBuffer - storage for samples
+ * @param  Size - size of storage, rounded down to power of 2
+ * @return Size of ring, 0 - no storage (pBuffer is NULL or Size is 0): all samples are dropped
+ */
+uint16_t AD779X_RingInit(tAD779X_SampleRing *pRing, tAD779X_RingSample *pBuffer, uint16_t Size)
+{
+	/* clear low bits until one bit is left */
+	while (Size & (Size - 1))
+		Size &= Size - 1;
+	
+	if (!pBuffer || !Size)
 	{
-		case ad7792: m_data_sample = ((m_data[1] << 8)| m_data[0]); break;
-		case ad7793: m_data_sample = ((m_data[2] << 8)| m_data[1]); break;
+		pBuffer = NULL;
+		Size    = 1;
 	}
 	
-	return m_data_sample;
+	pRing->pBuffer  = pBuffer;
+	pRing->Mask     = Size - 1;
+	pRing->Head     = 0;
+	pRing->Tail     = 0;
+	pRing->Overruns = 0;
+	
+	return pBuffer ? Size : 0;
 }
 
 /**
- * @brief  Read data from ADC (24-bit range)
+ * @brief  Get count of samples in ring
+ * @param  pRing - ring
+ * @return Count of samples
+ */
+uint16_t AD779X_RingCount(tAD779X_SampleRing *pRing)
+{
+	return (uint16_t)(pRing->Head - pRing->Tail);
+}
+
+/**
+ * @brief  Read samples from ring (consumer side)
+ * @param  pRing - ring
+ * @param  pSamples - buffer for samples
+ * @param  Count - max count of samples need read
+ * @return Count of samples read
+ */
+uint16_t AD779X_RingRead(tAD779X_SampleRing *pRing, tAD779X_RingSample *pSamples, uint16_t Count)
+{
+	uint16_t m_tail = pRing->Tail;
+	uint16_t m_count = (uint16_t)(pRing->Head - m_tail);
+	uint16_t i;
+	
+	if (Count > m_count)
+		Count = m_count;
+	
+	/* read samples after index */
+	AD779X_MEMORY_BARRIER();
+	
+	for (i = 0; i < Count; i++)
+		pSamples[i] = pRing->pBuffer[(uint16_t)(m_tail + i) & pRing->Mask];
+	
+	/* free slots only after samples copied */
+	AD779X_MEMORY_BARRIER();
+	pRing->Tail = m_tail + Count;
+	
+	return Count;
+}
+
+/**
+ * @brief  Push sample to ring (producer side)
+ * @param  pRing - ring
+ * @param  pSample - sample
+ * @return 1 - sample is stored, 0 - ring is full: sample is dropped
+ */
+static uint8_t AD779X_RingWrite(tAD779X_SampleRing *pRing, const tAD779X_RingSample *pSample)
+{
+	uint16_t m_head = pRing->Head;
+	
+	if (!pRing->pBuffer || ((uint16_t)(m_head - pRing->Tail) > pRing->Mask))
+	{
+		/* ring is full or has no storage: drop sample */
+		pRing->Overruns++;
+		return 0;
+	}
+	
+	pRing->pBuffer[m_head & pRing->Mask] = *pSample;
+	
+	/* publish sample only after it is written */
+	AD779X_MEMORY_BARRIER();
+	pRing->Head = m_head + 1;
+	
+	return 1;
+}
+
+/**
+ * @brief  Read STATUS and DATA registers in one cs window
+ *         (continuous read mode: DATA only, channel from CONFIG register)
+ * @param  pSample - read sample
+ * @return None
+ */
+static void AD779X_ReadStatusData(tAD779X_RingSample *pSample)
+{
+	/* cmd: read STATUS register, cmd: read DATA register */
+	const uint8_t m_tx[6] = {AD779X_RDR_STATUS, 0, AD779X_RDR_DATA, 0, 0, 0};
+	uint8_t m_rx[6];
+	tAD779X_Segment m_segments[2] = {{2, 1}, {4, 1}};
+	
+	m_segments[1].Size = (AD779X_MODEL(ADCDevice) == ad7793) ? 4 : 3;
+	
+	if (ADCDevice.ReadMode == rdmContinuous)
+	{
+		/* cs line is active already, data is clocked out without command */
+		AD779X_Exchange(&m_tx[3], &m_rx[3], m_segments[1].Size - 1, 0);
+		
+		/* no STATUS register in continuous read mode: channel from CONFIG register */
+		m_rx[1] = ADCDevice.ConfigReg.CHSEL;
+	}
+	else
+	{
+		AD779X_TRACE_BEGIN(trcReadData, &ADCDevice);
+		
+		/* active cs line */
+		ADCDevice.CSControl(cssEnable);
+		
+		AD779X_ExchangeSegments(m_tx, m_rx, m_segments, 2);
+		
+		/* inactive cs line */
+		ADCDevice.CSControl(cssDisable);
+		
+		AD779X_TRACE_END(trcReadData, &ADCDevice);
+	}
+	
+	pSample->Code    = AD779X_MakeSample24(&m_rx[3]);
+	pSample->Status  = m_rx[1];
+	pSample->Channel = m_rx[1] & AD779X_SR_CHC;
+	
+	AD779X_CountResult(m_rx[1]);
+}
+
+/**
+ * @brief  Data ready handler, call from RDY interrupt: read STATUS and DATA
+ *         registers in one cs window and push sample to attached ring
  * @param  None
- * @return Data sample value
+ * @return None
  */
-unsigned long AD779X_ReadDataSample24()
+void AD779X_OnDataReady()
 {
-	unsigned char m_data[3];
-	unsigned long m_data_sample = 0;
+	tAD779X_RingSample m_sample;
+	
+	AD779X_ReadStatusData(&m_sample);
+	
+	if (ADCDevice.pRing && !AD779X_RingWrite(ADCDevice.pRing, &m_sample))
+		AD779X_COUNTER_INC(ADCDevice.Telemetry.Overruns);
+}
+
+/**
+ * @brief  Read sample record: STATUS and DATA registers in one cs window,
+ *         time of read and number of read (continuous read mode: DATA only,
+ *         STATUS is made from CONFIG register, AD779X_RECORD_SYNTH_STATUS)
+ * @param  pRecord - sample record
+ * @return None
+ */
+void AD779X_ReadSampleRecord(tAD779X_SampleRecord *pRecord)
+{
+	tAD779X_RingSample m_sample;
+	
+	/* continuous read mode: no STATUS register read */
+	pRecord->Flags = (ADCDevice.ReadMode == rdmContinuous) ? AD779X_RECORD_SYNTH_STATUS : 0;
+	
+	/* time before cs window: nearest to RDY, if called on data ready */
+	if (ADCDevice.GetTimeUs)
+	{
+		pRecord->Timestamp = ADCDevice.GetTimeUs();
+		pRecord->Flags |= AD779X_RECORD_TIMESTAMP;
+	}
+	else
+	{
+		pRecord->Timestamp = 0;
+	}
+	
+	AD779X_ReadStatusData(&m_sample);
+	
+	pRecord->Code     = m_sample.Code;
+	pRecord->Status   = m_sample.Status;
+	pRecord->Channel  = m_sample.Channel;
+	pRecord->Sequence = ADCDevice.Sequence++;
+}
+
+/**
+ * @brief  Put write command of 16-bit register in frame
+ * @param  pFrame - frame
+ * @param  Cmd - write command
+ * @param  Data - register value
+ * @return Size of segment
+ */
+static uint8_t AD779X_FrameWrite16(uint8_t *pFrame, uint8_t Cmd, unsigned short Data)
+{
+	pFrame[0] = Cmd;
+	pFrame[1] = Data >> 8;
+	pFrame[2] = Data & 0x00FF;
+	
+	return 3;
+}
+
+/**
+ * @brief  Put config and mode writes for scan step in frame
+ * @param  pStep - scan step
+ * @param  pFrame - frame
+ * @param  pSegments - segments of frame
+ * @param  pCount - count of segments (in/out)
+ * @return Size of written part of frame
+ */
+static uint8_t AD779X_SeqFrameStep(const tAD779X_ScanStep *pStep, uint8_t *pFrame, tAD779X_Segment *pSegments, uint8_t *pCount)
+{
+	tAD779X_ConfigRegister m_config_reg = ADCDevice.ConfigReg;
+	tAD779X_ModeRegister m_mode_reg = ADCDevice.ModeReg;
+	uint8_t m_size = 0;
+	
+	m_config_reg.CHSEL = pStep->Channel;
+	m_config_reg.GAIN  = pStep->Gain;
+	
+	m_mode_reg.MODE = mdsContinuous;
+	m_mode_reg.FS   = pStep->Rate;
+	
+	/* write CONFIG register, if it is changed: conversion restarts */
+	if (m_config_reg.DATA != ADCDevice.ConfigReg.DATA)
+	{
+		m_size += AD779X_FrameWrite16(&pFrame[m_size], AD779X_WRR_CONFIG, m_config_reg.DATA);
+		pSegments[(*pCount)].Size = 3;
+		pSegments[(*pCount)++].TxSize = 3;
+		ADCDevice.ConfigReg = m_config_reg;
+	}
+	
+	/* write MODE register, if it is changed */
+	if (m_mode_reg.DATA != ADCDevice.ModeReg.DATA)
+	{
+		m_size += AD779X_FrameWrite16(&pFrame[m_size], AD779X_WRR_MODE, m_mode_reg.DATA);
+		pSegments[(*pCount)].Size = 3;
+		pSegments[(*pCount)++].TxSize = 3;
+		ADCDevice.ModeReg = m_mode_reg;
+	}
+	
+	return m_size;
+}
+
+/**
+ * @brief  Start scan sequencer: set first step and continuous conversion
+ * @param  pSeq - sequencer
+ * @param  pSteps - table of steps (must be valid while sequencer works)
+ * @param  Count - count of steps
+ * @return 1 - started, 0 - no steps (pSteps is NULL or Count is 0), sequencer is stopped
+ */
+uint8_t AD779X_SeqStart(tAD779X_Sequencer *pSeq, const tAD779X_ScanStep *pSteps, uint8_t Count)
+{
+	uint8_t m_tx[6], m_rx[6];
+	tAD779X_Segment m_segments[2];
+	uint8_t m_count = 0, m_prev = ADCDevice.ModeReg.MODE;
+	
+	pSeq->Step = 0;
+	
+	if (!pSteps || !Count)
+	{
+		pSeq->pSteps = NULL;
+		pSeq->Count  = 0;
+		return 0;
+	}
+	
+	pSeq->pSteps = pSteps;
+	pSeq->Count  = Count;
+	
+	AD779X_SeqFrameStep(&pSteps[0], m_tx, m_segments, &m_count);
+	
+	/* config and mode writes in one cs window */
+	if (m_count)
+	{
+		AD779X_TRACE_BEGIN(trcFrame, &ADCDevice);
+		
+		/* active cs line */
+		ADCDevice.CSControl(cssEnable);
+		
+		AD779X_ExchangeSegments(m_tx, m_rx, m_segments, m_count);
+		
+		/* inactive cs line */
+		ADCDevice.CSControl(cssDisable);
+		
+		AD779X_TRACE_END(trcFrame, &ADCDevice);
+		
+		AD779X_StartDeadline(mdsContinuous, m_prev);
+	}
+	
+	return 1;
+}
+
+/**
+ * @brief  Service scan sequencer on completed conversion: read data and
+ *         set next step in the same cs window
+ * @param  pSeq - sequencer
+ * @param  pStep - number of step of read sample
+ * @return Data sample value (24-bit range)
+ */
+unsigned long AD779X_SeqService(tAD779X_Sequencer *pSeq, uint8_t *pStep)
+{
+	uint8_t m_tx[10] = {AD779X_RDR_DATA, 0, 0, 0};
+	uint8_t m_rx[10];
+	tAD779X_Segment m_segments[3];
+	uint8_t m_size = (AD779X_MODEL(ADCDevice) == ad7793) ? 4 : 3;
+	uint8_t m_count = 1;
+	
+	/* sequencer is not started: data read only */
+	if (!pSeq->pSteps)
+	{
+		*pStep = 0;
+		return AD779X_ReadDataSample24();
+	}
+	
+	/* completed step */
+	*pStep = pSeq->Step;
+	
+	/* next step */
+	if (++pSeq->Step >= pSeq->Count)
+		pSeq->Step = 0;
+	
+	/* cmd: read DATA register */
+	m_segments[0].Size = m_size;
+	m_segments[0].TxSize = 1;
+	
+	/* cmd: write CONFIG and MODE registers of next step */
+	AD779X_SeqFrameStep(&pSeq->pSteps[pSeq->Step], &m_tx[m_size], m_segments, &m_count);
+	
+	AD779X_TRACE_BEGIN(trcFrame, &ADCDevice);
 	
 	/* active cs line */
 	ADCDevice.CSControl(cssEnable);
 	
-	/* send cmd: read DATA register */
-	ADCDevice.TxByte(AD779X_RDR_DATA);
+	AD779X_ExchangeSegments(m_tx, m_rx, m_segments, m_count);
 	
-	if (ADCDevice.Model == ad7793)
-		m_data[2] = ADCDevice.RxByte();
+	/* inactive cs line */
+	ADCDevice.CSControl(cssDisable);
 	
-	/* get value */
-	m_data[1] = ADCDevice.RxByte();
-	m_data[0] = ADCDevice.RxByte();
+	AD779X_TRACE_END(trcFrame, &ADCDevice);
+	
+	/* next step is set: conversion restarts */
+	if (m_count > 1)
+		AD779X_StartDeadline(mdsContinuous, mdsContinuous);
+	
+	AD779X_CountResult(0);
+	
+	return AD779X_MakeSample24(&m_rx[1]);
+}
+
+/**
+ * @brief  Init transaction: no commands
+ * @param  pTrans - transaction
+ * @return None
+ */
+void AD779X_TransInit(tAD779X_Transaction *pTrans)
+{
+	pTrans->Count = 0;
+	pTrans->Size  = 0;
+}
+
+/**
+ * @brief  Queue command with data in transaction
+ * @param  pTrans - transaction
+ * @param  Size - size of segment
+ * @param  TxSize - count of written bytes of segment
+ * @return Number of command or AD779X_TRANS_FULL
+ */
+static uint8_t AD779X_TransQueue(tAD779X_Transaction *pTrans, uint8_t Size, uint8_t TxSize)
+{
+	if ((pTrans->Count >= AD779X_TRANS_OPS) || (pTrans->Size + Size > AD779X_TRANS_SIZE))
+		return AD779X_TRANS_FULL;
+	
+	pTrans->Segments[pTrans->Count].Size   = Size;
+	pTrans->Segments[pTrans->Count].TxSize = TxSize;
+	pTrans->Size += Size;
+	
+	return pTrans->Count++;
+}
+
+/**
+ * @brief  Queue register write in transaction
+ * @param  pTrans - transaction
+ * @param  Cmd - write command (AD779X_WRR_xxx)
+ * @param  Data - register value
+ * @param  Size - size of register, bytes (1..3)
+ * @return Number of command or AD779X_TRANS_FULL
+ */
+uint8_t AD779X_TransWrite(tAD779X_Transaction *pTrans, uint8_t Cmd, unsigned long Data, uint8_t Size)
+{
+	uint8_t *m_frame = &pTrans->Tx[pTrans->Size];
+	uint8_t m_op = AD779X_TransQueue(pTrans, Size + 1, Size + 1);
+	
+	if (m_op != AD779X_TRANS_FULL)
+	{
+		/* cmd, then data MSB first */
+		m_frame[0] = Cmd;
+		
+		while (Size)
+		{
+			m_frame[Size--] = Data & 0xFF;
+			Data >>= 8;
+		}
+	}
+	
+	return m_op;
+}
+
+/**
+ * @brief  Queue register read in transaction
+ * @param  pTrans - transaction
+ * @param  Cmd - read command (AD779X_RDR_xxx)
+ * @param  Size - size of register, bytes (1..3)
+ * @return Number of command or AD779X_TRANS_FULL
+ */
+uint8_t AD779X_TransRead(tAD779X_Transaction *pTrans, uint8_t Cmd, uint8_t Size)
+{
+	uint8_t *m_frame = &pTrans->Tx[pTrans->Size];
+	uint8_t m_op = AD779X_TransQueue(pTrans, Size + 1, 1);
+	
+	if (m_op != AD779X_TRANS_FULL)
+	{
+		/* cmd, then dummy bytes */
+		m_frame[0] = Cmd;
+		
+		while (Size)
+			m_frame[Size--] = 0;
+	}
+	
+	return m_op;
+}
+
+/**
+ * @brief  Queue MODE register write in transaction
+ * @param  pTrans - transaction
+ * @param  Data - need write
+ * @return Number of command or AD779X_TRANS_FULL
+ */
+uint8_t AD779X_TransWriteMode(tAD779X_Transaction *pTrans, unsigned short Data)
+{
+	return AD779X_TransWrite(pTrans, AD779X_WRR_MODE, Data, 2);
+}
+
+/**
+ * @brief  Queue CONFIG register write in transaction
+ * @param  pTrans - transaction
+ * @param  Data - need write
+ * @return Number of command or AD779X_TRANS_FULL
+ */
+uint8_t AD779X_TransWriteConfig(tAD779X_Transaction *pTrans, unsigned short Data)
+{
+	return AD779X_TransWrite(pTrans, AD779X_WRR_CONFIG, Data, 2);
+}
+
+/**
+ * @brief  Queue IO register write in transaction
+ * @param  pTrans - transaction
+ * @param  Data - need write
+ * @return Number of command or AD779X_TRANS_FULL
+ */
+uint8_t AD779X_TransWriteIO(tAD779X_Transaction *pTrans, unsigned char Data)
+{
+	return AD779X_TransWrite(pTrans, AD779X_WRR_IO, Data, 1);
+}
+
+/**
+ * @brief  Get value of queued command (read data after execute)
+ * @param  pTrans - transaction
+ * @param  Op - number of command
+ * @return Register value
+ */
+unsigned long AD779X_TransResult(tAD779X_Transaction *pTrans, uint8_t Op)
+{
+	const uint8_t *m_frame = (pTrans->Segments[Op].TxSize == 1) ? pTrans->Rx : pTrans->Tx;
+	unsigned long m_value = 0;
+	uint8_t i, m_offset = 0;
+	
+	for (i = 0; i < Op; i++)
+		m_offset += pTrans->Segments[i].Size;
+	
+	/* skip cmd, data MSB first */
+	for (i = 1; i < pTrans->Segments[Op].Size; i++)
+		m_value = (m_value << 8) | m_frame[m_offset + i];
+	
+	return m_value;
+}
+
+/**
+ * @brief  Execute transaction: all commands in one cs window
+ * @param  pTrans - transaction
+ * @return None
+ */
+void AD779X_TransExecute(tAD779X_Transaction *pTrans)
+{
+	uint8_t i, m_offset = 0;
+	uint8_t m_restart = 0, m_mode = ADCDevice.ModeReg.MODE, m_prev = ADCDevice.ModeReg.MODE;
+	
+	if (!pTrans->Count)
+		return;
+	
+	AD779X_TRACE_BEGIN(trcFrame, &ADCDevice);
+	
+	/* active cs line */
+	ADCDevice.CSControl(cssEnable);
+	
+	AD779X_ExchangeSegments(pTrans->Tx, pTrans->Rx, pTrans->Segments, pTrans->Count);
 	
 	/* inactive cs line */
 	ADCDevice.CSControl(cssDisable);
 	
-	switch (ADCDevice.Model)
+	AD779X_TRACE_END(trcFrame, &ADCDevice);
+	
+	/* store written values of MODE, CONFIG and IO registers */
+	for (i = 0; i < pTrans->Count; i++)
 	{
-		case ad7792:
-			m_data_sample = (((unsigned long)((m_data[1] << 8)| m_data[0])) << 8);
-			break;
+		switch (pTrans->Tx[m_offset])
+		{
+			case AD779X_WRR_MODE:
+				ADCDevice.ModeReg.DATA = AD779X_TransResult(pTrans, i);
+				m_mode = ADCDevice.ModeReg.MODE;
+				m_restart = 1;
+				if (AD779X_MODE_IS_ONESHOT(ADCDevice.ModeReg.MODE))
+					ADCDevice.ModeReg.MODE = AD779X_MODE_AFTER_ONESHOT(ADCDevice.ModeReg.MODE);
+				break;
+			
+			case AD779X_WRR_CONFIG:
+				ADCDevice.ConfigReg.DATA = AD779X_TransResult(pTrans, i);
+				m_restart = 1;
+				break;
+			
+			case AD779X_WRR_IO:
+				ADCDevice.IOReg.DATA = AD779X_TransResult(pTrans, i);
+				break;
+			
+			case AD779X_WRR_OFFSET:
+				if (pTrans->Segments[i].Size == 3)
+					ADCDevice.OfReg.u16 = AD779X_TransResult(pTrans, i);
+				else
+					ADCDevice.OfReg.u32 = AD779X_TransResult(pTrans, i);
+				break;
+			
+			case AD779X_WRR_FSCLAE:
+				if (pTrans->Segments[i].Size == 3)
+					ADCDevice.FsReg.u16 = AD779X_TransResult(pTrans, i);
+				else
+					ADCDevice.FsReg.u32 = AD779X_TransResult(pTrans, i);
+				break;
+		}
 		
-		case ad7793:
-			m_data_sample = ((((unsigned long)((m_data[2] << 8)| m_data[1])) << 8) | m_data[0]);
-			break;
+		m_offset += pTrans->Segments[i].Size;
 	}
 	
-	return m_data_sample;
+	/* conversion restarts after MODE or CONFIG write */
+	if (m_restart)
+		AD779X_StartDeadline(m_mode, m_prev);
+}
+
+/**
+ * @brief  Set CONFIG, MODE and IO registers in one cs window,
+ *         registers with unchanged value are not written
+ * @param  Config - CONFIG register value
+ * @param  Mode - MODE register value
+ * @param  IO - IO register value
+ * @return None
+ */
+void AD779X_SetConfiguration(unsigned short Config, unsigned short Mode, unsigned char IO)
+{
+	tAD779X_Transaction m_trans;
+	tAD779X_ModeRegister m_mode_reg;
+	
+	m_mode_reg.DATA = Mode;
+	
+	AD779X_TransInit(&m_trans);
+	
+	if (IO != ADCDevice.IOReg.DATA)
+		AD779X_TransWriteIO(&m_trans, IO);
+	
+	if (Config != ADCDevice.ConfigReg.DATA)
+		AD779X_TransWriteConfig(&m_trans, Config);
+	
+	/* MODE register is last: conversion starts with new configuration */
+	if ((Mode != ADCDevice.ModeReg.DATA) || AD779X_MODE_IS_ONESHOT(m_mode_reg.MODE))
+		AD779X_TransWriteMode(&m_trans, Mode);
+	
+	AD779X_TransExecute(&m_trans);
+}
+
+/**
+ * @brief  Restore calibration coefficients in one cs window: stop conversion
+ *         (FULL-SCALE register is written only in Idle/Power-down mode), select
+ *         update rate, channel and gain of entry, write OFFSET and FULL-SCALE
+ *         registers, restore previous mode
+ * @param  pEntry - calibration coefficients
+ * @return None
+ */
+void AD779X_WriteCalibration(const tAD779X_CalEntry *pEntry)
+{
+	const uint8_t m_size = (AD779X_MODEL(ADCDevice) == ad7793) ? 3 : 2;
+	tAD779X_ConfigRegister m_config_reg = ADCDevice.ConfigReg;
+	tAD779X_ModeRegister m_mode_reg = ADCDevice.ModeReg;
+	tAD779X_ModeRegister m_stop_reg;
+	tAD779X_Transaction m_trans;
+	
+	m_config_reg.CHSEL = pEntry->Channel;
+	m_config_reg.GAIN  = pEntry->Gain;
+	
+	if (pEntry->Rate != fsNone)
+		m_mode_reg.FS = pEntry->Rate;
+	
+	/* Power-down mode is kept, other modes are stopped by Idle mode */
+	m_stop_reg = m_mode_reg;
+	
+	if (m_stop_reg.MODE != mdsPowerDown)
+		m_stop_reg.MODE = mdsIdle;
+	
+	AD779X_TransInit(&m_trans);
+	
+	if (m_stop_reg.DATA != ADCDevice.ModeReg.DATA)
+		AD779X_TransWriteMode(&m_trans, m_stop_reg.DATA);
+	
+	/* coefficient registers of selected channel are accessed */
+	if (m_config_reg.DATA != ADCDevice.ConfigReg.DATA)
+		AD779X_TransWriteConfig(&m_trans, m_config_reg.DATA);
+	
+	AD779X_TransWrite(&m_trans, AD779X_WRR_OFFSET, pEntry->Offset, m_size);
+	AD779X_TransWrite(&m_trans, AD779X_WRR_FSCLAE, pEntry->FScale, m_size);
+	
+	/* previous mode: conversion restarts with restored coefficients */
+	if (m_mode_reg.DATA != m_stop_reg.DATA)
+		AD779X_TransWriteMode(&m_trans, m_mode_reg.DATA);
+	
+	AD779X_TransExecute(&m_trans);
+}
+
+/**
+ * @brief  Read calibration coefficients of selected channel, gain and rate
+ *         (after AD779X_StartZSCalibration and AD779X_StartFSCalibration)
+ * @param  pEntry - calibration coefficients
+ * @return None
+ */
+void AD779X_ReadCalibration(tAD779X_CalEntry *pEntry)
+{
+	const uint8_t m_size = (AD779X_MODEL(ADCDevice) == ad7793) ? 3 : 2;
+	tAD779X_Transaction m_trans;
+	uint8_t m_offset, m_fscale;
+	
+	AD779X_TransInit(&m_trans);
+	m_offset = AD779X_TransRead(&m_trans, AD779X_RDR_OFFSET, m_size);
+	m_fscale = AD779X_TransRead(&m_trans, AD779X_RDR_FSCLAE, m_size);
+	AD779X_TransExecute(&m_trans);
+	
+	pEntry->Channel = ADCDevice.ConfigReg.CHSEL;
+	pEntry->Gain = ADCDevice.ConfigReg.GAIN;
+	pEntry->Rate = ADCDevice.ModeReg.FS;
+	pEntry->Reserved = 0;
+	pEntry->Offset = AD779X_TransResult(&m_trans, m_offset);
+	pEntry->FScale = AD779X_TransResult(&m_trans, m_fscale);
+}
+
+/**
+ * @brief  Wait for result: sleep until predicted deadline (GetTimeUs, DelayUs),
+ *         then check RDY line; without GetTimeUs - TimeoutUs checks of RDY line
+ * @param  TimeoutUs - max time of waiting, us
+ * @return 1 - data ready, 0 - timeout
+ */
+unsigned char AD779X_WaitReady(uint32_t TimeoutUs)
+{
+	uint32_t m_start, m_polls = 0;
+	int32_t m_remain;
+	
+	if (ADCDevice.GetTimeUs)
+	{
+		m_start = ADCDevice.GetTimeUs();
+		
+		/* sleep until expected end of conversion, no SPI traffic */
+		if (ADCDevice.DeadlineSet && ADCDevice.DelayUs)
+		{
+			m_remain = (int32_t)(ADCDevice.Deadline - m_start);
+			
+			if (m_remain > 0)
+				ADCDevice.DelayUs(((uint32_t)m_remain < TimeoutUs) ? (uint32_t)m_remain : TimeoutUs);
+		}
+		
+		while (!AD779X_CheckReadyHW())
+		{
+			if ((ADCDevice.GetTimeUs() - m_start) >= TimeoutUs)
+			{
+				AD779X_COUNTER_INC(ADCDevice.Telemetry.Timeouts);
+				return 0;
+			}
+			
+			/* conversion is late: poll RDY with interval, not each SPI window */
+			if (ADCDevice.DelayUs)
+				ADCDevice.DelayUs(AD779X_READY_POLL_US);
+		}
+	}
+	else
+	{
+		while (!AD779X_CheckReadyHW())
+		{
+			if (m_polls++ >= TimeoutUs)
+			{
+				AD779X_COUNTER_INC(ADCDevice.Telemetry.Timeouts);
+				return 0;
+			}
+			
+			if (ADCDevice.DelayUs)
+				ADCDevice.DelayUs(1);
+		}
+	}
+	
+	AD779X_NextDeadline();
+	
+	return 1;
+}
+
+/**
+ * @brief  Single conversion: set channel, gain and rate with trigger in one cs window,
+ *         wait result (AD779X_WaitReady), read it and set Idle/Power-down in one cs window
+ * @param  Channel - channel
+ * @param  Gain - gain
+ * @param  Rate - filter update rate
+ * @param  Policy - state of ADC after shot
+ * @param  pSample - sample value (24-bit range)
+ * @param  pStats - statistics, may be NULL
+ * @return 1 - sample is read, 0 - timeout
+ */
+unsigned char AD779X_SingleShot(tAD779X_ChSelect Channel, tAD779X_GainSelect Gain, tAD779X_FilterSelect Rate, tAD779X_ShotPolicy Policy, unsigned long *pSample, tAD779X_ShotStats *pStats)
+{
+	const uint8_t m_size = (AD779X_MODEL(ADCDevice) == ad7793) ? 3 : 2;
+	tAD779X_ConfigRegister m_config_reg = ADCDevice.ConfigReg;
+	tAD779X_ModeRegister m_mode_reg = ADCDevice.ModeReg;
+	tAD779X_Transaction m_trans;
+	uint32_t m_start = 0, m_end;
+	unsigned long m_expected;
+	uint8_t m_ready;
+	
+	m_config_reg.CHSEL = Channel;
+	m_config_reg.GAIN  = Gain;
+	
+	m_mode_reg.MODE = mdsSingle;
+	m_mode_reg.FS   = Rate;
+	
+	/* single conversion takes settling time, after Power-down oscillator powers up first */
+	m_expected = AD779X_SettlingTimeUs(Rate, (tAD779X_ClkSourceSelect)m_mode_reg.CLKS);
+	
+	if (ADCDevice.ModeReg.MODE == mdsPowerDown)
+		m_expected += AD779X_POWER_UP_US;
+	
+	if (ADCDevice.GetTimeUs)
+		m_start = ADCDevice.GetTimeUs();
+	
+	/* config and trigger in one cs window, MODE is last: conversion starts */
+	AD779X_TransInit(&m_trans);
+	
+	if (m_config_reg.DATA != ADCDevice.ConfigReg.DATA)
+		AD779X_TransWriteConfig(&m_trans, m_config_reg.DATA);
+	
+	AD779X_TransWriteMode(&m_trans, m_mode_reg.DATA);
+	AD779X_TransExecute(&m_trans);
+	
+	/* timeout with margin */
+	m_ready = AD779X_WaitReady(2 * m_expected);
+	
+	/* read result and set mode in one cs window: ADC is in Power-down after
+	   conversion, Idle must be written; write also stops conversion on timeout */
+	AD779X_TransInit(&m_trans);
+	
+	if (m_ready)
+		AD779X_TransRead(&m_trans, AD779X_RDR_DATA, m_size);
+	
+	m_mode_reg.MODE = (Policy == sspPowerDown) ? mdsPowerDown : mdsIdle;
+	AD779X_TransWriteMode(&m_trans, m_mode_reg.DATA);
+	
+	AD779X_TransExecute(&m_trans);
+	
+	if (m_ready)
+	{
+		*pSample = AD779X_MakeSample24(&m_trans.Rx[1]);
+		AD779X_CountResult(0);
+	}
+	
+	if (pStats)
+	{
+		pStats->Shots++;
+		
+		if (!m_ready)
+			pStats->Timeouts++;
+		
+		if (ADCDevice.GetTimeUs)
+		{
+			m_end = ADCDevice.GetTimeUs();
+			
+			pStats->LastUs = m_end - m_start;
+			pStats->ActiveUs += pStats->LastUs;
+			pStats->ElapsedUs += (pStats->Shots > 1) ? m_end - pStats->EndUs : pStats->LastUs;
+			pStats->EndUs = m_end;
+			
+			if (pStats->ElapsedUs)
+				pStats->DutyPermille = (uint16_t)((pStats->ActiveUs * 1000) / pStats->ElapsedUs);
+		}
+	}
+	
+	return m_ready;
+}
+
+/**
+ * @brief  Get snapshot of telemetry counters (may be called while counters
+ *         are updated by interrupt or other thread)
+ * @param  pSnapshot - counters
+ * @return None
+ */
+void AD779X_GetTelemetry(tAD779X_Telemetry *pSnapshot)
+{
+	uint8_t i;
+	
+	pSnapshot->Conversions = AD779X_COUNTER_GET(ADCDevice.Telemetry.Conversions);
+	
+	for (i = 0; i < 8; i++)
+		pSnapshot->Errors[i] = AD779X_COUNTER_GET(ADCDevice.Telemetry.Errors[i]);
+	
+	pSnapshot->Timeouts    = AD779X_COUNTER_GET(ADCDevice.Telemetry.Timeouts);
+	pSnapshot->Overruns    = AD779X_COUNTER_GET(ADCDevice.Telemetry.Overruns);
+	pSnapshot->DetectFails = AD779X_COUNTER_GET(ADCDevice.Telemetry.DetectFails);
 }
\ No newline at end of file
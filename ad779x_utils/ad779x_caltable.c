@@ -0,0 +1,221 @@
+/**
+  ******************************************************************************
+  * @file    ad779x_caltable.c
+  * @author  Khusainov Timur
+  * @version 0.0.0.1
+  * @date    16.10.2026
+  * @brief   AD7792/AD7793: table of calibration coefficients (store/restore)
+  ******************************************************************************
+  * @attention
+  * <h2><center>&copy; COPYRIGHT 2011 timypik@gmail.com </center></h2>
+  ******************************************************************************
+  */
+
+#include "ad779x_caltable.h"
+
+/**
+ * @brief  Calculate CRC-32 (IEEE 802.3, bitwise: no table in memory)
+ * @param  pData - data
+ * @param  Size - size of data
+ * @return CRC
+ */
+static uint32_t AD779X_CRC32(const uint8_t *pData, size_t Size)
+{
+	uint32_t m_crc = 0xFFFFFFFFUL;
+	uint8_t i;
+	
+	while (Size--)
+	{
+		m_crc ^= *pData++;
+		
+		for (i = 0; i < 8; i++)
+			m_crc = (m_crc >> 1) ^ (0xEDB88320UL & (0UL - (m_crc & 1)));
+	}
+	
+	return ~m_crc;
+}
+
+/**
+ * @brief  Put value in buffer (little-endian)
+ * @param  pData - buffer
+ * @param  Value - value
+ * @param  Size - size of value, bytes
+ * @return Size of value
+ */
+static size_t AD779X_PutLE(uint8_t *pData, uint32_t Value, uint8_t Size)
+{
+	uint8_t i;
+	
+	for (i = 0; i < Size; i++)
+		pData[i] = (Value >> (8 * i)) & 0xFF;
+	
+	return Size;
+}
+
+/**
+ * @brief  Get value from buffer (little-endian)
+ * @param  pData - buffer
+ * @param  Size - size of value, bytes
+ * @return Value
+ */
+static uint32_t AD779X_GetLE(const uint8_t *pData, uint8_t Size)
+{
+	uint32_t m_value = 0;
+	
+	while (Size--)
+		m_value = (m_value << 8) | pData[Size];
+	
+	return m_value;
+}
+
+/**
+ * @brief  Init table of calibration coefficients
+ * @param  pTable - table
+ * @param  pEntries - memory for entries
+ * @param  Size - max count of entries
+ * @return None
+ */
+void AD779X_CalTableInit(tAD779X_CalTable *pTable, tAD779X_CalEntry *pEntries, uint16_t Size)
+{
+	pTable->pEntries = pEntries;
+	pTable->Size = Size;
+	pTable->Count = 0;
+}
+
+/**
+ * @brief  Find entry of channel, gain and update rate
+ * @param  pTable - table
+ * @param  Channel - channel (tAD779X_ChSelect)
+ * @param  Gain - gain (tAD779X_GainSelect)
+ * @param  Rate - update rate (tAD779X_FilterSelect)
+ * @return Entry or NULL
+ */
+tAD779X_CalEntry *AD779X_CalTableFind(tAD779X_CalTable *pTable, uint8_t Channel, uint8_t Gain, uint8_t Rate)
+{
+	uint16_t i;
+	
+	for (i = 0; i < pTable->Count; i++)
+	{
+		tAD779X_CalEntry *m_entry = &pTable->pEntries[i];
+		
+		if ((m_entry->Channel == Channel) && (m_entry->Gain == Gain) && (m_entry->Rate == Rate))
+			return m_entry;
+	}
+	
+	return NULL;
+}
+
+/**
+ * @brief  Add entry (or replace entry with same key)
+ * @param  pTable - table
+ * @param  pEntry - calibration coefficients (e.g. from AD779X_ReadCalibration)
+ * @return 1 - added, 0 - table is full
+ */
+uint8_t AD779X_CalTableAdd(tAD779X_CalTable *pTable, const tAD779X_CalEntry *pEntry)
+{
+	tAD779X_CalEntry *m_entry = AD779X_CalTableFind(pTable, pEntry->Channel, pEntry->Gain, pEntry->Rate);
+	
+	if (!m_entry)
+	{
+		if (pTable->Count >= pTable->Size)
+			return 0;
+		
+		m_entry = &pTable->pEntries[pTable->Count++];
+	}
+	
+	*m_entry = *pEntry;
+	
+	return 1;
+}
+
+/**
+ * @brief  Get size of serialized table
+ * @param  pTable - table
+ * @return Size, bytes
+ */
+size_t AD779X_CalTableSaveSize(const tAD779X_CalTable *pTable)
+{
+	return AD779X_CALTABLE_HEADER + (size_t)pTable->Count * AD779X_CALTABLE_ENTRY + AD779X_CALTABLE_CRC;
+}
+
+/**
+ * @brief  Serialize table (little-endian, protected by CRC-32)
+ * @param  pTable - table
+ * @param  pData - buffer
+ * @param  Size - size of buffer
+ * @return Size of serialized table or 0 (buffer is small)
+ */
+size_t AD779X_CalTableSave(const tAD779X_CalTable *pTable, uint8_t *pData, size_t Size)
+{
+	size_t m_size = 0;
+	uint16_t i;
+	
+	if (Size < AD779X_CalTableSaveSize(pTable))
+		return 0;
+	
+	m_size += AD779X_PutLE(&pData[m_size], AD779X_CALTABLE_MAGIC, 4);
+	m_size += AD779X_PutLE(&pData[m_size], AD779X_CALTABLE_VERSION, 2);
+	m_size += AD779X_PutLE(&pData[m_size], pTable->Count, 2);
+	
+	for (i = 0; i < pTable->Count; i++)
+	{
+		const tAD779X_CalEntry *m_entry = &pTable->pEntries[i];
+		
+		pData[m_size++] = m_entry->Channel;
+		pData[m_size++] = m_entry->Gain;
+		pData[m_size++] = m_entry->Rate;
+		pData[m_size++] = 0;
+		m_size += AD779X_PutLE(&pData[m_size], m_entry->Offset, 4);
+		m_size += AD779X_PutLE(&pData[m_size], m_entry->FScale, 4);
+	}
+	
+	m_size += AD779X_PutLE(&pData[m_size], AD779X_CRC32(pData, m_size), 4);
+	
+	return m_size;
+}
+
+/**
+ * @brief  Deserialize table
+ * @param  pTable - table (initialized, entries are replaced)
+ * @param  pData - serialized table
+ * @param  Size - size of serialized table
+ * @return 1 - loaded, 0 - bad magic, version, size or CRC (table is not changed)
+ */
+uint8_t AD779X_CalTableLoad(tAD779X_CalTable *pTable, const uint8_t *pData, size_t Size)
+{
+	size_t m_size;
+	uint16_t i, m_count;
+	
+	if (Size < AD779X_CALTABLE_HEADER + AD779X_CALTABLE_CRC)
+		return 0;
+	
+	if ((AD779X_GetLE(&pData[0], 4) != AD779X_CALTABLE_MAGIC) || (AD779X_GetLE(&pData[4], 2) != AD779X_CALTABLE_VERSION))
+		return 0;
+	
+	m_count = AD779X_GetLE(&pData[6], 2);
+	m_size = AD779X_CALTABLE_HEADER + (size_t)m_count * AD779X_CALTABLE_ENTRY;
+	
+	if ((m_count > pTable->Size) || (Size < m_size + AD779X_CALTABLE_CRC))
+		return 0;
+	
+	if (AD779X_GetLE(&pData[m_size], 4) != AD779X_CRC32(pData, m_size))
+		return 0;
+	
+	pData += AD779X_CALTABLE_HEADER;
+	
+	for (i = 0; i < m_count; i++, pData += AD779X_CALTABLE_ENTRY)
+	{
+		tAD779X_CalEntry *m_entry = &pTable->pEntries[i];
+		
+		m_entry->Channel = pData[0];
+		m_entry->Gain = pData[1];
+		m_entry->Rate = pData[2];
+		m_entry->Reserved = 0;
+		m_entry->Offset = AD779X_GetLE(&pData[4], 4);
+		m_entry->FScale = AD779X_GetLE(&pData[8], 4);
+	}
+	
+	pTable->Count = m_count;
+	
+	return 1;
+}
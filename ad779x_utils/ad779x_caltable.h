@@ -0,0 +1,45 @@
+/**
+  ******************************************************************************
+  * @file    ad779x_caltable.h
+  * @author  Khusainov Timur
+  * @version 0.0.0.1
+  * @date    16.10.2026
+  * @brief   AD7792/AD7793: table of calibration coefficients (store/restore)
+  ******************************************************************************
+  * @attention
+  * <h2><center>&copy; COPYRIGHT 2011 timypik@gmail.com </center></h2>
+  ******************************************************************************
+  */
+
+#ifndef AD779X_CALTABLE_H
+#define AD779X_CALTABLE_H
+
+#include "ad779x.h"
+
+/**
+ * @brief Serialized table: header, entries, CRC-32
+ */
+#define AD779X_CALTABLE_MAGIC   0x43373941UL /*!< "A97C" */
+#define AD779X_CALTABLE_VERSION 1
+#define AD779X_CALTABLE_HEADER  8            /*!< magic(4), version(2), count(2) */
+#define AD779X_CALTABLE_ENTRY   12           /*!< key(4), offset(4), full-scale(4) */
+#define AD779X_CALTABLE_CRC     4
+
+/**
+ * @brief Table of calibration coefficients, keyed by (channel, gain, rate)
+ */
+typedef struct
+{
+	tAD779X_CalEntry *pEntries; /*!< Entries (user memory) */
+	uint16_t Size;              /*!< Max count of entries */
+	uint16_t Count;             /*!< Count of entries */
+} tAD779X_CalTable;
+
+void AD779X_CalTableInit(tAD779X_CalTable *pTable, tAD779X_CalEntry *pEntries, uint16_t Size);
+uint8_t AD779X_CalTableAdd(tAD779X_CalTable *pTable, const tAD779X_CalEntry *pEntry);
+tAD779X_CalEntry *AD779X_CalTableFind(tAD779X_CalTable *pTable, uint8_t Channel, uint8_t Gain, uint8_t Rate);
+size_t AD779X_CalTableSaveSize(const tAD779X_CalTable *pTable);
+size_t AD779X_CalTableSave(const tAD779X_CalTable *pTable, uint8_t *pData, size_t Size);
+uint8_t AD779X_CalTableLoad(tAD779X_CalTable *pTable, const uint8_t *pData, size_t Size);
+
+#endif
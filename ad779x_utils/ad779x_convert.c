@@ -0,0 +1,121 @@
+/**
+  ******************************************************************************
+  * @file    ad779x_convert.c
+  * @author  Khusainov Timur
+  * @version 0.0.0.1
+  * @date    16.10.2026
+  * @brief   AD7792/AD7793: conversion of data codes to volts/microvolts
+  ******************************************************************************
+  * @attention
+  * <h2><center>&copy; COPYRIGHT 2011 timypik@gmail.com </center></h2>
+  ******************************************************************************
+  */
+
+#include "ad779x_convert.h"
+
+/**
+ * @brief  Make scale factors for configuration
+ * @param  pScale - scale factors
+ * @param  Config - CONFIG register value (e.g. ConfigReg.DATA of device)
+ * @param  Bits - width of codes: 24 for AD779X_ReadDataSample24 (both models),
+ *         16 for 16-bit reads (AD779X_ReadDataRegister16, AD779X_ReadDataSample16)
+ * @param  VRefExt - external reference voltage REFIN(+) - REFIN(-), V
+ * @return None
+ */
+void AD779X_ScaleInit(tAD779X_Scale *pScale, unsigned short Config, uint8_t Bits, float VRefExt)
+{
+	tAD779X_ConfigRegister m_config_reg;
+	float m_vref, m_gain, m_codes;
+	double m_uv;
+	
+	m_config_reg.DATA = Config;
+	
+	m_vref = m_config_reg.REFSEL ? AD779X_VREF_INT : VRefExt;
+	m_gain = (float)(1 << m_config_reg.GAIN);
+	
+	switch (m_config_reg.CHSEL)
+	{
+		/* temperature sensor: gain = 1, internal reference */
+		case chsTempSensor:
+			m_gain = 1.0f;
+			m_vref = AD779X_VREF_INT;
+			break;
+		
+		/* AVDD monitor: gain = 1/6, internal reference */
+		case chsAVMonitor:
+			m_gain = 1.0f / 6.0f;
+			m_vref = AD779X_VREF_INT;
+			break;
+	}
+	
+	/* bipolar: +-Vref/gain in 2^N codes, unipolar: 0..Vref/gain in 2^N codes */
+	if (m_config_reg.UB == ubUnipolar)
+	{
+		pScale->Zero = 0;
+		m_codes = (float)(1UL << Bits);
+	}
+	else
+	{
+		pScale->Zero = 1L << (Bits - 1);
+		m_codes = (float)(1UL << (Bits - 1));
+	}
+	
+	pScale->Volts = m_vref / (m_gain * m_codes);
+	
+	/* max fraction bits, while UvMul fits 31 bits */
+	m_uv = (double)pScale->Volts * 1e6;
+	pScale->UvShift = 31;
+	
+	while ((pScale->UvShift > 0) && (m_uv * (double)(1UL << pScale->UvShift) >= 2147483648.0))
+		pScale->UvShift--;
+	
+	pScale->UvMul = (uint32_t)(m_uv * (double)(1UL << pScale->UvShift) + 0.5);
+}
+
+/**
+ * @brief  Convert codes to volts
+ * @param  pScale - scale factors
+ * @param  pCodes - codes
+ * @param  pVolts - voltages, V
+ * @param  Count - count of codes
+ * @return None
+ */
+void AD779X_ConvertVolts(const tAD779X_Scale *pScale, const uint32_t *pCodes, float *pVolts, size_t Count)
+{
+	const int32_t m_zero = pScale->Zero;
+	const float m_volts = pScale->Volts;
+	size_t i;
+	
+	for (i = 0; i < Count; i++)
+		pVolts[i] = (float)((int32_t)pCodes[i] - m_zero) * m_volts;
+}
+
+/**
+ * @brief  Convert codes to microvolts (fixed-point, no float)
+ * @param  pScale - scale factors
+ * @param  pCodes - codes
+ * @param  pMicrovolts - voltages, uV
+ * @param  Count - count of codes
+ * @return None
+ */
+void AD779X_ConvertMicrovolts(const tAD779X_Scale *pScale, const uint32_t *pCodes, int32_t *pMicrovolts, size_t Count)
+{
+	const int32_t m_zero = pScale->Zero;
+	const int64_t m_mul = pScale->UvMul;
+	const int64_t m_round = (pScale->UvShift) ? (1LL << (pScale->UvShift - 1)) : 0;
+	const uint8_t m_shift = pScale->UvShift;
+	size_t i;
+	
+	for (i = 0; i < Count; i++)
+		pMicrovolts[i] = (int32_t)((((int64_t)((int32_t)pCodes[i] - m_zero)) * m_mul + m_round) >> m_shift);
+}
+
+/**
+ * @brief  Convert temperature sensor voltage (chsTempSensor) to temperature
+ * @param  Volts - voltage, V
+ * @return Temperature, C
+ */
+float AD779X_TempSensorCelsius(float Volts)
+{
+	return Volts / AD779X_TEMP_SENSITIVITY - 273.15f;
+}
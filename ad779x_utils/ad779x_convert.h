@@ -0,0 +1,45 @@
+/**
+  ******************************************************************************
+  * @file    ad779x_convert.h
+  * @author  Khusainov Timur
+  * @version 0.0.0.1
+  * @date    16.10.2026
+  * @brief   AD7792/AD7793: conversion of data codes to volts/microvolts
+  ******************************************************************************
+  * @attention
+  * <h2><center>&copy; COPYRIGHT 2011 timypik@gmail.com </center></h2>
+  ******************************************************************************
+  */
+
+#ifndef AD779X_CONVERT_H
+#define AD779X_CONVERT_H
+
+#include "ad779x.h"
+
+/**
+ * @brief Internal reference voltage, V
+ */
+#define AD779X_VREF_INT 1.17f
+
+/**
+ * @brief Temperature sensor sensitivity, V/K
+ */
+#define AD779X_TEMP_SENSITIVITY 0.00081f
+
+/**
+ * @brief Scale factors of one configuration (precomputed)
+ */
+typedef struct
+{
+	int32_t  Zero;    /*!< Code of 0 V: 2^(N-1) for bipolar, 0 for unipolar coding */
+	float    Volts;   /*!< V per code */
+	uint32_t UvMul;   /*!< uV per code, fixed-point: UvMul / 2^UvShift */
+	uint8_t  UvShift; /*!< Fraction bits of UvMul */
+} tAD779X_Scale;
+
+void AD779X_ScaleInit(tAD779X_Scale *pScale, unsigned short Config, uint8_t Bits, float VRefExt);
+void AD779X_ConvertVolts(const tAD779X_Scale *pScale, const uint32_t *pCodes, float *pVolts, size_t Count);
+void AD779X_ConvertMicrovolts(const tAD779X_Scale *pScale, const uint32_t *pCodes, int32_t *pMicrovolts, size_t Count);
+float AD779X_TempSensorCelsius(float Volts);
+
+#endif
@@ -0,0 +1,242 @@
+/**
+  ******************************************************************************
+  * @file    ad779x_filter.c
+  * @author  Khusainov Timur
+  * @version 0.0.0.1
+  * @date    16.10.2026
+  * @brief   AD7792/AD7793: digital post-filters of sample stream
+  ******************************************************************************
+  * @attention
+  * <h2><center>&copy; COPYRIGHT 2011 timypik@gmail.com </center></h2>
+  ******************************************************************************
+  */
+
+#include "ad779x_filter.h"
+
+/**
+ * @brief  Divide with rounding to nearest
+ * @param  Value - dividend
+ * @param  Divider - divider (> 0)
+ * @return Quotient
+ */
+static int32_t AD779X_DivRound(int64_t Value, int64_t Divider)
+{
+	if (Value < 0)
+		return (int32_t)((Value - Divider / 2) / Divider);
+	
+	return (int32_t)((Value + Divider / 2) / Divider);
+}
+
+/**
+ * @brief  Init moving average
+ * @param  pFilter - filter
+ * @param  Size - window size (1..AD779X_BOXCAR_MAX)
+ * @return None
+ */
+void AD779X_BoxcarInit(tAD779X_Boxcar *pFilter, uint8_t Size)
+{
+	if (Size < 1)
+		Size = 1;
+	
+	if (Size > AD779X_BOXCAR_MAX)
+		Size = AD779X_BOXCAR_MAX;
+	
+	pFilter->Sum = 0;
+	pFilter->Size = Size;
+	pFilter->Index = 0;
+	pFilter->Fill = 0;
+}
+
+/**
+ * @brief  Push sample to moving average
+ * @param  pFilter - filter
+ * @param  Sample - input sample
+ * @param  pOut - average of window (of received samples, while window is not full)
+ * @return 1 - output is ready (always)
+ */
+uint8_t AD779X_BoxcarPush(tAD779X_Boxcar *pFilter, int32_t Sample, int32_t *pOut)
+{
+	if (pFilter->Fill < pFilter->Size)
+		pFilter->Fill++;
+	else
+		pFilter->Sum -= pFilter->Window[pFilter->Index];
+	
+	pFilter->Window[pFilter->Index] = Sample;
+	pFilter->Sum += Sample;
+	
+	if (++pFilter->Index >= pFilter->Size)
+		pFilter->Index = 0;
+	
+	*pOut = AD779X_DivRound(pFilter->Sum, pFilter->Fill);
+	
+	return 1;
+}
+
+/**
+ * @brief  Init median filter
+ * @param  pFilter - filter
+ * @param  Size - window size (1..AD779X_MEDIAN_MAX, odd)
+ * @return None
+ */
+void AD779X_MedianInit(tAD779X_Median *pFilter, uint8_t Size)
+{
+	if (Size < 1)
+		Size = 1;
+	
+	if (Size > AD779X_MEDIAN_MAX)
+		Size = AD779X_MEDIAN_MAX;
+	
+	pFilter->Size = Size;
+	pFilter->Index = 0;
+	pFilter->Fill = 0;
+}
+
+/**
+ * @brief  Push sample to median filter
+ * @param  pFilter - filter
+ * @param  Sample - input sample
+ * @param  pOut - median of window (of received samples, while window is not full)
+ * @return 1 - output is ready (always)
+ */
+uint8_t AD779X_MedianPush(tAD779X_Median *pFilter, int32_t Sample, int32_t *pOut)
+{
+	uint8_t i = pFilter->Fill;
+	
+	/* remove oldest sample from sorted window */
+	if (pFilter->Fill >= pFilter->Size)
+	{
+		const int32_t m_old = pFilter->Window[pFilter->Index];
+		
+		for (i = 0; pFilter->Sorted[i] != m_old; i++);
+		
+		for (; i + 1 < pFilter->Fill; i++)
+			pFilter->Sorted[i] = pFilter->Sorted[i + 1];
+	}
+	else
+		pFilter->Fill++;
+	
+	/* insert new sample (i - free tail position) */
+	for (; (i > 0) && (pFilter->Sorted[i - 1] > Sample); i--)
+		pFilter->Sorted[i] = pFilter->Sorted[i - 1];
+	
+	pFilter->Sorted[i] = Sample;
+	pFilter->Window[pFilter->Index] = Sample;
+	
+	if (++pFilter->Index >= pFilter->Size)
+		pFilter->Index = 0;
+	
+	*pOut = pFilter->Sorted[pFilter->Fill / 2];
+	
+	return 1;
+}
+
+/**
+ * @brief  Init CIC decimator
+ * @param  pFilter - filter
+ * @param  Order - count of stages (1..AD779X_CIC_ORDER_MAX)
+ * @param  Rate - decimation rate (1..AD779X_CIC_RATE_MAX)
+ * @return None
+ */
+void AD779X_CICInit(tAD779X_CIC *pFilter, uint8_t Order, uint16_t Rate)
+{
+	uint8_t i;
+	
+	if (Order < 1)
+		Order = 1;
+	
+	if (Order > AD779X_CIC_ORDER_MAX)
+		Order = AD779X_CIC_ORDER_MAX;
+	
+	if (Rate < 1)
+		Rate = 1;
+	
+	if (Rate > AD779X_CIC_RATE_MAX)
+		Rate = AD779X_CIC_RATE_MAX;
+	
+	pFilter->Order = Order;
+	pFilter->Rate = Rate;
+	pFilter->Phase = Rate;
+	pFilter->Gain = 1;
+	
+	for (i = 0; i < Order; i++)
+	{
+		pFilter->Integrator[i] = 0;
+		pFilter->Comb[i] = 0;
+		pFilter->Gain *= Rate;
+	}
+}
+
+/**
+ * @brief  Push sample to CIC decimator
+ * @param  pFilter - filter
+ * @param  Sample - input sample
+ * @param  pOut - decimated sample (gain normalized)
+ * @return 1 - output is ready (every Rate samples), 0 - no output
+ */
+uint8_t AD779X_CICPush(tAD779X_CIC *pFilter, int32_t Sample, int32_t *pOut)
+{
+	uint64_t m_value = (uint64_t)(int64_t)Sample;
+	uint64_t m_prev;
+	uint8_t i;
+	
+	/* integrators at input rate, wrap-around is cancelled by combs */
+	for (i = 0; i < pFilter->Order; i++)
+	{
+		pFilter->Integrator[i] += m_value;
+		m_value = pFilter->Integrator[i];
+	}
+	
+	if (--pFilter->Phase)
+		return 0;
+	
+	pFilter->Phase = pFilter->Rate;
+	
+	/* combs at output rate */
+	for (i = 0; i < pFilter->Order; i++)
+	{
+		m_prev = pFilter->Comb[i];
+		pFilter->Comb[i] = m_value;
+		m_value -= m_prev;
+	}
+	
+	*pOut = AD779X_DivRound((int64_t)m_value, pFilter->Gain);
+	
+	return 1;
+}
+
+/**
+ * @brief  Push sample through chain of filters
+ * @param  pChain - filters, in order of processing
+ * @param  Count - count of filters
+ * @param  Sample - input sample
+ * @param  pOut - output of last filter
+ * @return 1 - output is ready, 0 - sample is absorbed by decimator
+ */
+uint8_t AD779X_FilterPush(tAD779X_Filter *pChain, size_t Count, int32_t Sample, int32_t *pOut)
+{
+	uint8_t m_ready = 1;
+	size_t i;
+	
+	for (i = 0; (i < Count) && m_ready; i++)
+	{
+		switch (pChain[i].Type)
+		{
+			case fltBoxcar:
+				m_ready = AD779X_BoxcarPush(&pChain[i].Data.Boxcar, Sample, &Sample);
+				break;
+			
+			case fltMedian:
+				m_ready = AD779X_MedianPush(&pChain[i].Data.Median, Sample, &Sample);
+				break;
+			
+			case fltCIC:
+				m_ready = AD779X_CICPush(&pChain[i].Data.CIC, Sample, &Sample);
+				break;
+		}
+	}
+	
+	if (m_ready)
+		*pOut = Sample;
+	
+	return m_ready;
+}
@@ -0,0 +1,97 @@
+/**
+  ******************************************************************************
+  * @file    ad779x_filter.h
+  * @author  Khusainov Timur
+  * @version 0.0.0.1
+  * @date    16.10.2026
+  * @brief   AD7792/AD7793: digital post-filters of sample stream
+  ******************************************************************************
+  * @attention
+  * <h2><center>&copy; COPYRIGHT 2011 timypik@gmail.com </center></h2>
+  ******************************************************************************
+  */
+
+#ifndef AD779X_FILTER_H
+#define AD779X_FILTER_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+/**
+ * @brief Max sizes of filter state (fixed, no allocation)
+ */
+#define AD779X_BOXCAR_MAX 64
+#define AD779X_MEDIAN_MAX 15
+#define AD779X_CIC_ORDER_MAX 4
+#define AD779X_CIC_RATE_MAX 256
+
+/**
+ * @brief Moving average (boxcar)
+ */
+typedef struct
+{
+	int32_t Window[AD779X_BOXCAR_MAX]; /*!< Last samples */
+	int64_t Sum;                       /*!< Sum of window */
+	uint8_t Size;                      /*!< Window size */
+	uint8_t Index;                     /*!< Oldest sample */
+	uint8_t Fill;                      /*!< Samples in window */
+} tAD779X_Boxcar;
+
+/**
+ * @brief Median of N (spike rejection)
+ */
+typedef struct
+{
+	int32_t Window[AD779X_MEDIAN_MAX]; /*!< Last samples, in arrival order */
+	int32_t Sorted[AD779X_MEDIAN_MAX]; /*!< Last samples, sorted */
+	uint8_t Size;                      /*!< Window size */
+	uint8_t Index;                     /*!< Oldest sample */
+	uint8_t Fill;                      /*!< Samples in window */
+} tAD779X_Median;
+
+/**
+ * @brief CIC decimator (order 1 - decimating average)
+ */
+typedef struct
+{
+	uint64_t Integrator[AD779X_CIC_ORDER_MAX]; /*!< Integrators (modulo 2^64) */
+	uint64_t Comb[AD779X_CIC_ORDER_MAX];       /*!< Comb delays */
+	int64_t  Gain;                             /*!< Rate^Order */
+	uint16_t Rate;                             /*!< Decimation rate */
+	uint16_t Phase;                            /*!< Samples to next output */
+	uint8_t  Order;                            /*!< Count of stages */
+} tAD779X_CIC;
+
+/**
+ * @brief Filter types
+ */
+typedef enum
+{
+	fltBoxcar = 0, /*!< Moving average */
+	fltMedian = 1, /*!< Median of N */
+	fltCIC    = 2  /*!< CIC decimator */
+} tAD779X_FilterType;
+
+/**
+ * @brief Stage of filter chain
+ */
+typedef struct
+{
+	tAD779X_FilterType Type;
+	union
+	{
+		tAD779X_Boxcar Boxcar;
+		tAD779X_Median Median;
+		tAD779X_CIC    CIC;
+	} Data;
+} tAD779X_Filter;
+
+void AD779X_BoxcarInit(tAD779X_Boxcar *pFilter, uint8_t Size);
+uint8_t AD779X_BoxcarPush(tAD779X_Boxcar *pFilter, int32_t Sample, int32_t *pOut);
+void AD779X_MedianInit(tAD779X_Median *pFilter, uint8_t Size);
+uint8_t AD779X_MedianPush(tAD779X_Median *pFilter, int32_t Sample, int32_t *pOut);
+void AD779X_CICInit(tAD779X_CIC *pFilter, uint8_t Order, uint16_t Rate);
+uint8_t AD779X_CICPush(tAD779X_CIC *pFilter, int32_t Sample, int32_t *pOut);
+uint8_t AD779X_FilterPush(tAD779X_Filter *pChain, size_t Count, int32_t Sample, int32_t *pOut);
+
+#endif
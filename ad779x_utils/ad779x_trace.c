@@ -0,0 +1,150 @@
+/**
+  ******************************************************************************
+  * @file    ad779x_trace.c
+  * @author  Khusainov Timur
+  * @version 0.0.0.1
+  * @date    16.10.2026
+  * @brief   AD7792/AD7793: latency histograms of bus transactions
+  ******************************************************************************
+  * @attention
+  * <h2><center>&copy; COPYRIGHT 2011 timypik@gmail.com </center></h2>
+  ******************************************************************************
+  */
+
+#include <string.h>
+
+#include "ad779x.h"
+#include "ad779x_trace.h"
+
+#define AD779X_TRACE_SUB_MASK ((1UL << AD779X_TRACE_SUB_BITS) - 1)
+
+/* Histogram of each operation */
+static tAD779X_TraceHist gTraceHist[trcCount];
+
+/**
+ * @brief  Get bucket of latency
+ * @param  Value - latency, cycles
+ * @return Number of bucket
+ */
+static uint16_t AD779X_TraceBucket(uint32_t Value)
+{
+	uint8_t m_exp = 31;
+	
+	/* linear part: one bucket per cycle */
+	if (Value <= AD779X_TRACE_SUB_MASK)
+		return (uint16_t)Value;
+
+#if defined(__GNUC__)
+	m_exp = (uint8_t)(31 - __builtin_clz(Value));
+#else
+	while (!(Value & (1UL << m_exp)))
+		m_exp--;
+#endif
+	
+	/* octave, then SUB_BITS bits after leading one */
+	return (uint16_t)(((m_exp - AD779X_TRACE_SUB_BITS + 1) << AD779X_TRACE_SUB_BITS) |
+	                  ((Value >> (m_exp - AD779X_TRACE_SUB_BITS)) & AD779X_TRACE_SUB_MASK));
+}
+
+/**
+ * @brief  Get low bound of bucket
+ * @param  Bucket - number of bucket
+ * @return Lowest latency of bucket, cycles
+ */
+uint32_t AD779X_TraceBucketLow(uint16_t Bucket)
+{
+	uint8_t m_shift;
+	
+	if (Bucket <= AD779X_TRACE_SUB_MASK)
+		return Bucket;
+	
+	m_shift = (uint8_t)((Bucket >> AD779X_TRACE_SUB_BITS) - 1);
+	
+	return ((1UL << AD779X_TRACE_SUB_BITS) | (Bucket & AD779X_TRACE_SUB_MASK)) << m_shift;
+}
+
+/**
+ * @brief  Put latency of transaction to histogram (called by AD779X_TRACE_END)
+ * @param  Op - operation (tAD779X_TraceOp)
+ * @param  Cycles - latency, cycles
+ * @return None
+ */
+void AD779X_TraceRecord(uint8_t Op, uint32_t Cycles)
+{
+	tAD779X_TraceHist *pHist;
+	
+	if (Op >= trcCount)
+		return;
+	
+	pHist = &gTraceHist[Op];
+	
+	AD779X_COUNTER_INC(pHist->Buckets[AD779X_TraceBucket(Cycles)]);
+	AD779X_COUNTER_INC(pHist->Count);
+	
+	/* max may lose update of concurrent transaction */
+	if (Cycles > AD779X_COUNTER_GET(pHist->Max))
+		pHist->Max = Cycles;
+}
+
+/**
+ * @brief  Clear all histograms
+ * @param  None
+ * @return None
+ */
+void AD779X_TraceReset(void)
+{
+	memset(gTraceHist, 0, sizeof(gTraceHist));
+}
+
+/**
+ * @brief  Get copy of histogram (may be called while transactions are recorded)
+ * @param  Op - operation (tAD779X_TraceOp)
+ * @param  pHist - copy of histogram
+ * @return None
+ */
+void AD779X_TraceSnapshot(uint8_t Op, tAD779X_TraceHist *pHist)
+{
+	uint16_t i;
+	
+	memset(pHist, 0, sizeof(*pHist));
+	
+	if (Op >= trcCount)
+		return;
+	
+	for (i = 0; i < AD779X_TRACE_BUCKETS; i++)
+		pHist->Buckets[i] = AD779X_COUNTER_GET(gTraceHist[Op].Buckets[i]);
+	
+	pHist->Count = AD779X_COUNTER_GET(gTraceHist[Op].Count);
+	pHist->Max   = AD779X_COUNTER_GET(gTraceHist[Op].Max);
+}
+
+/**
+ * @brief  Get quantile of latency
+ * @param  pHist - histogram
+ * @param  Permille - quantile, 1/1000 (e.g. 500 - median, 999 - p99.9)
+ * @return Low bound of bucket with quantile, cycles (0 - empty histogram)
+ */
+uint32_t AD779X_TraceQuantile(const tAD779X_TraceHist *pHist, uint16_t Permille)
+{
+	uint64_t m_rank, m_sum = 0;
+	uint16_t i;
+	
+	if (!pHist->Count)
+		return 0;
+	
+	/* rank of transaction: 1..Count */
+	m_rank = ((uint64_t)pHist->Count * Permille + 999) / 1000;
+	
+	if (m_rank == 0)
+		m_rank = 1;
+	
+	for (i = 0; i < AD779X_TRACE_BUCKETS; i++)
+	{
+		m_sum += pHist->Buckets[i];
+		
+		if (m_sum >= m_rank)
+			return AD779X_TraceBucketLow(i);
+	}
+	
+	return pHist->Max;
+}
@@ -0,0 +1,77 @@
+/**
+  ******************************************************************************
+  * @file    ad779x_trace.h
+  * @author  Khusainov Timur
+  * @version 0.0.0.1
+  * @date    16.10.2026
+  * @brief   AD7792/AD7793: latency histograms of bus transactions
+  ******************************************************************************
+  * @attention
+  * <h2><center>&copy; COPYRIGHT 2011 timypik@gmail.com </center></h2>
+  ******************************************************************************
+  *
+  * Build driver with -DAD779X_TRACE (and ad779x_utils in include path): each
+  * cs window is timed by cycle counter and put to log-linear histogram of its
+  * operation (tAD779X_TraceOp). Bucket width is 1/2^AD779X_TRACE_SUB_BITS of
+  * its octave, so quantiles are known with same relative error at any latency.
+  */
+
+#ifndef AD779X_TRACE_H
+#define AD779X_TRACE_H
+
+#include <stdint.h>
+
+/**
+ * @brief Cycle counter (32-bit, wraps): x86 TSC, AArch64 virtual counter,
+ *        Cortex-M3/M4/M7 DWT CYCCNT (must be enabled by application)
+ */
+#ifndef AD779X_TRACE_CYCLES
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define AD779X_TRACE_CYCLES() ((uint32_t)__rdtsc())
+#elif defined(__aarch64__)
+static inline uint32_t AD779X_TraceCntvct(void)
+{
+	uint64_t m_value;
+	
+	__asm__ volatile ("mrs %0, cntvct_el0" : "=r" (m_value));
+	
+	return (uint32_t)m_value;
+}
+#define AD779X_TRACE_CYCLES() AD779X_TraceCntvct()
+#elif defined(__ARM_ARCH_7M__) || defined(__ARM_ARCH_7EM__)
+#define AD779X_TRACE_CYCLES() (*(volatile uint32_t *)0xE0001004UL)
+#else
+#error "AD779X_TRACE: define AD779X_TRACE_CYCLES() for this target"
+#endif
+#endif
+
+/**
+ * @brief Sub-buckets of each octave: 2^AD779X_TRACE_SUB_BITS
+ */
+#ifndef AD779X_TRACE_SUB_BITS
+#define AD779X_TRACE_SUB_BITS 3
+#endif
+
+/**
+ * @brief Count of buckets: linear below 2^SUB_BITS, then octaves up to 2^32
+ */
+#define AD779X_TRACE_BUCKETS ((32 - AD779X_TRACE_SUB_BITS + 1) << AD779X_TRACE_SUB_BITS)
+
+/**
+ * @brief Histogram of one operation
+ */
+typedef struct
+{
+	uint32_t Count;                           /*!< Count of transactions */
+	uint32_t Max;                             /*!< Max latency, cycles */
+	uint32_t Buckets[AD779X_TRACE_BUCKETS];   /*!< Count of transactions of each bucket */
+} tAD779X_TraceHist;
+
+void AD779X_TraceRecord(uint8_t Op, uint32_t Cycles);
+void AD779X_TraceReset(void);
+void AD779X_TraceSnapshot(uint8_t Op, tAD779X_TraceHist *pHist);
+uint32_t AD779X_TraceBucketLow(uint16_t Bucket);
+uint32_t AD779X_TraceQuantile(const tAD779X_TraceHist *pHist, uint16_t Permille);
+
+#endif
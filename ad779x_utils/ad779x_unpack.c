@@ -0,0 +1,230 @@
+/**
+  ******************************************************************************
+  * @file    ad779x_unpack.c
+  * @author  Khusainov Timur
+  * @version 0.0.0.1
+  * @date    16.10.2026
+  * @brief   AD7792/AD7793: bulk unpack of raw 24-bit data frames
+  ******************************************************************************
+  * @attention
+  * <h2><center>&copy; COPYRIGHT 2011 timypik@gmail.com </center></h2>
+  ******************************************************************************
+  */
+
+#include <string.h>
+#include "ad779x_unpack.h"
+
+#if defined(AD779X_UNPACK_AVX2)
+	#include <immintrin.h>
+#elif defined(AD779X_UNPACK_SSSE3)
+	#include <tmmintrin.h>
+#elif defined(AD779X_UNPACK_NEON)
+	#include <arm_neon.h>
+#endif
+
+/**
+ * @brief  Unpack frames (scalar)
+ * @param  pFrames - raw frames
+ * @param  pCodes - codes
+ * @param  pStatus - status bytes (NULL - not needed)
+ * @param  Count - count of frames
+ * @param  StatusPos - position of status byte in frame
+ * @param  Bipolar - 1 - offset binary to signed, 0 - unsigned
+ * @return None
+ */
+static void AD779X_Unpack24Scalar(const uint8_t *pFrames, int32_t *pCodes, uint8_t *pStatus, size_t Count, tAD779X_StatusPos StatusPos, uint8_t Bipolar)
+{
+	const size_t m_stride = (StatusPos == sbpNone) ? 3 : 4;
+	const size_t m_data = (StatusPos == sbpBefore) ? 1 : 0;
+	const size_t m_sts = (StatusPos == sbpBefore) ? 0 : 3;
+	uint32_t m_code;
+	size_t i;
+	
+	for (i = 0; i < Count; i++, pFrames += m_stride)
+	{
+		/* big-endian data to MSBs of word */
+		m_code = ((uint32_t)pFrames[m_data] << 24) | ((uint32_t)pFrames[m_data + 1] << 16) | ((uint32_t)pFrames[m_data + 2] << 8);
+		
+		/* bipolar: 0x800000 is zero, arithmetic shift makes sign */
+		if (Bipolar)
+			pCodes[i] = (int32_t)(m_code ^ 0x80000000UL) >> 8;
+		else
+			pCodes[i] = (int32_t)(m_code >> 8);
+		
+		if (pStatus && (StatusPos != sbpNone))
+			pStatus[i] = pFrames[m_sts];
+	}
+}
+
+#if defined(AD779X_UNPACK_AVX2) || defined(AD779X_UNPACK_SSSE3)
+/**
+ * @brief  Make shuffle mask: frame bytes to MSBs of 32-bit lanes (4 frames)
+ * @param  Stride - frame size, bytes
+ * @param  Data - offset of data in frame
+ * @return Shuffle mask
+ */
+static __m128i AD779X_UnpackMask(size_t Stride, size_t Data)
+{
+	uint8_t m_mask[16];
+	size_t i;
+	
+	for (i = 0; i < 4; i++)
+	{
+		m_mask[i * 4 + 0] = 0x80;
+		m_mask[i * 4 + 1] = (uint8_t)(i * Stride + Data + 2);
+		m_mask[i * 4 + 2] = (uint8_t)(i * Stride + Data + 1);
+		m_mask[i * 4 + 3] = (uint8_t)(i * Stride + Data + 0);
+	}
+	
+	return _mm_loadu_si128((const __m128i *)m_mask);
+}
+
+/**
+ * @brief  Make shuffle mask: status bytes to low 4 bytes (4 frames)
+ * @param  Status - offset of status in frame
+ * @return Shuffle mask
+ */
+static __m128i AD779X_StatusMask(size_t Status)
+{
+	uint8_t m_mask[16];
+	size_t i;
+	
+	for (i = 0; i < 16; i++)
+		m_mask[i] = (i < 4) ? (uint8_t)(i * 4 + Status) : 0x80;
+	
+	return _mm_loadu_si128((const __m128i *)m_mask);
+}
+#endif
+
+/**
+ * @brief  Unpack 24-bit big-endian frames to codes
+ * @param  pFrames - raw frames (as received from DATA register)
+ * @param  pCodes - codes: bipolar - signed (0x800000 is 0), unipolar - unsigned
+ * @param  pStatus - status bytes (NULL - not needed)
+ * @param  Count - count of frames
+ * @param  StatusPos - position of status byte in frame
+ * @param  Bipolar - 1 - offset binary to signed, 0 - unsigned
+ * @return None
+ */
+void AD779X_Unpack24(const uint8_t *pFrames, int32_t *pCodes, uint8_t *pStatus, size_t Count, tAD779X_StatusPos StatusPos, uint8_t Bipolar)
+{
+	const size_t m_stride = (StatusPos == sbpNone) ? 3 : 4;
+	size_t i = 0;
+	
+	if (StatusPos == sbpNone)
+		pStatus = NULL;
+	
+#if defined(AD779X_UNPACK_AVX2) || defined(AD779X_UNPACK_SSSE3)
+	{
+		const size_t m_data = (StatusPos == sbpBefore) ? 1 : 0;
+		const __m128i m_mask = AD779X_UnpackMask(m_stride, m_data);
+		const __m128i m_smask = AD779X_StatusMask((StatusPos == sbpBefore) ? 0 : 3);
+	#if defined(AD779X_UNPACK_AVX2)
+		const __m256i m_mask2 = _mm256_broadcastsi128_si256(m_mask);
+		const __m256i m_smask2 = _mm256_broadcastsi128_si256(m_smask);
+		const __m256i m_sign2 = _mm256_set1_epi32((int)0x80000000UL);
+		__m256i m_raw2, m_code2;
+		
+		/* 8 frames per step, each load of 16 bytes must stay in buffer */
+		for (; i + 8 + 2 * (m_stride == 3) <= Count; i += 8)
+		{
+			m_raw2 = _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_loadu_si128((const __m128i *)&pFrames[i * m_stride])),
+			                                 _mm_loadu_si128((const __m128i *)&pFrames[(i + 4) * m_stride]), 1);
+			m_code2 = _mm256_shuffle_epi8(m_raw2, m_mask2);
+			
+			if (Bipolar)
+				m_code2 = _mm256_srai_epi32(_mm256_xor_si256(m_code2, m_sign2), 8);
+			else
+				m_code2 = _mm256_srli_epi32(m_code2, 8);
+			
+			_mm256_storeu_si256((__m256i *)&pCodes[i], m_code2);
+			
+			if (pStatus)
+			{
+				uint32_t m_sts[2];
+				
+				m_raw2 = _mm256_shuffle_epi8(m_raw2, m_smask2);
+				m_sts[0] = (uint32_t)_mm256_extract_epi32(m_raw2, 0);
+				m_sts[1] = (uint32_t)_mm256_extract_epi32(m_raw2, 4);
+				memcpy(&pStatus[i], m_sts, 8);
+			}
+		}
+	#endif
+		const __m128i m_sign = _mm_set1_epi32((int)0x80000000UL);
+		__m128i m_raw, m_code;
+		
+		/* 4 frames per step, each load of 16 bytes must stay in buffer */
+		for (; i + 4 + 2 * (m_stride == 3) <= Count; i += 4)
+		{
+			m_raw = _mm_loadu_si128((const __m128i *)&pFrames[i * m_stride]);
+			m_code = _mm_shuffle_epi8(m_raw, m_mask);
+			
+			if (Bipolar)
+				m_code = _mm_srai_epi32(_mm_xor_si128(m_code, m_sign), 8);
+			else
+				m_code = _mm_srli_epi32(m_code, 8);
+			
+			_mm_storeu_si128((__m128i *)&pCodes[i], m_code);
+			
+			if (pStatus)
+			{
+				uint32_t m_sts = (uint32_t)_mm_cvtsi128_si32(_mm_shuffle_epi8(m_raw, m_smask));
+				
+				memcpy(&pStatus[i], &m_sts, 4);
+			}
+		}
+	}
+#elif defined(AD779X_UNPACK_NEON)
+	{
+		const size_t m_data = (StatusPos == sbpBefore) ? 1 : 0;
+		uint8x8_t m_b0, m_b1, m_b2, m_sts;
+		uint16x8_t m_hi, m_lo;
+		uint32x4_t m_code[2];
+		size_t n;
+		
+		/* 8 frames per step, vld3/vld4 deinterleaves bytes of frames */
+		for (; i + 8 <= Count; i += 8)
+		{
+			if (m_stride == 3)
+			{
+				uint8x8x3_t m_raw = vld3_u8(&pFrames[i * 3]);
+				
+				m_b0 = m_raw.val[0];
+				m_b1 = m_raw.val[1];
+				m_b2 = m_raw.val[2];
+				m_sts = m_b0;
+			}
+			else
+			{
+				uint8x8x4_t m_raw = vld4_u8(&pFrames[i * 4]);
+				
+				m_b0 = m_raw.val[m_data + 0];
+				m_b1 = m_raw.val[m_data + 1];
+				m_b2 = m_raw.val[m_data + 2];
+				m_sts = m_data ? m_raw.val[0] : m_raw.val[3];
+			}
+			
+			/* DATA[23:16] and DATA[15:0] */
+			m_hi = vmovl_u8(m_b0);
+			m_lo = vorrq_u16(vshll_n_u8(m_b1, 8), vmovl_u8(m_b2));
+			
+			m_code[0] = vorrq_u32(vshll_n_u16(vget_low_u16(m_hi), 16), vmovl_u16(vget_low_u16(m_lo)));
+			m_code[1] = vorrq_u32(vshll_n_u16(vget_high_u16(m_hi), 16), vmovl_u16(vget_high_u16(m_lo)));
+			
+			for (n = 0; n < 2; n++)
+			{
+				if (Bipolar)
+					vst1q_s32(&pCodes[i + n * 4], vshrq_n_s32(vreinterpretq_s32_u32(vshlq_n_u32(veorq_u32(m_code[n], vdupq_n_u32(0x800000)), 8)), 8));
+				else
+					vst1q_s32(&pCodes[i + n * 4], vreinterpretq_s32_u32(m_code[n]));
+			}
+			
+			if (pStatus)
+				vst1_u8(&pStatus[i], m_sts);
+		}
+	}
+#endif
+	
+	/* tail */
+	AD779X_Unpack24Scalar(&pFrames[i * m_stride], &pCodes[i], pStatus ? &pStatus[i] : NULL, Count - i, StatusPos, Bipolar);
+}
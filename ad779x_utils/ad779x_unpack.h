@@ -0,0 +1,45 @@
+/**
+  ******************************************************************************
+  * @file    ad779x_unpack.h
+  * @author  Khusainov Timur
+  * @version 0.0.0.1
+  * @date    16.10.2026
+  * @brief   AD7792/AD7793: bulk unpack of raw 24-bit data frames
+  ******************************************************************************
+  * @attention
+  * <h2><center>&copy; COPYRIGHT 2011 timypik@gmail.com </center></h2>
+  ******************************************************************************
+  */
+
+#ifndef AD779X_UNPACK_H
+#define AD779X_UNPACK_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+/**
+ * @brief Vector path, selected at compile time (AD779X_UNPACK_SCALAR forces scalar)
+ */
+#if !defined(AD779X_UNPACK_SCALAR)
+	#if defined(__AVX2__)
+		#define AD779X_UNPACK_AVX2
+	#elif defined(__SSSE3__)
+		#define AD779X_UNPACK_SSSE3
+	#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+		#define AD779X_UNPACK_NEON
+	#endif
+#endif
+
+/**
+ * @brief Position of status byte in frame
+ */
+typedef enum
+{
+	sbpNone   = 0, /*!< Frame: DATA[23:16], DATA[15:8], DATA[7:0] */
+	sbpBefore = 1, /*!< Frame: STATUS, DATA[23:16], DATA[15:8], DATA[7:0] */
+	sbpAfter  = 2  /*!< Frame: DATA[23:16], DATA[15:8], DATA[7:0], STATUS */
+} tAD779X_StatusPos;
+
+void AD779X_Unpack24(const uint8_t *pFrames, int32_t *pCodes, uint8_t *pStatus, size_t Count, tAD779X_StatusPos StatusPos, uint8_t Bipolar);
+
+#endif